@@ -0,0 +1,126 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#endif
+
+namespace {
+    thread_local Arena* CurrentArena = nullptr;
+
+    // Default-sized blocks of destroyed arenas are kept for the next compilation in the process
+    constexpr std::size_t MAX_FREE_BLOCKS = 256;
+    std::mutex FreeBlocksMutex;
+    std::vector<std::unique_ptr<char[]>> FreeBlocks;
+
+    struct alignas(std::max_align_t) ObjectHeader {
+        Arena* myArena;
+        std::size_t mySize;
+    };
+
+    // Arena memory is handed out and given back without the allocator noticing, so AddressSanitizer is told
+    // which parts are live: free space and deleted objects stay poisoned until the arena releases its blocks
+    void Poison(const void* memory, std::size_t size) {
+#if defined(__SANITIZE_ADDRESS__)
+        ASAN_POISON_MEMORY_REGION(memory, size);
+#endif
+    }
+
+    void Unpoison(const void* memory, std::size_t size) {
+#if defined(__SANITIZE_ADDRESS__)
+        ASAN_UNPOISON_MEMORY_REGION(memory, size);
+#endif
+    }
+
+    std::size_t AlignUp(std::size_t size) {
+        return (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    }
+}
+
+Arena::Arena(std::size_t blockSize) : myBlockSize(blockSize) {}
+
+Arena::~Arena() {
+    std::lock_guard<std::mutex> lock(FreeBlocksMutex);
+    for (auto& block : myBlocks) {
+        Unpoison(block.myMemory.get(), block.mySize);
+        if (block.mySize == DEFAULT_BLOCK_SIZE && FreeBlocks.size() < MAX_FREE_BLOCKS) {
+            FreeBlocks.push_back(std::move(block.myMemory));
+        }
+    }
+}
+
+void* Arena::Allocate(std::size_t size) {
+    size = AlignUp(size);
+    if (static_cast<std::size_t>(myEnd - myCurrent) < size) {
+        AddBlock(size);
+    }
+
+    void* res = myCurrent;
+    Unpoison(res, size);
+    myCurrent += size;
+    myAllocatedSize += size;
+    return res;
+}
+
+std::size_t Arena::GetAllocatedSize() const {
+    return myAllocatedSize;
+}
+
+std::size_t Arena::GetBlocksCount() const {
+    return myBlocks.size();
+}
+
+Arena* Arena::GetCurrent() {
+    return CurrentArena;
+}
+
+void* Arena::AllocateObject(std::size_t size) {
+    Arena* arena = CurrentArena;
+    void* memory = (arena != nullptr ? arena->Allocate(sizeof(ObjectHeader) + size) : ::operator new(sizeof(ObjectHeader) + size));
+    auto header = new (memory) ObjectHeader{ arena, size };
+    return header + 1;
+}
+
+void Arena::DeallocateObject(void* object) {
+    if (object == nullptr) {
+        return;
+    }
+
+    auto header = static_cast<ObjectHeader*>(object) - 1;
+    if (header->myArena == nullptr) {
+        ::operator delete(header);
+    } else {
+        Poison(header, sizeof(ObjectHeader) + header->mySize);
+    }
+}
+
+void Arena::AddBlock(std::size_t minSize) {
+    std::size_t size = AlignUp(std::max(minSize, myBlockSize));
+    std::unique_ptr<char[]> memory;
+    if (size == DEFAULT_BLOCK_SIZE) {
+        std::lock_guard<std::mutex> lock(FreeBlocksMutex);
+        if (!FreeBlocks.empty()) {
+            memory = std::move(FreeBlocks.back());
+            FreeBlocks.pop_back();
+        }
+    }
+    if (memory == nullptr) {
+        memory.reset(new char[size]);
+    }
+
+    Poison(memory.get(), size);
+    myCurrent = memory.get();
+    myEnd = myCurrent + size;
+    myBlocks.push_back(Block{ std::move(memory), size });
+}
+
+ArenaScope::ArenaScope(Arena& arena) : myPrevious(CurrentArena) {
+    CurrentArena = &arena;
+}
+
+ArenaScope::~ArenaScope() {
+    CurrentArena = myPrevious;
+}
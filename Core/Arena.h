@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bump allocator behind IVisitable's operator new. Objects are still destroyed one by one by their owners, deleting
+// one only runs its destructor; the memory itself goes back in whole blocks when the arena is destroyed.
+// Teardown is not a single release: tree and symbol owners are unique pointers, and the objects own strings and
+// containers on the global heap, so their destructors have to run
+class Arena {
+public:
+    constexpr static std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit Arena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+    Arena(const Arena&) = delete;
+    ~Arena();
+    Arena& operator=(const Arena&) = delete;
+
+    void* Allocate(std::size_t size);
+
+    std::size_t GetAllocatedSize() const;
+    std::size_t GetBlocksCount() const;
+
+    static Arena* GetCurrent();
+
+    static void* AllocateObject(std::size_t size);
+    static void DeallocateObject(void* object);
+
+private:
+    friend class ArenaScope;
+
+    struct Block {
+        std::unique_ptr<char[]> myMemory;
+        std::size_t mySize;
+    };
+
+    void AddBlock(std::size_t minSize);
+
+    std::vector<Block> myBlocks;
+    char* myCurrent = nullptr;
+    char* myEnd = nullptr;
+    std::size_t myBlockSize;
+    std::size_t myAllocatedSize = 0;
+};
+
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena);
+    ArenaScope(const ArenaScope&) = delete;
+    ~ArenaScope();
+
+private:
+    Arena* myPrevious;
+};
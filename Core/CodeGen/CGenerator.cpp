@@ -0,0 +1,1340 @@
+#include "CGenerator.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+#include "../Interpreter/InterpreterUtil.h"
+#include "../Parser/DeclarationNodes.h"
+#include "../Parser/ExpressionNodes.h"
+#include "../Parser/StatementNodes.h"
+#include "../Parser/Semantics/ClassSymbol.h"
+#include "../Parser/Semantics/FunctionSymbol.h"
+#include "../Parser/Semantics/FundamentalType.h"
+
+namespace {
+// Formatting follows Interpreter::Println and the String casts, Int arithmetic wraps like Kotlin's Int and a zero
+// divisor is a runtime error. Nothing is ever freed
+// a zero divisor is a runtime error. Nothing is ever freed
+const char* RUNTIME = R"runtime(#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef int kt_unit;
+typedef const char* kt_string;
+typedef struct { int32_t size; void* data; } kt_array;
+typedef struct { int32_t first; int32_t last; } kt_irange;
+typedef struct { double first; double last; } kt_drange;
+
+static inline void* kt_alloc(size_t size) {
+    void* memory = calloc(1, size == 0 ? 1 : size);
+    if (memory == NULL) {
+        fputs("Out of memory\n", stderr);
+        exit(1);
+    }
+    return memory;
+}
+
+static inline int32_t kt_iadd(int32_t lhs, int32_t rhs) { return (int32_t)((uint32_t)lhs + (uint32_t)rhs); }
+static inline int32_t kt_isub(int32_t lhs, int32_t rhs) { return (int32_t)((uint32_t)lhs - (uint32_t)rhs); }
+static inline int32_t kt_imul(int32_t lhs, int32_t rhs) { return (int32_t)((uint32_t)lhs * (uint32_t)rhs); }
+static inline int32_t kt_ineg(int32_t value) { return (int32_t)(0u - (uint32_t)value); }
+
+static inline void kt_check_divisor(int32_t rhs) {
+    if (rhs == 0) {
+        printf("Runtime error: Division by zero\n");
+        exit(1);
+    }
+}
+
+static inline int32_t kt_idiv(int32_t lhs, int32_t rhs) {
+    kt_check_divisor(rhs);
+    return rhs == -1 ? kt_ineg(lhs) : lhs / rhs;
+}
+
+static inline int32_t kt_imod(int32_t lhs, int32_t rhs) {
+    kt_check_divisor(rhs);
+    return rhs == -1 ? 0 : lhs % rhs;
+}
+
+static inline kt_string kt_concat(kt_string lhs, kt_string rhs) {
+    size_t lhsLength = strlen(lhs);
+    size_t rhsLength = strlen(rhs);
+    char* result = kt_alloc(lhsLength + rhsLength + 1);
+    memcpy(result, lhs, lhsLength);
+    memcpy(result + lhsLength, rhs, rhsLength + 1);
+    return result;
+}
+
+static inline bool kt_string_equals(kt_string lhs, kt_string rhs) { return strcmp(lhs, rhs) == 0; }
+
+static inline kt_string kt_int_to_string(int32_t value) {
+    char* result = kt_alloc(12);
+    snprintf(result, 12, "%d", value);
+    return result;
+}
+
+static inline kt_string kt_double_to_string(double value) {
+    double integral;
+    if (!isfinite(value)) {
+        return isnan(value) ? "NaN" : value > 0 ? "Infinity" : "-Infinity";
+    }
+    const char* format = modf(value, &integral) == 0 ? "%.1f" : "%g";
+    int length = snprintf(NULL, 0, format, value);
+    char* result = kt_alloc(length + 1);
+    snprintf(result, length + 1, format, value);
+    return result;
+}
+
+static inline void kt_println(void) { putchar('\n'); }
+static inline void kt_println_int(int32_t value) { printf("%d\n", value); }
+static inline void kt_println_bool(bool value) { puts(value ? "true" : "false"); }
+static inline void kt_println_string(kt_string value) { puts(value); }
+
+static inline void kt_println_double(double value) {
+    double integral;
+    if (!isfinite(value)) {
+        puts(isnan(value) ? "NaN" : value > 0 ? "Infinity" : "-Infinity");
+        return;
+    }
+    printf(modf(value, &integral) == 0 ? "%.1f\n" : "%.16g\n", value);
+}
+
+static inline kt_array* kt_array_of(int32_t size, size_t elementSize, const void* elements) {
+    kt_array* array = kt_alloc(sizeof(kt_array));
+    array->size = size;
+    array->data = kt_alloc(size * elementSize);
+    if (size > 0) {
+        memcpy(array->data, elements, size * elementSize);
+    }
+    return array;
+}
+
+static inline void* kt_array_at(const kt_array* array, int32_t index, size_t elementSize) {
+    if (index < 0 || index >= array->size) {
+        printf("Runtime error: Index %d out of bounds for length %d\n", index, array->size);
+        exit(1);
+    }
+    return (char*)array->data + index * elementSize;
+}
+
+#define KT_ARRAY_CONTAINS(name, type, isEqual) \
+    static inline bool name(const kt_array* array, type value) { \
+        for (int32_t i = 0; i < array->size; i++) { \
+            type element = ((type*)array->data)[i]; \
+            if (isEqual) { \
+                return true; \
+            } \
+        } \
+        return false; \
+    }
+
+KT_ARRAY_CONTAINS(kt_array_contains_i, int32_t, element == value)
+KT_ARRAY_CONTAINS(kt_array_contains_d, double, element == value)
+KT_ARRAY_CONTAINS(kt_array_contains_b, bool, element == value)
+KT_ARRAY_CONTAINS(kt_array_contains_s, kt_string, strcmp(element, value) == 0)
+KT_ARRAY_CONTAINS(kt_array_contains_p, void*, element == value)
+
+static inline kt_irange* kt_irange_new(int32_t first, int32_t last) {
+    kt_irange* range = kt_alloc(sizeof(kt_irange));
+    range->first = first;
+    range->last = last;
+    return range;
+}
+
+static inline kt_drange* kt_drange_new(double first, double last) {
+    kt_drange* range = kt_alloc(sizeof(kt_drange));
+    range->first = first;
+    range->last = last;
+    return range;
+}
+
+static inline bool kt_irange_equals(const kt_irange* lhs, const kt_irange* rhs) {
+    return lhs->first == rhs->first && lhs->last == rhs->last;
+}
+
+static inline bool kt_drange_equals(const kt_drange* lhs, const kt_drange* rhs) {
+    return lhs->first == rhs->first && lhs->last == rhs->last;
+}
+
+static inline bool kt_in(double value, double first, double last) { return value >= first && value <= last; }
+)runtime";
+
+template<typename T>
+bool Is(const AbstractType* type) {
+    return dynamic_cast<const T*>(type) != nullptr;
+}
+
+bool IsNumber(const AbstractType* type) {
+    return Is<IntegerSymbol>(type) || Is<DoubleSymbol>(type);
+}
+
+const AbstractType* GetElementType(const AbstractType* type) {
+    auto iterable = dynamic_cast<const IterableSymbol*>(type);
+    if (iterable == nullptr) {
+        throw std::invalid_argument("Unsupported type " + type->GetName());
+    }
+    return iterable->GetType();
+}
+
+}
+
+CGenerator::CGenerator(const DeclarationBlock* syntaxTree, const SymbolTable* symbolTable)
+    : myTree(syntaxTree), myTable(symbolTable) {}
+
+std::string CGenerator::Generate() {
+    myFrames.clear();
+    myFunctionIds.clear();
+    myClassFrames.clear();
+    myPrototypes.clear();
+    myDefinitions.clear();
+    myContinues.clear();
+    myTemps = 0;
+    isFrameUsed = false;
+    isFrameRead = false;
+
+    myChain = { AddFrame("struct kt_globals", -1) };
+    myContext = Context{ myTree->GetDepth(), true };
+
+    std::string init;
+    myCode = &init;
+    myIndent = 1;
+    myTree->RunVisitor(*this);
+
+    std::string main = "int main(void) {\n";
+    const FunctionSymbol* mainEntry = InterpreterUtil::FindMainEntry(myTable);
+    if (mainEntry != nullptr && mainEntry->GetDeclaration() != nullptr) {
+        main += "    kt_init();\n    " + GetDeclared(mainEntry).myName + "();\n";
+    } else {
+        main += "    puts(\"No main method found in project\");\n";
+    }
+    main += "    return 0;\n}\n";
+
+    std::string structs;
+    for (const Frame& frame : myFrames) {
+        structs += frame.myType + ";\n";
+    }
+    structs += "\n";
+    for (const Frame& frame : myFrames) {
+        structs += frame.myType + " {\n";
+        if (frame.myParent != -1) {
+            structs += "    " + myFrames[frame.myParent].myType + "* up;\n";
+        }
+        for (auto& it : frame.myFields) {
+            structs += "    " + it.second + " " + it.first + ";\n";
+        }
+        if (frame.myParent == -1 && frame.myFields.empty()) {
+            structs += "    char pad;\n";
+        }
+        structs += "};\n\n";
+    }
+    if (!myFrames[0].myFields.empty()) {
+        structs += "static struct kt_globals kt_globals;\n\n";
+    }
+
+    return std::string(RUNTIME) + "\n" + structs + myPrototypes + "\n" + myDefinitions
+        + "void kt_init(void) {\n" + init + "}\n\n" + main;
+}
+
+void CGenerator::EnterNode(const IVisitable& node) {}
+
+void CGenerator::EnterNode(const DeclarationBlock& node) {
+    for (auto& it : node.GetDeclarations()) {
+        CompileStatement(*it);
+    }
+}
+
+void CGenerator::EnterNode(const FunctionDeclaration& node) {
+    CompileFunction(node);
+    SetUnitResult();
+}
+
+void CGenerator::EnterNode(const ClassDeclaration& node) {
+    SetUnitResult();
+    int classFrame = GetClassFrame(dynamic_cast<const AbstractType*>(node.GetSymbol()));
+    std::string name = myFrames[classFrame].myType.substr(std::string("struct ").size());
+    int bodyDepth = myContext.myDepth + 1;
+    bool hasParent = node.HasBody() && bodyDepth >= 2;
+    if (hasParent) {
+        myFrames[classFrame].myParent = myChain[bodyDepth - 1];
+    }
+
+    std::string signature = "struct " + name + "* " + name + "_new(";
+    signature += hasParent ? myFrames[myChain[bodyDepth - 1]].myType + "* up)" : "void)";
+
+    std::string* previousCode = myCode;
+    int previousIndent = myIndent;
+    Context previousContext = myContext;
+    std::vector<int> previousChain = myChain;
+    bool previousFrameUsed = isFrameUsed;
+    bool previousFrameRead = isFrameRead;
+    std::vector<std::string> previousContinues;
+    previousContinues.swap(myContinues);
+
+    std::string code;
+    myCode = &code;
+    myIndent = 1;
+    isFrameUsed = false;
+    isFrameRead = false;
+    Line("struct " + name + "* self = kt_alloc(sizeof(struct " + name + "));");
+    if (hasParent) {
+        Line("self->up = up;");
+    }
+
+    myChain.resize(bodyDepth);
+    myChain.push_back(classFrame);
+    if (node.HasBody()) {
+        int constructorFrame = AddFrame("struct " + name + "_init", classFrame);
+        myChain.push_back(constructorFrame);
+        std::string body;
+        myCode = &body;
+
+        for (auto& it : node.GetBody().GetDeclarations()) {
+            myContext = Context{ bodyDepth, true };
+            if (dynamic_cast<const PropertyDeclaration*>(it.get()) == nullptr) {
+                CompileStatement(*it);
+                continue;
+            }
+
+            myContext = Context{ bodyDepth + 1, true };
+            CompileStatement(*it);
+        }
+
+        myCode = &code;
+        DeclareFrame(myFrames[constructorFrame].myType + " f = { self };");
+        code += body;
+    }
+    Line("return self;");
+
+    myPrototypes += signature + ";\n";
+    myDefinitions += signature + " {\n" + code + "}\n\n";
+
+    myCode = previousCode;
+    myIndent = previousIndent;
+    myContext = previousContext;
+    myChain = previousChain;
+    isFrameUsed = previousFrameUsed;
+    isFrameRead = previousFrameRead;
+    myContinues.swap(previousContinues);
+}
+
+void CGenerator::EnterNode(const PropertyDeclaration& node) {
+    const VariableSymbol& variable = GetVariable(node.GetSymbol());
+    Expression value = CompileExpression(node.GetInitialization());
+    Line(Variable(variable, true) + " = " + value.myText + ";");
+    SetUnitResult();
+}
+
+void CGenerator::EnterNode(const BlockNode& node) {
+    if (node.GetStatements().empty()) {
+        SetUnitResult();
+        return;
+    }
+
+    for (size_t i = 0; i + 1 < node.GetStatements().size(); i++) {
+        CompileStatement(*node.GetStatements()[i]);
+    }
+    myResult = CompileExpression(*node.GetStatements().back());
+}
+
+void CGenerator::EnterNode(const EmptyStatement& node) {
+    SetUnitResult();
+}
+
+void CGenerator::EnterNode(const CallSuffixNode& node) {
+    auto funcSym = dynamic_cast<const FunctionSymbol*>(node.GetExpression()->GetSymbol());
+    auto memberAccess = dynamic_cast<const MemberAccessNode*>(node.GetExpression());
+    const IAnnotatedNode* receiver = nullptr;
+    if (memberAccess != nullptr) {
+        receiver = memberAccess->GetExpression();
+    } else if (dynamic_cast<const IdentifierNode*>(node.GetExpression()) == nullptr) {
+        receiver = node.GetExpression();
+    }
+
+    if (funcSym->GetDeclaration() == nullptr) {
+        CompileBuiltin(node, funcSym, receiver);
+        return;
+    }
+
+    auto classDecl = dynamic_cast<const ClassDeclaration*>(funcSym->GetDeclaration());
+    if (classDecl != nullptr) {
+        int classFrame = GetClassFrame(dynamic_cast<const AbstractType*>(classDecl->GetSymbol()));
+        std::string name = myFrames[classFrame].myType.substr(std::string("struct ").size());
+        bool hasParent = classDecl->HasBody() && classDecl->GetBody().GetDepth() >= 2;
+        std::string parent = hasParent ? FramePointer(classDecl->GetBody().GetDepth() - 1) : "";
+        SetResult(name + "_new(" + parent + ")", {}, true);
+        return;
+    }
+
+    Declared declared = GetDeclared(funcSym);
+    bool isMethod = receiver != nullptr && dynamic_cast<const ClassSymbol*>(receiver->GetType()) != nullptr;
+    if (receiver != nullptr && !isMethod) {
+        CompileStatement(*receiver);
+    }
+
+    std::vector<const IAnnotatedNode*> operands;
+    if (isMethod) {
+        operands.push_back(receiver);
+    }
+    for (auto& it : node.GetArguments().GetArguments()) {
+        operands.push_back(it.get());
+    }
+    std::vector<Expression> results = CompileOperands(operands);
+
+    std::string arguments;
+    size_t first = 0;
+    if (isMethod) {
+        arguments = results[0].myText;
+        first = 1;
+    } else if (declared.hasParent) {
+        arguments = FramePointer(declared.myParentDepth);
+    }
+    for (size_t i = first; i < results.size(); i++) {
+        arguments += (arguments.empty() ? "" : ", ") + results[i].myText;
+    }
+
+    SetResult(declared.myName + "(" + arguments + ")", results, true);
+    myResult.isVoid = IsUnit(funcSym->GetReturnType());
+}
+
+void CGenerator::EnterNode(const UnaryPrefixOperationNode& node) {
+    LexemeType operation = node.GetLexeme().GetType();
+    if (operation == LexemeType::OpInc || operation == LexemeType::OpDec) {
+        CompileIncrement(node.GetOperand(), operation, true);
+        return;
+    }
+
+    Expression operand = CompileExpression(node.GetOperand());
+    const AbstractType* type = node.GetOperand().GetType();
+    if (operation == LexemeType::OpAdd && IsNumber(type)) {
+        SetResult(operand.myText, { operand });
+    } else if (operation == LexemeType::OpSub && Is<IntegerSymbol>(type)) {
+        SetResult("kt_ineg(" + operand.myText + ")", { operand });
+    } else if (operation == LexemeType::OpSub && Is<DoubleSymbol>(type)) {
+        SetResult("(-" + operand.myText + ")", { operand });
+    } else if (operation == LexemeType::OpExclMark && Is<BooleanSymbol>(type)) {
+        SetResult("(!" + operand.myText + ")", { operand });
+    } else {
+        throw std::invalid_argument("Unsupported operation " + node.GetOperation());
+    }
+}
+
+void CGenerator::EnterNode(const UnaryPostfixOperationNode& node) {
+    LexemeType operation = node.GetLexeme().GetType();
+    if (operation != LexemeType::OpInc && operation != LexemeType::OpDec) {
+        throw std::invalid_argument("Unsupported operation " + node.GetOperation());
+    }
+
+    CompileIncrement(node.GetOperand(), operation, false);
+}
+
+void CGenerator::EnterNode(const IndexSuffixNode& node) {
+    Expression unused;
+    SetResult(CompileAssignable(node, nullptr, unused), {}, true);
+}
+
+void CGenerator::EnterNode(const MemberAccessNode& node) {
+    if (dynamic_cast<const ClassSymbol*>(node.GetExpression()->GetType()) == nullptr) {
+        myResult = CompileExpression(*node.GetExpression());
+        return;
+    }
+
+    Expression unused;
+    SetResult(CompileAssignable(node, nullptr, unused), {});
+}
+
+void CGenerator::EnterNode(const BinOperationNode& node) {
+    LexemeType operation = node.GetLexeme().GetType();
+    const IAnnotatedNode& left = node.GetLeftOperand();
+    const IAnnotatedNode& right = node.GetRightOperand();
+
+    if (operation == LexemeType::OpAnd || operation == LexemeType::OpOr) {
+        Expression lhs = CompileExpression(left);
+        std::string* code = myCode;
+        std::string rightCode;
+        myCode = &rightCode;
+        myIndent++;
+        Expression rhs = CompileExpression(right);
+        myIndent--;
+        myCode = code;
+
+        std::string op = operation == LexemeType::OpAnd ? " && " : " || ";
+        if (rightCode.empty()) {
+            SetResult("(" + lhs.myText + op + rhs.myText + ")", { lhs, rhs });
+            return;
+        }
+
+        std::string result = NewTemp();
+        Line("bool " + result + " = " + lhs.myText + ";");
+        Line(std::string("if (") + (operation == LexemeType::OpAnd ? "" : "!") + result + ") {");
+        *myCode += rightCode;
+        myIndent++;
+        Line(result + " = " + rhs.myText + ";");
+        myIndent--;
+        Line("}");
+        SetResult(result, {});
+        return;
+    }
+
+    if (operation == LexemeType::OpIn || operation == LexemeType::OpNotIn) {
+        auto range = dynamic_cast<const BinOperationNode*>(&right);
+        std::string text;
+        std::vector<Expression> results;
+        if (range != nullptr && range->GetLexeme().GetType() == LexemeType::OpDDot
+            && IsNumber(left.GetType()) && IsNumber(range->GetLeftOperand().GetType())) {
+            results = CompileOperands({ &left, &range->GetLeftOperand(), &range->GetRightOperand() });
+            text = "kt_in(" + results[0].myText + ", " + results[1].myText + ", " + results[2].myText + ")";
+        } else {
+            results = CompileOperands({ &left, &right });
+            text = CompileIn(left.GetType(), results[0].myText, right.GetType(), results[1].myText);
+        }
+
+        SetResult(operation == LexemeType::OpIn ? text : "(!" + text + ")", results);
+        return;
+    }
+
+    std::vector<Expression> results = CompileOperands({ &left, &right });
+    std::string text = CompileBinary(operation, left.GetType(), results[0].myText, right.GetType(), results[1].myText);
+    SetResult(text, results, operation == LexemeType::OpDDot);
+}
+
+void CGenerator::EnterNode(const IntegerNode& node) {
+    int value = static_cast<int>(node.GetLexeme().GetValue<uint64_t>());
+    std::string text = std::to_string(value);
+    if (value == std::numeric_limits<int>::min()) {
+        text = "(-2147483647 - 1)";
+    } else if (value < 0) {
+        text = "(" + text + ")";
+    }
+
+    myResult = Expression{ text, true };
+}
+
+void CGenerator::EnterNode(const DoubleNode& node) {
+    double value = node.GetLexeme().GetValue<double>();
+    std::string text;
+    if (std::isnan(value)) {
+        text = "NAN";
+    } else if (std::isinf(value)) {
+        text = value > 0 ? "INFINITY" : "(-INFINITY)";
+    } else {
+        char buffer[64];
+        for (int precision = 15; precision <= 17; precision++) {
+            std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+            if (std::strtod(buffer, nullptr) == value) {
+                break;
+            }
+        }
+        text = buffer;
+        if (text.find_first_of(".e") == std::string::npos) {
+            text += ".0";
+        }
+        if (value < 0) {
+            text = "(" + text + ")";
+        }
+    }
+
+    myResult = Expression{ text, true };
+}
+
+void CGenerator::EnterNode(const BooleanNode& node) {
+    myResult = Expression{ node.GetLexeme().GetKeyword() == Keyword::True ? "true" : "false", true };
+}
+
+void CGenerator::EnterNode(const StringNode& node) {
+    myResult = Expression{ Quote(node.GetLexeme().GetValue<std::string>()), true };
+}
+
+void CGenerator::EnterNode(const IdentifierNode& node) {
+    SetResult(Variable(GetVariable(node.GetSymbol())), {});
+}
+
+void CGenerator::EnterNode(const Assignment& node) {
+    LexemeType operation = LexemeType::Error;
+    switch (node.GetLexeme().GetType()) {
+        case LexemeType::OpPlusAssign:
+            operation = LexemeType::OpAdd;
+            break;
+        case LexemeType::OpMinusAssign:
+            operation = LexemeType::OpSub;
+            break;
+        case LexemeType::OpMultAssign:
+            operation = LexemeType::OpMult;
+            break;
+        case LexemeType::OpDivAssign:
+            operation = LexemeType::OpDiv;
+            break;
+        case LexemeType::OpModAssign:
+            operation = LexemeType::OpMod;
+            break;
+        default:
+            break;
+    }
+
+    Expression value;
+    std::string assignable = CompileAssignable(node.GetAssignable(), &node.GetExpression(), value, operation == LexemeType::Error);
+    // The bytecode evaluates the right side before loading the target or checking its index
+    if (value.hasEffects) {
+        value.myText = Spill(value, node.GetExpression().GetType());
+    }
+    if (operation == LexemeType::Error) {
+        Line(assignable + " = " + value.myText + ";");
+    } else {
+        Line(assignable + " = " + CompileBinary(operation, node.GetAssignable().GetType(), assignable,
+                                                node.GetExpression().GetType(), value.myText) + ";");
+    }
+    SetUnitResult();
+}
+
+void CGenerator::EnterNode(const ContinueNode& node) {
+    Line(myContinues.back());
+    SetUnitResult();
+}
+
+void CGenerator::EnterNode(const BreakNode& node) {
+    Line("break;");
+    SetUnitResult();
+}
+
+void CGenerator::EnterNode(const ReturnNode& node) {
+    if (!node.HasExpression() || dynamic_cast<const EmptyStatement*>(node.GetExpression()) != nullptr) {
+        Line(myContext.isVoid ? "return;" : "return 0;");
+    } else if (myContext.isVoid) {
+        CompileStatement(*node.GetExpression());
+        Line("return;");
+    } else {
+        Line("return " + CompileExpression(*node.GetExpression()).myText + ";");
+    }
+    SetUnitResult();
+}
+
+void CGenerator::EnterNode(const IfExpression& node) {
+    if (IsUnit(node.GetType())) {
+        CompileIf(node, "");
+        SetUnitResult();
+        return;
+    }
+
+    std::string result = NewTemp();
+    Line(GetCType(node.GetType()) + " " + result + ";");
+    CompileIf(node, result);
+    SetResult(result, {});
+}
+
+void CGenerator::EnterNode(const WhileNode& node) {
+    std::string* code = myCode;
+    std::string condition;
+    myCode = &condition;
+    myIndent++;
+    Expression expression = CompileExpression(node.GetExpression());
+    myIndent--;
+    myCode = code;
+
+    if (condition.empty()) {
+        Line("while (" + expression.myText + ") {");
+    } else {
+        Line("for (;;) {");
+        *myCode += condition;
+        Line("    if (!" + expression.myText + ") break;");
+    }
+    CompileLoopBody(node.GetBody(), "continue;");
+    Line("}");
+    SetUnitResult();
+}
+
+void CGenerator::EnterNode(const DoWhileNode& node) {
+    std::string* code = myCode;
+    std::string condition;
+    myCode = &condition;
+    myIndent++;
+    Expression expression = CompileExpression(node.GetExpression());
+    myIndent--;
+    myCode = code;
+
+    if (condition.empty()) {
+        Line("do {");
+        CompileLoopBody(node.GetBody(), "continue;");
+        Line("} while (" + expression.myText + ");");
+        SetUnitResult();
+        return;
+    }
+
+    std::string label = "kt_continue" + std::to_string(myTemps++);
+    Line("for (;;) {");
+    CompileLoopBody(node.GetBody(), "goto " + label + ";");
+    if (myCode->find("goto " + label + ";") != std::string::npos) {
+        Line(label + ": ;");
+    }
+    *myCode += condition;
+    Line("    if (!" + expression.myText + ") break;");
+    Line("}");
+    SetUnitResult();
+}
+
+void CGenerator::EnterNode(const ForNode& node) {
+    const AbstractType* iterableType = node.GetExpression().GetType();
+    const AbstractType* elementType = GetElementType(iterableType);
+    std::string variable = Variable(GetVariable(node.GetVariable().GetSymbol()), true);
+    std::string iterable = NewTemp();
+    std::string first = iterable + "_first";
+    std::string last = iterable + "_last";
+    std::string size = iterable + "_size";
+    std::string index = iterable + "_index";
+
+    Line("{");
+    myIndent++;
+    auto range = dynamic_cast<const BinOperationNode*>(&node.GetExpression());
+    bool isRange = Is<RangeSymbol>(iterableType);
+    if (isRange && range != nullptr && range->GetLexeme().GetType() == LexemeType::OpDDot) {
+        std::vector<Expression> bounds = CompileOperands({ &range->GetLeftOperand(), &range->GetRightOperand() });
+        Line(GetCType(elementType) + " " + first + " = " + bounds[0].myText + ";");
+        Line(GetCType(elementType) + " " + last + " = " + bounds[1].myText + ";");
+    } else {
+        Line(GetCType(iterableType) + " " + iterable + " = " + CompileExpression(node.GetExpression()).myText + ";");
+        if (isRange) {
+            Line(GetCType(elementType) + " " + first + " = " + iterable + "->first;");
+            Line(GetCType(elementType) + " " + last + " = " + iterable + "->last;");
+        }
+    }
+
+    std::string element;
+    if (!isRange) {
+        Line("int32_t " + size + " = " + iterable + "->size;");
+        element = "((" + GetCType(elementType) + "*)" + iterable + "->data)[" + index + "]";
+    } else if (Is<IntegerSymbol>(elementType)) {
+        Line("int32_t " + size + " = kt_iadd(kt_isub(" + last + ", " + first + "), 1);");
+        element = "kt_iadd(" + first + ", " + index + ")";
+    } else {
+        Line("int32_t " + size + " = (int32_t)((" + last + " - " + first + ") + 1);");
+        element = "(" + first + " + " + index + ")";
+    }
+
+    Line("for (int32_t " + index + " = 0; " + index + " < " + size + "; " + index + "++) {");
+    Line("    " + variable + " = " + element + ";");
+    CompileLoopBody(node.GetBody(), "continue;");
+    Line("}");
+    myIndent--;
+    Line("}");
+    SetUnitResult();
+}
+
+void CGenerator::CompileStatement(const ISyntaxNode& node) {
+    auto ifExpression = dynamic_cast<const IfExpression*>(&node);
+    if (ifExpression != nullptr) {
+        CompileIf(*ifExpression, "");
+        return;
+    }
+
+    auto block = dynamic_cast<const BlockNode*>(&node);
+    if (block != nullptr) {
+        for (auto& it : block->GetStatements()) {
+            CompileStatement(*it);
+        }
+        return;
+    }
+
+    node.RunVisitor(*this);
+    if (myResult.isVoid) {
+        Line(myResult.myText + ";");
+    } else if (myResult.hasEffects) {
+        Line("(void)" + myResult.myText + ";");
+    }
+}
+
+CGenerator::Expression CGenerator::CompileExpression(const ISyntaxNode& node) {
+    node.RunVisitor(*this);
+    Expression result = myResult;
+    if (result.isVoid) {
+        Line(result.myText + ";");
+        result = Expression{ "0", true };
+    }
+    return result;
+}
+
+// C leaves the order of operands unspecified, so an operand is moved to a temporary whenever one after it
+// may run code that could change it, or when it runs code itself and a later operand reads anything
+std::vector<CGenerator::Expression> CGenerator::CompileOperands(const std::vector<const IAnnotatedNode*>& nodes) {
+    std::string* code = myCode;
+    std::vector<std::string> codes(nodes.size());
+    std::vector<Expression> results;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        myCode = &codes[i];
+        results.push_back(CompileExpression(*nodes[i]));
+    }
+    myCode = code;
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        *myCode += codes[i];
+        bool isSpilled = false;
+        for (size_t j = i + 1; j < nodes.size(); j++) {
+            isSpilled |= !codes[j].empty() || results[j].hasEffects || (results[i].hasEffects && !results[j].isConstant);
+        }
+        if (isSpilled && !results[i].isConstant) {
+            results[i].myText = Spill(results[i], nodes[i]->GetType());
+            results[i].hasEffects = false;
+        }
+    }
+    return results;
+}
+
+std::string CGenerator::CompileAssignable(const IAnnotatedNode& node, const IAnnotatedNode* value, Expression& valueResult, bool isStore) {
+    std::vector<const IAnnotatedNode*> operands;
+    auto identifier = dynamic_cast<const IdentifierNode*>(&node);
+    auto memberAccess = dynamic_cast<const MemberAccessNode*>(&node);
+    auto indexSuffix = dynamic_cast<const IndexSuffixNode*>(&node);
+    if (memberAccess != nullptr) {
+        operands.push_back(memberAccess->GetExpression());
+    } else if (indexSuffix != nullptr) {
+        operands.push_back(indexSuffix->GetArguments().GetArguments().front().get());
+        operands.push_back(indexSuffix->GetExpression());
+    } else if (identifier == nullptr) {
+        throw std::invalid_argument("Unsupported operation");
+    }
+
+    size_t partsCount = operands.size();
+    if (value != nullptr) {
+        operands.push_back(value);
+    }
+    std::vector<Expression> results = CompileOperands(operands);
+    for (size_t i = 0; i < partsCount; i++) {
+        if (results[i].hasEffects) {
+            results[i].myText = Spill(results[i], operands[i]->GetType());
+        }
+    }
+    if (value != nullptr) {
+        valueResult = results.back();
+    }
+
+    if (memberAccess != nullptr) {
+        int frame = GetClassFrame(memberAccess->GetExpression()->GetType());
+        return results[0].myText + "->" + Field(frame, GetVariable(memberAccess->GetMember()->GetSymbol()));
+    }
+    if (indexSuffix != nullptr) {
+        std::string elementType = GetCType(GetElementType(indexSuffix->GetExpression()->GetType()));
+        return "(*(" + elementType + "*)kt_array_at(" + results[1].myText + ", " + results[0].myText + ", sizeof(" + elementType + ")))";
+    }
+    return Variable(GetVariable(identifier->GetSymbol()), isStore);
+}
+
+void CGenerator::CompileFunction(const FunctionDeclaration& node) {
+    auto funcSym = dynamic_cast<const FunctionSymbol*>(node.GetSymbol());
+    Declared declared = GetDeclared(funcSym);
+    int depth = node.GetDepth();
+    int parent = declared.hasParent ? myChain[declared.myParentDepth] : -1;
+
+    std::string signature = IsUnit(funcSym->GetReturnType()) ? std::string("void") : GetCType(funcSym->GetReturnType());
+    signature += " " + declared.myName + "(";
+    std::string parameters = parent != -1 ? myFrames[parent].myType + "* up" : "";
+    for (size_t i = 0; i < node.GetParameters().GetParameters().size(); i++) {
+        const VariableSymbol& parameter = GetVariable(node.GetParameters().GetParameters()[i]->GetSymbol());
+        parameters += (parameters.empty() ? "" : ", ") + GetCType(parameter.GetType()) + " p" + std::to_string(i);
+    }
+    signature += (parameters.empty() ? "void" : parameters) + ")";
+
+    std::string* previousCode = myCode;
+    int previousIndent = myIndent;
+    Context previousContext = myContext;
+    std::vector<int> previousChain = myChain;
+    bool previousFrameUsed = isFrameUsed;
+    bool previousFrameRead = isFrameRead;
+    std::vector<std::string> previousContinues;
+    previousContinues.swap(myContinues);
+
+    std::string body;
+    myCode = &body;
+    myIndent = 1;
+    isFrameUsed = false;
+    isFrameRead = false;
+    myContext = Context{ depth, IsUnit(funcSym->GetReturnType()) };
+    int frame = AddFrame("struct " + declared.myName + "_frame", parent);
+    myChain.resize(depth);
+    myChain.push_back(frame);
+
+    for (size_t i = 0; i < node.GetParameters().GetParameters().size(); i++) {
+        const VariableSymbol& parameter = GetVariable(node.GetParameters().GetParameters()[i]->GetSymbol());
+        Line(Variable(parameter, true) + " = p" + std::to_string(i) + ";");
+    }
+
+    if (myContext.isVoid || dynamic_cast<const BlockNode*>(&node.GetBody()) != nullptr) {
+        CompileStatement(node.GetBody());
+    } else {
+        Line("return " + CompileExpression(node.GetBody()).myText + ";");
+    }
+
+    std::string code;
+    myCode = &code;
+    DeclareFrame(myFrames[frame].myType + " f = { " + (parent != -1 ? "up" : "0") + " };");
+    code += body;
+
+    myPrototypes += signature + ";\n";
+    myDefinitions += signature + " {\n" + code + "}\n\n";
+
+    myCode = previousCode;
+    myIndent = previousIndent;
+    myContext = previousContext;
+    myChain = previousChain;
+    isFrameUsed = previousFrameUsed;
+    isFrameRead = previousFrameRead;
+    myContinues.swap(previousContinues);
+}
+
+void CGenerator::CompileIf(const IfExpression& node, const std::string& result) {
+    Expression condition = CompileExpression(*node.GetExpression());
+    Line("if (" + condition.myText + ") {");
+    myIndent++;
+    CompileBranch(*node.GetIfBody(), result);
+    myIndent--;
+    if (result.empty() && dynamic_cast<const EmptyStatement*>(node.GetElseBody()) != nullptr) {
+        Line("}");
+        return;
+    }
+
+    Line("} else {");
+    myIndent++;
+    CompileBranch(*node.GetElseBody(), result);
+    myIndent--;
+    Line("}");
+}
+
+void CGenerator::CompileBranch(const IAnnotatedNode& node, const std::string& result) {
+    if (result.empty()) {
+        CompileStatement(node);
+        return;
+    }
+
+    auto block = dynamic_cast<const BlockNode*>(&node);
+    if (block != nullptr && !block->GetStatements().empty()) {
+        for (size_t i = 0; i + 1 < block->GetStatements().size(); i++) {
+            CompileStatement(*block->GetStatements()[i]);
+        }
+        CompileBranch(*block->GetStatements().back(), result);
+        return;
+    }
+
+    auto ifExpression = dynamic_cast<const IfExpression*>(&node);
+    if (ifExpression != nullptr && !IsUnit(ifExpression->GetType())) {
+        CompileIf(*ifExpression, result);
+        return;
+    }
+
+    Line(result + " = " + CompileExpression(node).myText + ";");
+}
+
+void CGenerator::CompileLoopBody(const ISyntaxNode& body, const std::string& continueStatement) {
+    myContinues.push_back(continueStatement);
+    myIndent++;
+    CompileStatement(body);
+    myIndent--;
+    myContinues.pop_back();
+}
+
+void CGenerator::CompileBuiltin(const CallSuffixNode& node, const FunctionSymbol* funcSym, const IAnnotatedNode* receiver) {
+    std::vector<const IAnnotatedNode*> operands;
+    for (auto& it : node.GetArguments().GetArguments()) {
+        operands.push_back(it.get());
+    }
+
+    if (funcSym->GetName() == "println") {
+        std::vector<Expression> results = CompileOperands(operands);
+        std::string function = "kt_println";
+        if (funcSym->GetParametersCount() > 0) {
+            const AbstractType* type = funcSym->GetParameter(0);
+            if (Is<IntegerSymbol>(type)) {
+                function += "_int";
+            } else if (Is<DoubleSymbol>(type)) {
+                function += "_double";
+            } else if (Is<BooleanSymbol>(type)) {
+                function += "_bool";
+            } else if (Is<StringSymbol>(type)) {
+                function += "_string";
+            } else {
+                throw std::invalid_argument("Unsupported type " + type->GetName());
+            }
+        }
+
+        SetResult(function + "(" + (results.empty() ? "" : results[0].myText) + ")", results, true);
+        myResult.isVoid = true;
+        return;
+    }
+
+    if (funcSym->GetName() == "arrayOf") {
+        std::vector<Expression> results = CompileOperands(operands);
+        std::string type = GetCType(GetElementType(funcSym->GetReturnType()));
+        std::string elements = "NULL";
+        if (!results.empty()) {
+            elements = "(" + type + "[]){ ";
+            for (size_t i = 0; i < results.size(); i++) {
+                elements += (i == 0 ? "" : ", ") + results[i].myText;
+            }
+            elements += " }";
+        }
+
+        SetResult("kt_array_of(" + std::to_string(results.size()) + ", sizeof(" + type + "), " + elements + ")", results, true);
+        return;
+    }
+
+    Expression value = CompileExpression(*receiver);
+    const AbstractType* type = receiver->GetType();
+    const std::string& name = funcSym->GetName();
+    std::string text;
+    if (name == "toString" && Is<IntegerSymbol>(type)) {
+        text = "kt_int_to_string(" + value.myText + ")";
+    } else if (name == "toString" && Is<DoubleSymbol>(type)) {
+        text = "kt_double_to_string(" + value.myText + ")";
+    } else if (name == "toString" && Is<BooleanSymbol>(type)) {
+        text = "(" + value.myText + " ? \"true\" : \"false\")";
+    } else if (name == "toDouble" && IsNumber(type)) {
+        text = "((double)" + value.myText + ")";
+    } else if (name == "toInt" && IsNumber(type)) {
+        text = "((int32_t)" + value.myText + ")";
+    } else {
+        throw std::invalid_argument("Unsupported function " + name);
+    }
+    SetResult(text, { value });
+}
+
+void CGenerator::CompileIncrement(const IAnnotatedNode& operand, LexemeType operation, bool isPrefix) {
+    Expression unused;
+    std::string assignable = CompileAssignable(operand, nullptr, unused);
+    const AbstractType* type = operand.GetType();
+    std::string value = assignable;
+    if (!isPrefix) {
+        value = Spill(Expression{ assignable }, type);
+    }
+
+    std::string step;
+    if (Is<IntegerSymbol>(type)) {
+        step = (operation == LexemeType::OpInc ? "kt_iadd(" : "kt_isub(") + value + ", 1)";
+    } else if (Is<DoubleSymbol>(type)) {
+        step = "(" + value + (operation == LexemeType::OpInc ? " + 1" : " - 1") + ")";
+    } else {
+        throw std::invalid_argument("Unsupported type " + type->GetName());
+    }
+
+    Line(assignable + " = " + step + ";");
+    SetResult(value, {});
+}
+
+std::string CGenerator::CompileBinary(LexemeType operation, const AbstractType* leftType, const std::string& left,
+                                      const AbstractType* rightType, const std::string& right) const {
+    if (operation == LexemeType::OpDDot) {
+        if (Is<IntegerSymbol>(leftType) && Is<IntegerSymbol>(rightType)) {
+            return "kt_irange_new(" + left + ", " + right + ")";
+        }
+        if (Is<DoubleSymbol>(leftType) && Is<DoubleSymbol>(rightType)) {
+            return "kt_drange_new(" + left + ", " + right + ")";
+        }
+    } else if (LexerUtils::IsArithmeticOperation(operation)) {
+        if (Is<IntegerSymbol>(leftType) && Is<IntegerSymbol>(rightType)) {
+            switch (operation) {
+                case LexemeType::OpAdd:
+                    return "kt_iadd(" + left + ", " + right + ")";
+                case LexemeType::OpSub:
+                    return "kt_isub(" + left + ", " + right + ")";
+                case LexemeType::OpMult:
+                    return "kt_imul(" + left + ", " + right + ")";
+                case LexemeType::OpDiv:
+                    return "kt_idiv(" + left + ", " + right + ")";
+                case LexemeType::OpMod:
+                    return "kt_imod(" + left + ", " + right + ")";
+                default:
+                    break;
+            }
+        } else if (IsNumber(leftType) && IsNumber(rightType)) {
+            std::string lhs = "(double)" + left;
+            std::string rhs = "(double)" + right;
+            switch (operation) {
+                case LexemeType::OpAdd:
+                    return "(" + lhs + " + " + rhs + ")";
+                case LexemeType::OpSub:
+                    return "(" + lhs + " - " + rhs + ")";
+                case LexemeType::OpMult:
+                    return "(" + lhs + " * " + rhs + ")";
+                case LexemeType::OpDiv:
+                    return "(" + lhs + " / " + rhs + ")";
+                case LexemeType::OpMod:
+                    return "fmod(" + lhs + ", " + rhs + ")";
+                default:
+                    break;
+            }
+        } else if (operation == LexemeType::OpAdd && Is<StringSymbol>(leftType) && Is<StringSymbol>(rightType)) {
+            return "kt_concat(" + left + ", " + right + ")";
+        }
+    } else if (LexerUtils::IsEqualityOperation(operation)) {
+        bool isEqual = operation == LexemeType::OpEqual || operation == LexemeType::OpStrictEq;
+        bool isStrict = operation == LexemeType::OpStrictEq || operation == LexemeType::OpStrictIneq;
+        std::string negation = isEqual ? "" : "!";
+        if (Is<StringSymbol>(leftType) && Is<StringSymbol>(rightType)) {
+            return "(" + negation + "kt_string_equals(" + left + ", " + right + "))";
+        }
+        if (!isStrict && Is<RangeSymbol>(leftType) && Is<RangeSymbol>(rightType)) {
+            std::string prefix = Is<IntegerSymbol>(GetElementType(leftType)) ? "kt_irange" : "kt_drange";
+            return "(" + negation + prefix + "_equals(" + left + ", " + right + "))";
+        }
+        return "(" + left + (isEqual ? " == " : " != ") + right + ")";
+    } else if (LexerUtils::IsComparisonOperation(operation)) {
+        if ((IsNumber(leftType) && IsNumber(rightType)) || (Is<BooleanSymbol>(leftType) && Is<BooleanSymbol>(rightType))) {
+            switch (operation) {
+                case LexemeType::OpLess:
+                    return "(" + left + " < " + right + ")";
+                case LexemeType::OpLessOrEq:
+                    return "(" + left + " <= " + right + ")";
+                case LexemeType::OpGreater:
+                    return "(" + left + " > " + right + ")";
+                case LexemeType::OpGreaterOrEq:
+                    return "(" + left + " >= " + right + ")";
+                default:
+                    break;
+            }
+        }
+    }
+
+    throw std::invalid_argument("Unsupported operation");
+}
+
+std::string CGenerator::CompileIn(const AbstractType* valueType, const std::string& value,
+                                  const AbstractType* iterableType, const std::string& iterable) const {
+    const AbstractType* elementType = GetElementType(iterableType);
+    if (Is<RangeSymbol>(iterableType)) {
+        if (!IsNumber(valueType) || !IsNumber(elementType)) {
+            throw std::invalid_argument("Unsupported type " + iterableType->GetName());
+        }
+        return "kt_in(" + value + ", " + iterable + "->first, " + iterable + "->last)";
+    }
+
+    if (Is<IntegerSymbol>(valueType) && Is<IntegerSymbol>(elementType)) {
+        return "kt_array_contains_i(" + iterable + ", " + value + ")";
+    }
+    if (Is<DoubleSymbol>(valueType) && Is<DoubleSymbol>(elementType)) {
+        return "kt_array_contains_d(" + iterable + ", " + value + ")";
+    }
+    if (Is<BooleanSymbol>(valueType) && Is<BooleanSymbol>(elementType)) {
+        return "kt_array_contains_b(" + iterable + ", " + value + ")";
+    }
+    if (Is<StringSymbol>(valueType) && Is<StringSymbol>(elementType)) {
+        return "kt_array_contains_s(" + iterable + ", " + value + ")";
+    }
+    if (*valueType == *elementType && !IsUnit(valueType)) {
+        return "kt_array_contains_p(" + iterable + ", (void*)" + value + ")";
+    }
+    // Mismatched elements never compare equal in the interpreter
+    return "((void)" + iterable + ", (void)" + value + ", false)";
+}
+
+std::string CGenerator::Spill(const Expression& expression, const AbstractType* type) {
+    std::string temp = NewTemp();
+    Line(GetCType(type) + " " + temp + " = " + expression.myText + ";");
+    return temp;
+}
+
+std::string CGenerator::NewTemp() {
+    return "t" + std::to_string(myTemps++);
+}
+
+void CGenerator::Line(const std::string& text) {
+    *myCode += std::string(myIndent * 4, ' ') + text + "\n";
+}
+
+void CGenerator::SetResult(const std::string& text, const std::vector<Expression>& operands, bool hasEffects) {
+    myResult = Expression{ text, false, hasEffects };
+    for (const Expression& operand : operands) {
+        myResult.hasEffects |= operand.hasEffects;
+    }
+}
+
+void CGenerator::SetUnitResult() {
+    myResult = Expression{ "0", true };
+}
+
+void CGenerator::DeclareFrame(const std::string& declaration) {
+    if (!isFrameUsed) {
+        return;
+    }
+
+    Line(declaration);
+    // Stores to folded constants or unread parameters are all that is left of the frame
+    if (!isFrameRead) {
+        Line("(void)f;");
+    }
+}
+
+std::string CGenerator::Variable(const VariableSymbol& variable, bool isStore) {
+    return FrameAccess(variable.GetDepth(), isStore) + Field(myChain.at(variable.GetDepth()), variable);
+}
+
+std::string CGenerator::Field(int frame, const VariableSymbol& variable) {
+    std::string name = "v" + std::to_string(variable.GetOffset()) + "_" + GetTypeCode(variable.GetType());
+    myFrames[frame].myFields[name] = GetCType(variable.GetType());
+    return name;
+}
+
+std::string CGenerator::FrameAccess(int depth, bool isStore) {
+    if (depth == 0) {
+        return "kt_globals.";
+    }
+    if (depth == myContext.myDepth) {
+        isFrameUsed = true;
+        isFrameRead |= !isStore;
+        return "f.";
+    }
+    return FramePointer(depth) + "->";
+}
+
+std::string CGenerator::FramePointer(int depth) {
+    isFrameUsed = true;
+    isFrameRead = true;
+    int hops = myContext.myDepth - depth;
+    if (hops == 0) {
+        return "&f";
+    }
+
+    std::string pointer = "f.up";
+    for (int i = 1; i < hops; i++) {
+        pointer += "->up";
+    }
+    return pointer;
+}
+
+int CGenerator::AddFrame(const std::string& type, int parent) {
+    myFrames.push_back(Frame{ type, parent, {} });
+    return myFrames.size() - 1;
+}
+
+int CGenerator::GetClassFrame(const AbstractType* type) {
+    auto it = myClassFrames.find(type);
+    if (it != myClassFrames.end()) {
+        return it->second;
+    }
+
+    int frame = AddFrame("struct kt_c" + std::to_string(myFrames.size()) + "_" + type->GetName(), -1);
+    myClassFrames[type] = frame;
+    return frame;
+}
+
+CGenerator::Declared CGenerator::GetDeclared(const FunctionSymbol* funcSym) {
+    auto declaration = dynamic_cast<const FunctionDeclaration*>(funcSym->GetDeclaration());
+    if (declaration == nullptr) {
+        throw std::invalid_argument("Unresolved function " + funcSym->GetName());
+    }
+
+    auto it = myFunctionIds.find(funcSym);
+    if (it == myFunctionIds.end()) {
+        it = myFunctionIds.emplace(funcSym, myFunctionIds.size()).first;
+    }
+
+    int parentDepth = declaration->GetDepth() - 1;
+    return Declared{ "kt_f" + std::to_string(it->second) + "_" + funcSym->GetName(), parentDepth, parentDepth >= 1 };
+}
+
+std::string CGenerator::GetCType(const AbstractType* type) {
+    if (Is<IntegerSymbol>(type)) {
+        return "int32_t";
+    }
+    if (Is<DoubleSymbol>(type)) {
+        return "double";
+    }
+    if (Is<BooleanSymbol>(type)) {
+        return "bool";
+    }
+    if (Is<StringSymbol>(type)) {
+        return "kt_string";
+    }
+    if (Is<ArraySymbol>(type)) {
+        return "kt_array*";
+    }
+    if (Is<RangeSymbol>(type)) {
+        const AbstractType* element = GetElementType(type);
+        if (Is<IntegerSymbol>(element)) {
+            return "kt_irange*";
+        }
+        if (Is<DoubleSymbol>(element)) {
+            return "kt_drange*";
+        }
+    }
+    if (Is<ClassSymbol>(type)) {
+        return myFrames[GetClassFrame(type)].myType + "*";
+    }
+    if (IsUnit(type)) {
+        return "kt_unit";
+    }
+
+    throw std::invalid_argument("Unsupported type " + type->GetName());
+}
+
+std::string CGenerator::GetTypeCode(const AbstractType* type) {
+    if (Is<IntegerSymbol>(type)) {
+        return "i";
+    }
+    if (Is<DoubleSymbol>(type)) {
+        return "d";
+    }
+    if (Is<BooleanSymbol>(type)) {
+        return "b";
+    }
+    if (Is<StringSymbol>(type)) {
+        return "s";
+    }
+    if (Is<ArraySymbol>(type)) {
+        return "a";
+    }
+    if (Is<RangeSymbol>(type)) {
+        return Is<IntegerSymbol>(GetElementType(type)) ? "r" : "q";
+    }
+    if (Is<ClassSymbol>(type)) {
+        return "c" + std::to_string(GetClassFrame(type));
+    }
+    return "u";
+}
+
+const VariableSymbol& CGenerator::GetVariable(const ISymbol* symbol) {
+    auto variable = dynamic_cast<const VariableSymbol*>(symbol);
+    if (variable == nullptr || variable->GetOffset() == -1) {
+        throw std::invalid_argument("Unresolved variable: " + (symbol == nullptr ? std::string() : symbol->GetName()));
+    }
+
+    return *variable;
+}
+
+bool CGenerator::IsUnit(const AbstractType* type) {
+    return Is<UnitTypeSymbol>(type);
+}
+
+std::string CGenerator::Quote(const std::string& text) {
+    std::string result = "\"";
+    for (unsigned char character : text) {
+        switch (character) {
+            case '\\':
+                result += "\\\\";
+                break;
+            case '"':
+                result += "\\\"";
+                break;
+            case '?':
+                result += "\\?";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            case '\t':
+                result += "\\t";
+                break;
+            case '\r':
+                result += "\\r";
+                break;
+            default:
+                if (character < 0x20 || character == 0x7f) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\%03o", character);
+                    result += buffer;
+                } else {
+                    result += static_cast<char>(character);
+                }
+        }
+    }
+    return result + "\"";
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../Lexer/LexerUtils.h"
+#include "../Parser/INodeVisitor.h"
+#include "../Parser/Semantics/SymbolTable.h"
+
+class AbstractType;
+class FunctionSymbol;
+class IAnnotatedNode;
+class ISyntaxNode;
+class VariableSymbol;
+
+// Lowers a checked syntax tree to a single C11 translation unit. The global scope, every function, class body
+// and constructor gets a frame struct with a field per slot, nested frames reach outer ones through an up pointer
+// the same way the bytecode walks parent frames
+class CGenerator : public INodeVisitor {
+public:
+    CGenerator(const DeclarationBlock* syntaxTree, const SymbolTable* symbolTable);
+
+    std::string Generate();
+
+    void EnterNode(const IVisitable& node) override;
+
+    void EnterNode(const DeclarationBlock& node) override;
+    void EnterNode(const FunctionDeclaration& node) override;
+    void EnterNode(const ClassDeclaration& node) override;
+    void EnterNode(const PropertyDeclaration& node) override;
+
+    void EnterNode(const BlockNode& node) override;
+    void EnterNode(const EmptyStatement& node) override;
+
+    void EnterNode(const CallSuffixNode& node) override;
+    void EnterNode(const UnaryPrefixOperationNode& node) override;
+    void EnterNode(const UnaryPostfixOperationNode& node) override;
+    void EnterNode(const IndexSuffixNode& node) override;
+    void EnterNode(const MemberAccessNode& node) override;
+
+    void EnterNode(const BinOperationNode& node) override;
+    void EnterNode(const IntegerNode& node) override;
+    void EnterNode(const DoubleNode& node) override;
+    void EnterNode(const BooleanNode& node) override;
+    void EnterNode(const StringNode& node) override;
+    void EnterNode(const IdentifierNode& node) override;
+
+    void EnterNode(const Assignment& node) override;
+
+    void EnterNode(const ContinueNode& node) override;
+    void EnterNode(const BreakNode& node) override;
+    void EnterNode(const ReturnNode& node) override;
+
+    void EnterNode(const IfExpression& node) override;
+    void EnterNode(const WhileNode& node) override;
+    void EnterNode(const DoWhileNode& node) override;
+    void EnterNode(const ForNode& node) override;
+
+private:
+    // C text of an expression. Statements it needs are already emitted, constants may be reordered freely
+    struct Expression {
+        std::string myText;
+        bool isConstant = false;
+        bool hasEffects = false;
+        bool isVoid = false;
+    };
+
+    struct Frame {
+        std::string myType;
+        int myParent;
+        std::map<std::string, std::string> myFields;
+    };
+
+    struct Context {
+        int myDepth;
+        bool isVoid;
+    };
+
+    struct Declared {
+        std::string myName;
+        int myParentDepth;
+        bool hasParent;
+    };
+
+    void CompileStatement(const ISyntaxNode& node);
+    Expression CompileExpression(const ISyntaxNode& node);
+    std::vector<Expression> CompileOperands(const std::vector<const IAnnotatedNode*>& nodes);
+    std::string CompileAssignable(const IAnnotatedNode& node, const IAnnotatedNode* value, Expression& valueResult,
+                                  bool isStore = false);
+    void CompileFunction(const FunctionDeclaration& node);
+    void CompileIf(const IfExpression& node, const std::string& result);
+    void CompileBranch(const IAnnotatedNode& node, const std::string& result);
+    void CompileLoopBody(const ISyntaxNode& body, const std::string& continueStatement);
+    void CompileBuiltin(const CallSuffixNode& node, const FunctionSymbol* funcSym, const IAnnotatedNode* receiver);
+    void CompileIncrement(const IAnnotatedNode& operand, LexemeType operation, bool isPrefix);
+
+    std::string CompileBinary(LexemeType operation, const AbstractType* leftType, const std::string& left,
+                              const AbstractType* rightType, const std::string& right) const;
+    std::string CompileIn(const AbstractType* valueType, const std::string& value,
+                          const AbstractType* iterableType, const std::string& iterable) const;
+
+    std::string Spill(const Expression& expression, const AbstractType* type);
+    std::string NewTemp();
+    void Line(const std::string& text);
+    void SetResult(const std::string& text, const std::vector<Expression>& operands, bool hasEffects = false);
+    void SetUnitResult();
+
+    void DeclareFrame(const std::string& declaration);
+    std::string Variable(const VariableSymbol& variable, bool isStore = false);
+    std::string Field(int frame, const VariableSymbol& variable);
+    std::string FrameAccess(int depth, bool isStore = false);
+    std::string FramePointer(int depth);
+    int AddFrame(const std::string& type, int parent);
+    int GetClassFrame(const AbstractType* type);
+    Declared GetDeclared(const FunctionSymbol* funcSym);
+
+    std::string GetCType(const AbstractType* type);
+    std::string GetTypeCode(const AbstractType* type);
+    static const VariableSymbol& GetVariable(const ISymbol* symbol);
+    static bool IsUnit(const AbstractType* type);
+    static std::string Quote(const std::string& text);
+
+    const DeclarationBlock* myTree;
+    const SymbolTable* myTable;
+
+    std::vector<Frame> myFrames;
+    std::vector<int> myChain;
+    Context myContext{ 0, true };
+    std::map<const ISymbol*, int> myFunctionIds;
+    std::map<const ISymbol*, int> myClassFrames;
+
+    std::string myPrototypes;
+    std::string myDefinitions;
+    std::string* myCode = nullptr;
+    int myIndent = 0;
+    int myTemps = 0;
+    // Whether the code emitted for the current function or constructor reaches its frame, which is only declared then
+    bool isFrameUsed = false;
+    bool isFrameRead = false;
+    std::vector<std::string> myContinues;
+
+    Expression myResult;
+};
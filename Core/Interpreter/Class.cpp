@@ -2,18 +2,12 @@
 
 #include "StackFrame.h"
 
-Struct::Struct(StackFrame frame) : myFrame(std::move(frame)) {}
-
-Pointer<Reference> Struct::GetVariable(const std::string& name) {
-    return GetVariable(name);
-}
-
-bool Struct::Contains(const std::string& name) const {
-    return myFrame.Contains(name);
+Struct::Struct(StackFrame frame) : myFrame(std::move(frame)) {
+    myFrame.SetOwner(this);
 }
 
-StackFrame Struct::GetLocalSpace() {
-    return myFrame.Clone();
+StackFrame& Struct::GetLocalSpace() {
+    return myFrame;
 }
 
 Pointer<IVariable> Struct::Clone() const {
@@ -24,17 +18,13 @@ Pointer<IVariable> Struct::ApplyOperation(LexemeType operation, const IVariable*
     return lhs->ApplyOperation(operation, this);
 }
 
-Class::Class(Struct* data) : Reference(data) {}
-
-Pointer<Reference> Class::GetVariable(const std::string& name) {
-    return Dereference<Struct>()->GetVariable(name);
+void Struct::Trace(GarbageCollector& collector) const {
+    myFrame.Trace(collector);
 }
 
-bool Class::Contains(const std::string& name) const {
-    return Dereference<Struct>()->Contains(name);
-}
+Class::Class(Struct* data) : Reference(data) {}
 
-StackFrame Class::GetLocalSpace() {
+StackFrame& Class::GetLocalSpace() const {
     return Dereference<Struct>()->GetLocalSpace();
 }
 
@@ -6,13 +6,13 @@ class Struct : public IVariable {
 public:
     explicit Struct(StackFrame frame);
 
-    Pointer<Reference> GetVariable(const std::string& name);
-    bool Contains(const std::string& name) const;
-    StackFrame GetLocalSpace();
+    StackFrame& GetLocalSpace();
 
     Pointer<IVariable> Clone() const override;
     Pointer<IVariable> ApplyOperation(LexemeType operation, const IVariable* lhs) const override;
 
+    void Trace(GarbageCollector& collector) const override;
+
 private:
     StackFrame myFrame;
 };
@@ -21,9 +21,7 @@ class Class : public Reference {
 public:
     explicit Class(Struct* data);
 
-    Pointer<Reference> GetVariable(const std::string& name);
-    bool Contains(const std::string& name) const;
-    StackFrame GetLocalSpace();
+    StackFrame& GetLocalSpace() const;
 
     Pointer<Reference> CloneRef() const override;
 
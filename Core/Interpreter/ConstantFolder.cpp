@@ -0,0 +1,195 @@
+#include "ConstantFolder.h"
+
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include "../Parser/ExpressionNodes.h"
+#include "../Parser/Semantics/FundamentalType.h"
+
+using AstFormat::NodeKind;
+
+void ConstantFolder::Fold(DeclarationBlock& syntaxTree, const FlatTree& flatTree) {
+    Scan(flatTree);
+    if (!myFolded.empty()) {
+        Transform(syntaxTree);
+    }
+    myFolded.clear();
+    myValues.clear();
+    myConstants.clear();
+}
+
+Pointer<IAnnotatedNode> ConstantFolder::Transform(Pointer<IAnnotatedNode> node) {
+    if (node == nullptr) {
+        return node;
+    }
+
+    // A folded node is replaced as a whole, its operands are dropped with it
+    auto it = myFolded.find(node.get());
+    if (it == myFolded.end()) {
+        return INodeTransformer::Transform(std::move(node));
+    }
+    return CreateLiteral(*myValues[it->second], node->GetLexeme(), node->GetType());
+}
+
+// The flat tree lists every subtree right after its root, so a node is finished once the scan leaves its subtree.
+// That visits operands before their operation and a val's initialization before any read of the val
+void ConstantFolder::Scan(const FlatTree& flatTree) {
+    myValues.resize(flatTree.GetSize());
+
+    std::vector<int> open;
+    for (int idx = 0; idx < flatTree.GetSize(); idx++) {
+        while (!open.empty() && open.back() != flatTree.GetParent(idx)) {
+            FoldNode(flatTree, open.back());
+            open.pop_back();
+        }
+        open.push_back(idx);
+    }
+    while (!open.empty()) {
+        FoldNode(flatTree, open.back());
+        open.pop_back();
+    }
+}
+
+void ConstantFolder::FoldNode(const FlatTree& flatTree, int idx) {
+    Pointer<IVariable> result;
+    bool isOperation = false;
+
+    switch (flatTree.GetKind(idx)) {
+        case NodeKind::Integer:
+        case NodeKind::Double:
+        case NodeKind::Boolean:
+        case NodeKind::String:
+            result = GetValue(flatTree.GetKind(idx), flatTree.GetLexeme(idx));
+            break;
+        case NodeKind::Identifier: {
+            auto it = myConstants.find(flatTree.GetSymbol(idx));
+            if (it != myConstants.end()) {
+                result = myValues[it->second]->Clone();
+                isOperation = true;
+            }
+            break;
+        }
+        case NodeKind::BinOperation: {
+            int left = flatTree.GetFirstChild(idx);
+            int right = flatTree.GetNextSibling(left);
+            if (myValues[left] == nullptr || myValues[right] == nullptr) {
+                return;
+            }
+
+            // Int arithmetic wraps like it does at run time, a division by zero is left for the program to report
+            try {
+                result = myValues[right]->ApplyOperation(flatTree.GetLexeme(idx).GetType(), myValues[left].get());
+            } catch (const std::invalid_argument&) {
+                return;
+            }
+            isOperation = true;
+            break;
+        }
+        case NodeKind::UnaryPrefixOperation: {
+            LexemeType operationType = flatTree.GetLexeme(idx).GetType();
+            const Pointer<IVariable>& operand = myValues[flatTree.GetFirstChild(idx)];
+            if (operand == nullptr || operationType == LexemeType::OpInc || operationType == LexemeType::OpDec) {
+                return;
+            }
+
+            try {
+                result = operand->ApplyOperation(operationType);
+            } catch (const std::invalid_argument&) {
+                return;
+            }
+            isOperation = true;
+            break;
+        }
+        case NodeKind::PropertyDeclaration:
+            AddConstant(flatTree, idx);
+            return;
+        default:
+            return;
+    }
+
+    // The literal must keep the type the checker gave the replaced expression
+    if (result == nullptr || !IsLiteralOf(*result, flatTree.GetType(idx))) {
+        return;
+    }
+    myValues[idx] = std::move(result);
+    if (isOperation) {
+        myFolded[&flatTree.GetNode(idx)] = idx;
+    }
+}
+
+void ConstantFolder::AddConstant(const FlatTree& flatTree, int idx) {
+    auto& property = static_cast<const PropertyDeclaration&>(flatTree.GetNode(idx));
+    if (property.IsMutable() || !property.HasInitialization()) {
+        return;
+    }
+
+    // Class properties are read through their instance and may be read before they are initialized
+    for (int parent = flatTree.GetParent(idx); parent != -1; parent = flatTree.GetParent(parent)) {
+        if (flatTree.GetKind(parent) == NodeKind::ClassDeclaration) {
+            return;
+        }
+        if (flatTree.GetKind(parent) == NodeKind::FunctionDeclaration) {
+            break;
+        }
+    }
+
+    // The initialization is the last child of the declaration
+    int init = flatTree.GetFirstChild(idx);
+    while (flatTree.GetNextSibling(init) != -1) {
+        init = flatTree.GetNextSibling(init);
+    }
+
+    auto varSym = dynamic_cast<const VariableSymbol*>(flatTree.GetSymbol(idx));
+    if (varSym != nullptr && varSym->GetType() == flatTree.GetType(init) && myValues[init] != nullptr) {
+        myConstants[varSym] = init;
+    }
+}
+
+Pointer<IVariable> ConstantFolder::GetValue(NodeKind kind, const Lexeme& lexeme) {
+    switch (kind) {
+        case NodeKind::Integer:
+            return std::make_unique<Integer>(lexeme.GetValue<uint64_t>());
+        case NodeKind::Double:
+            return std::make_unique<Double>(lexeme.GetValue<double>());
+        case NodeKind::Boolean:
+            return std::make_unique<Boolean>(lexeme.GetKeyword() == Keyword::True);
+        case NodeKind::String:
+            return std::make_unique<String>(lexeme.GetValue<std::string>());
+        default:
+            return nullptr;
+    }
+}
+
+bool ConstantFolder::IsLiteralOf(const IVariable& value, const AbstractType* type) {
+    return (dynamic_cast<const Integer*>(&value) != nullptr && dynamic_cast<const IntegerSymbol*>(type) != nullptr)
+        || (dynamic_cast<const Double*>(&value) != nullptr && dynamic_cast<const DoubleSymbol*>(type) != nullptr)
+        || (dynamic_cast<const Boolean*>(&value) != nullptr && dynamic_cast<const BooleanSymbol*>(type) != nullptr)
+        || (dynamic_cast<const String*>(&value) != nullptr && dynamic_cast<const StringSymbol*>(type) != nullptr);
+}
+
+Pointer<IAnnotatedNode> ConstantFolder::CreateLiteral(const IVariable& value, const Lexeme& lexeme, const AbstractType* type) {
+    int col = lexeme.GetColumn();
+    int row = lexeme.GetRow();
+
+    if (dynamic_cast<const Integer*>(&value) != nullptr && dynamic_cast<const IntegerSymbol*>(type) != nullptr) {
+        std::string text = std::to_string(value.GetValue<int>());
+        return std::make_unique<IntegerNode>(Lexeme(col, row, text, LexemeType::Int, text), type);
+    }
+    if (dynamic_cast<const Double*>(&value) != nullptr && dynamic_cast<const DoubleSymbol*>(type) != nullptr) {
+        std::ostringstream text;
+        // Infinities and NaN get names the lexeme can parse back on every platform
+        text << std::setprecision(17);
+        Value::PrintDouble(text, value.GetValue<double>());
+        return std::make_unique<DoubleNode>(Lexeme(col, row, text.str(), LexemeType::Double, text.str()), type);
+    }
+    if (dynamic_cast<const Boolean*>(&value) != nullptr && dynamic_cast<const BooleanSymbol*>(type) != nullptr) {
+        std::string text = value.GetValue<bool>() ? "true" : "false";
+        return std::make_unique<BooleanNode>(Lexeme(col, row, text, LexemeType::Keyword, text), type);
+    }
+    if (dynamic_cast<const String*>(&value) != nullptr && dynamic_cast<const StringSymbol*>(type) != nullptr) {
+        std::string text = value.GetValue<std::string>();
+        return std::make_unique<StringNode>(Lexeme(col, row, text, LexemeType::String, text), type);
+    }
+    return nullptr;
+}
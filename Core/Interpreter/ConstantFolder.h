@@ -0,0 +1,37 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "Variable.h"
+#include "../Parser/DeclarationNodes.h"
+#include "../Parser/FlatTree.h"
+#include "../Parser/INodeTransformer.h"
+
+// Replaces operations on literals with their results and reads of vals initialized with a literal with
+// the literal. Operations are evaluated by the interpreter's variables, so results are the same as at runtime;
+// operations that fail or would trap are left to fail at runtime.
+// What folds is found by one scan over the flat layout of the tree, the pointer tree is only walked to splice
+// the literals in, and not at all when nothing folds
+class ConstantFolder : public INodeTransformer {
+public:
+    // flatTree is the flat layout of syntaxTree, it refers to replaced nodes once the tree is folded
+    void Fold(DeclarationBlock& syntaxTree, const FlatTree& flatTree);
+
+    Pointer<IAnnotatedNode> Transform(Pointer<IAnnotatedNode> node) override;
+    using INodeTransformer::Transform;
+
+private:
+    void Scan(const FlatTree& flatTree);
+    void FoldNode(const FlatTree& flatTree, int idx);
+    void AddConstant(const FlatTree& flatTree, int idx);
+
+    static Pointer<IVariable> GetValue(AstFormat::NodeKind kind, const Lexeme& lexeme);
+    static bool IsLiteralOf(const IVariable& value, const AbstractType* type);
+    static Pointer<IAnnotatedNode> CreateLiteral(const IVariable& value, const Lexeme& lexeme, const AbstractType* type);
+
+    // Value of every node of the flat tree that is or folds to a literal
+    std::vector<Pointer<IVariable>> myValues;
+    std::unordered_map<const ISymbol*, int> myConstants;
+    std::unordered_map<const ISyntaxNode*, int> myFolded;
+};
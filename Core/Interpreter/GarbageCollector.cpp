@@ -0,0 +1,68 @@
+#include "GarbageCollector.h"
+
+#include <algorithm>
+#include <chrono>
+
+GarbageCollector::GarbageCollector(RootsMarker rootsMarker, size_t initialThreshold)
+    : myRootsMarker(std::move(rootsMarker)), myInitialThreshold(initialThreshold), myThreshold(initialThreshold) {}
+
+IVariable* GarbageCollector::Allocate(Pointer<IVariable> variable) {
+    IVariable* object = variable.get();
+    myObjects.push_back(std::move(variable));
+    myStatistics.myAllocated++;
+    myStatistics.myHeapSize = myObjects.size();
+    myStatistics.myPeakHeapSize = std::max(myStatistics.myPeakHeapSize, myStatistics.myHeapSize);
+
+    if (myObjects.size() > myThreshold) {
+        MarkVariable(object);
+        Collect();
+    }
+
+    return object;
+}
+
+void GarbageCollector::Collect() {
+    auto start = std::chrono::steady_clock::now();
+
+    myRootsMarker(*this);
+    while (!myGray.empty()) {
+        const IVariable* variable = myGray.back();
+        myGray.pop_back();
+        variable->Trace(*this);
+    }
+
+    auto alive = std::partition(myObjects.begin(), myObjects.end(), [this](const Pointer<IVariable>& object) {
+        return myMarked.count(object.get()) > 0;
+    });
+    myStatistics.myFreed += myObjects.end() - alive;
+    myObjects.erase(alive, myObjects.end());
+    myMarked.clear();
+
+    myThreshold = std::max(myInitialThreshold, myObjects.size() * 2);
+
+    double pause = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    myStatistics.myCollections++;
+    myStatistics.myHeapSize = myObjects.size();
+    myStatistics.myTotalPause += pause;
+    myStatistics.myMaxPause = std::max(myStatistics.myMaxPause, pause);
+}
+
+bool GarbageCollector::Mark(const void* object) {
+    return object != nullptr && myMarked.insert(object).second;
+}
+
+void GarbageCollector::MarkVariable(const IVariable* variable) {
+    if (Mark(variable)) {
+        myGray.push_back(variable);
+    }
+}
+
+void GarbageCollector::MarkValue(const Value& value) {
+    if (value.IsObject()) {
+        MarkVariable(value.Get<IVariable*>());
+    }
+}
+
+const GcStatistics& GarbageCollector::GetStatistics() const {
+    return myStatistics;
+}
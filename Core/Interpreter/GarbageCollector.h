@@ -0,0 +1,43 @@
+#pragma once
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+#include "Variable.h"
+
+struct GcStatistics {
+    size_t myCollections = 0;
+    size_t myAllocated = 0;
+    size_t myFreed = 0;
+    size_t myHeapSize = 0;
+    size_t myPeakHeapSize = 0;
+    double myTotalPause = 0;
+    double myMaxPause = 0;
+};
+
+class GarbageCollector {
+public:
+    using RootsMarker = std::function<void(GarbageCollector&)>;
+
+    explicit GarbageCollector(RootsMarker rootsMarker, size_t initialThreshold = 4096);
+
+    IVariable* Allocate(Pointer<IVariable> variable);
+    void Collect();
+
+    bool Mark(const void* object);
+    void MarkVariable(const IVariable* variable);
+    void MarkValue(const Value& value);
+
+    const GcStatistics& GetStatistics() const;
+
+private:
+    RootsMarker myRootsMarker;
+    size_t myInitialThreshold;
+    size_t myThreshold;
+
+    std::vector<Pointer<IVariable>> myObjects;
+    std::unordered_set<const void*> myMarked;
+    std::vector<const IVariable*> myGray;
+
+    GcStatistics myStatistics;
+};
@@ -5,15 +5,16 @@
 
 #include "Class.h"
 #include "InterpreterUtil.h"
-#include "InterpreterExceptions.h"
 #include "StackGuard.h"
 #include "../Parser/DeclarationNodes.h"
 #include "../Parser/ExpressionNodes.h"
 #include "../Parser/StatementNodes.h"
+#include "../Parser/Semantics/Symbols.h"
 
 
 Interpreter::Interpreter(const DeclarationBlock* syntaxTree, const SymbolTable* symbolTable)
-    : myTree(syntaxTree), myTable(symbolTable), myMain(InterpreterUtil::FindMainEntry(symbolTable)) {}
+    : myTree(syntaxTree), myTable(symbolTable), myMain(InterpreterUtil::FindMainEntry(symbolTable)),
+      myHeap([this](GarbageCollector& collector) { MarkRoots(collector); }) {}
 
 void Interpreter::RunMain() {
     if (myMain == nullptr) {
@@ -21,18 +22,27 @@ void Interpreter::RunMain() {
         return;
     }
 
-    myStack.push(StackFrame());
+    myActivations.emplace_back(myTree->GetDepth(), myTree->GetFrameSize(), nullptr, mySlots);
+    FrameGuard globalGuard(myFrame, myDisplay, &myActivations.back());
     myTree->RunVisitor(*this);
 
-    myStack.push(myStack.top().Clone());
-    try {
-        dynamic_cast<const FunctionDeclaration*>(myMain->GetDeclaration())->GetBody().RunVisitor(*this);
-    } catch (const ReturnException&) {}
+    auto mainDecl = dynamic_cast<const FunctionDeclaration*>(myMain->GetDeclaration());
+    myActivations.emplace_back(mainDecl->GetDepth(), mainDecl->GetFrameSize(), myFrame, mySlots);
+    FrameGuard frameGuard(myFrame, myDisplay, &myActivations.back());
+    mainDecl->GetBody().RunVisitor(*this);
+    myCompletion = Completion::Normal;
+}
+
+void Interpreter::EnableJit(int threshold) {
+    myJit = std::make_unique<JitCompiler>(threshold);
+}
+
+const GcStatistics& Interpreter::GetGcStatistics() const {
+    return myHeap.GetStatistics();
 }
 
 IVariable* Interpreter::LoadOnHeap(Pointer<IVariable> variable) {
-    myHeap.push_back(std::move(variable));
-    return myHeap.rbegin()->get();
+    return myHeap.Allocate(std::move(variable));
 }
 
 void Interpreter::LoadOnStack(Pointer<IVariable> variable) {
@@ -42,55 +52,87 @@ void Interpreter::LoadOnStack(Pointer<IVariable> variable) {
         return;
     }
 
-    myStack.top().Load(std::move(variable));
+    myStack.push_back(Operand{ Value(), std::move(variable) });
+}
+
+void Interpreter::LoadOnStack(const Value& value) {
+    myStack.push_back(Operand{ value, nullptr });
 }
 
 Pointer<IVariable> Interpreter::PopFromStack() {
-    return myStack.top().Pop();
+    Operand res = std::move(myStack.back());
+    myStack.pop_back();
+    if (res.myFrame != nullptr) {
+        return res.myFrame->GetVariable(res.myOffset);
+    }
+    if (res.myObject == nullptr) {
+        return IVariable::FromValue(res.myValue);
+    }
+    return std::move(res.myObject);
 }
 
 void Interpreter::EnterNode(const DeclarationBlock& node) {
     for (auto& it : node.GetDeclarations()) {
         it->RunVisitor(*this);
+        if (IsJumping()) {
+            return;
+        }
     }
 }
 
 void Interpreter::EnterNode(const IVisitable& node) {}
 
-void Interpreter::EnterNode(const FunctionDeclaration& node) {
-    myVisibilityMap.emplace(node.GetSymbol(), myStack.top().Clone());
-}
+void Interpreter::EnterNode(const FunctionDeclaration& node) {}
 
-void Interpreter::EnterNode(const ClassDeclaration& node) {
-    myVisibilityMap.emplace(node.GetSymbol(), myStack.top().Clone());
-}
+void Interpreter::EnterNode(const ClassDeclaration& node) {}
 
 void Interpreter::EnterNode(const BlockNode& node) {
     for (auto& it : node.GetStatements()) {
         it->RunVisitor(*this);
+        if (IsJumping()) {
+            return;
+        }
     }
 }
 
 void Interpreter::EnterNode(const CallSuffixNode& node) {
-    Pointer<IVariable> exprRes;
-    if (!dynamic_cast<const IdentifierNode*>(node.GetExpression())) {
+    bool hasReceiver = dynamic_cast<const IdentifierNode*>(node.GetExpression()) == nullptr;
+    if (hasReceiver) {
         node.GetExpression()->RunVisitor(*this);
-        exprRes = PopFromStack();
+        if (IsJumping()) {
+            return;
+        }
     }
 
     for (auto& it : node.GetArguments().GetArguments()) {
         it->RunVisitor(*this);
+        if (IsJumping()) {
+            return;
+        }
     }
 
     const FunctionSymbol* funcSym = dynamic_cast<const FunctionSymbol*>(node.GetExpression()->GetSymbol());
     std::vector<Pointer<IVariable>> refParams;
     std::vector<IVariable*> params;
     for (int i = 0; i < funcSym->GetParametersCount(); i++) {
-        refParams.push_back(PopFromStack());
-        params.push_back(InterpreterUtil::TryDereference(refParams[i].get()));
+        // A variable passed as an argument is read from its slot, only temporaries are kept alive here
+        IVariable* param = GetVariable(myStack.back());
+        if (param == nullptr) {
+            refParams.push_back(IVariable::FromValue(myStack.back().myValue));
+            param = refParams.back().get();
+        } else if (myStack.back().myObject != nullptr) {
+            refParams.push_back(std::move(myStack.back().myObject));
+        }
+        params.push_back(param);
+        myStack.pop_back();
     }
     std::reverse(params.begin(), params.end());
 
+    Pointer<IVariable> exprRes;
+    if (hasReceiver) {
+        exprRes = PopFromStack();
+    }
+
     if (funcSym->GetDeclaration() == nullptr) {
         if (funcSym->GetName() == "println") {
             Println(funcSym, params);
@@ -106,85 +148,164 @@ void Interpreter::EnterNode(const CallSuffixNode& node) {
     auto funcDecl = dynamic_cast<const FunctionDeclaration*>(funcSym->GetDeclaration());
     if (funcDecl == nullptr) {
         auto classDecl = dynamic_cast<const ClassDeclaration*>(funcSym->GetDeclaration());
-        myStack.push(myVisibilityMap[classDecl->GetSymbol()].Clone());
+        if (!classDecl->HasBody()) {
+            LoadOnStack(std::make_unique<Class>(dynamic_cast<Struct*>(LoadOnHeap(std::make_unique<Struct>(StackFrame(0, 0, myFrame))))));
+            return;
+        }
 
-        if (classDecl->HasBody()) {
-            classDecl->GetBody().RunVisitor(*this);
+        const DeclarationBlock& body = classDecl->GetBody();
+        Struct* classData = dynamic_cast<Struct*>(LoadOnHeap(std::make_unique<Struct>(
+            StackFrame(body.GetDepth(), body.GetFrameSize(), myDisplay[body.GetDepth() - 1]))));
+        {
+            FrameGuard frameGuard(myFrame, myDisplay, &classData->GetLocalSpace());
+            body.RunVisitor(*this);
         }
 
-        Struct* classData = dynamic_cast<Struct*>(LoadOnHeap(std::make_unique<Struct>(std::move(myStack.top()))));
-        myStack.pop();
         LoadOnStack(std::make_unique<Class>(classData));
         return;
     }
 
-    StackFrame frame = myVisibilityMap[funcSym].Clone();
-    if (exprRes != nullptr) {
-        frame = dynamic_cast<Class*>(InterpreterUtil::TryDereference(exprRes.get()))->GetLocalSpace();
+    if (myJit != nullptr) {
+        Pointer<IVariable> result = myJit->TryCall(funcSym, params);
+        if (result != nullptr) {
+            LoadOnStack(std::move(result));
+            return;
+        }
+    }
+
+    StackFrame* parent = nullptr;
+    if (exprRes != nullptr && dynamic_cast<Class*>(InterpreterUtil::TryDereference(exprRes.get())) != nullptr) {
+        parent = &dynamic_cast<Class*>(InterpreterUtil::TryDereference(exprRes.get()))->GetLocalSpace();
+    } else {
+        parent = myDisplay[funcDecl->GetDepth() - 1];
     }
-    StackGuard guard(myStack, frame, true);
 
+    size_t base = myStack.size();
+    myActivations.emplace_back(funcDecl->GetDepth(), funcDecl->GetFrameSize(), parent, mySlots);
     for (uint32_t i = 0; i < params.size(); i++) {
-        myStack.top().AddGlobal(funcDecl->GetParameters().GetParameters()[i]->GetIdentifierName(), params[i]);
+        myActivations.back().SetVariable(i, params[i]->Clone());
     }
 
-    try {
+    {
+        FrameGuard frameGuard(myFrame, myDisplay, &myActivations.back());
+        StackGuard guard(myStack, true);
+
         funcDecl->GetBody().RunVisitor(*this);
-    } catch (const ReturnException&) {
-        if (myReturn != nullptr) {
-            LoadOnStack(std::move(myReturn));
+        if (myCompletion == Completion::Return) {
+            myCompletion = Completion::Normal;
+            if (myReturn != nullptr) {
+                LoadOnStack(std::move(myReturn));
+            }
+
+            myReturn = nullptr;
         }
+    }
 
-        myReturn = nullptr;
+    // The result must not refer to the frame that is about to go away, a scalar read from it is already a copy
+    if (myStack.size() > base && myStack.back().myFrame != nullptr && myStack.back().myValue.IsScalar()) {
+        myStack.back().myFrame = nullptr;
+    } else if (myStack.size() > base && (myStack.back().myObject != nullptr || myStack.back().myFrame != nullptr)) {
+        Pointer<IVariable> result = PopCopy();
+        LoadOnStack(std::move(result));
     }
+    myActivations.pop_back();
 }
 
 void Interpreter::EnterNode(const UnaryPrefixOperationNode& node) {
     node.GetOperand().RunVisitor(*this);
-    LoadOnStack(PopFromStack()->ApplyOperation(node.GetLexeme().GetType()));
+    if (IsJumping()) {
+        return;
+    }
+
+    LexemeType operation = node.GetLexeme().GetType();
+    Value operand = operation == LexemeType::OpInc || operation == LexemeType::OpDec
+        ? StepSlot(myStack.back(), operation)
+        : GetScalar(myStack.back());
+    if (operand.IsScalar()) {
+        myStack.pop_back();
+        LoadOnStack(operation == LexemeType::OpInc || operation == LexemeType::OpDec
+            ? operand
+            : Value::ApplyOperation(operation, operand));
+        return;
+    }
+    LoadOnStack(PopFromStack()->ApplyOperation(operation));
 }
 
 void Interpreter::EnterNode(const UnaryPostfixOperationNode& node) {
     node.GetOperand().RunVisitor(*this);
+    if (IsJumping()) {
+        return;
+    }
+    Value current = GetScalar(myStack.back());
+    if (StepSlot(myStack.back(), node.GetLexeme().GetType()).IsScalar()) {
+        myStack.pop_back();
+        LoadOnStack(current);
+        return;
+    }
+
     auto var = PopFromStack();
-    LoadOnStack(InterpreterUtil::TryDereference(var.get())->Clone());
+    if (current.IsScalar()) {
+        LoadOnStack(current);
+    } else {
+        LoadOnStack(InterpreterUtil::TryDereference(var.get())->Clone());
+    }
     var->ApplyOperation(node.GetLexeme().GetType());
 }
 
 void Interpreter::EnterNode(const IndexSuffixNode& node) {
     for (auto& it : node.GetArguments().GetArguments()) {
         it->RunVisitor(*this);
+        if (IsJumping()) {
+            return;
+        }
     }
 
     node.GetExpression()->RunVisitor(*this);
-    Pointer<IVariable> arrRef = PopFromStack();
-    Pointer<IVariable> idxRef = PopFromStack();
-    IVariable* arr = InterpreterUtil::TryDereference(arrRef.get());
-    IVariable* idx = InterpreterUtil::TryDereference(idxRef.get());
-    LoadOnStack(dynamic_cast<Array*>(arr)->GetIterator(idx->GetValue<int>()));
+    if (IsJumping()) {
+        return;
+    }
+    auto arr = dynamic_cast<Array*>(GetVariable(myStack.back()));
+    Pointer<IVariable> element = arr->GetIterator(GetScalar(myStack[myStack.size() - 2]).Get<int>());
+    myStack.resize(myStack.size() - 2);
+    LoadOnStack(std::move(element));
 }
 
 void Interpreter::EnterNode(const BinOperationNode& node) {
     node.GetLeftOperand().RunVisitor(*this);
+    if (IsJumping()) {
+        return;
+    }
     node.GetRightOperand().RunVisitor(*this);
+    if (IsJumping()) {
+        return;
+    }
+
+    LexemeType operation = node.GetLexeme().GetType();
+    Value rhsValue = GetScalar(myStack.back());
+    Value lhsValue = GetScalar(myStack[myStack.size() - 2]);
+    if (lhsValue.IsScalar() && rhsValue.IsScalar() && operation != LexemeType::OpDDot) {
+        myStack.resize(myStack.size() - 2);
+        LoadOnStack(Value::ApplyOperation(operation, lhsValue, rhsValue));
+        return;
+    }
 
     Pointer<IVariable> rhsRef = PopFromStack();
     Pointer<IVariable> lhsRef = PopFromStack();
     IVariable* rhs = InterpreterUtil::TryDereference(rhsRef.get());
     IVariable* lhs = InterpreterUtil::TryDereference(lhsRef.get());
-    LoadOnStack(rhs->ApplyOperation(node.GetLexeme().GetType(), lhs));
+    LoadOnStack(rhs->ApplyOperation(operation, lhs));
 }
 
 void Interpreter::EnterNode(const IntegerNode& node) {
-    LoadOnStack(std::make_unique<Integer>(node.GetLexeme().GetValue<uint64_t>()));
+    LoadOnStack(Value(static_cast<int>(node.GetLexeme().GetValue<uint64_t>())));
 }
 
 void Interpreter::EnterNode(const DoubleNode& node) {
-    LoadOnStack(std::make_unique<Double>(node.GetLexeme().GetValue<double>()));
+    LoadOnStack(Value(node.GetLexeme().GetValue<double>()));
 }
 
 void Interpreter::EnterNode(const BooleanNode& node) {
-    LoadOnStack(std::make_unique<Boolean>(node.GetLexeme().GetValue<std::string>() == "true"));
+    LoadOnStack(Value(node.GetLexeme().GetKeyword() == Keyword::True));
 }
 
 void Interpreter::EnterNode(const StringNode& node) {
@@ -192,19 +313,61 @@ void Interpreter::EnterNode(const StringNode& node) {
 }
 
 void Interpreter::EnterNode(const IdentifierNode& node) {
-    LoadOnStack(myStack.top().GetVariable(node.GetIdentifier()));
+    auto sym = static_cast<const VariableSymbol*>(node.GetSymbol());
+    LoadSlot(GetFrame(sym), sym->GetOffset());
 }
 
 void Interpreter::EnterNode(const PropertyDeclaration& node) {
     node.GetInitialization().RunVisitor(*this);
-    Pointer<IVariable> initRes = PopFromStack();
-    Pointer<IVariable> var = InterpreterUtil::TryDereference(initRes.get())->Clone();
-    myStack.top().SetVariable(node.GetIdentifierName(), std::move(var));
+    if (IsJumping()) {
+        return;
+    }
+    Pointer<IVariable> var = PopCopy();
+
+    auto sym = dynamic_cast<const VariableSymbol*>(node.GetSymbol());
+    GetFrame(sym)->SetVariable(sym->GetOffset(), std::move(var));
 }
 
 void Interpreter::EnterNode(const Assignment& node) {
     node.GetAssignable().RunVisitor(*this);
+    if (IsJumping()) {
+        return;
+    }
     node.GetExpression().RunVisitor(*this);
+    if (IsJumping()) {
+        return;
+    }
+
+    const Operand& destination = myStack[myStack.size() - 2];
+    IVariable* target = destination.myFrame != nullptr
+        ? destination.myFrame->GetSlot(destination.myOffset)
+        : destination.myObject->GetValue<IVariable*>();
+    Value value = GetScalar(myStack.back());
+    if (value.IsScalar() && target->AsValue().IsScalar()) {
+        switch (node.GetLexeme().GetType()) {
+            case LexemeType::OpPlusAssign:
+                value = Value::ApplyOperation(LexemeType::OpAdd, target->AsValue(), value);
+                break;
+            case LexemeType::OpMinusAssign:
+                value = Value::ApplyOperation(LexemeType::OpSub, target->AsValue(), value);
+                break;
+            case LexemeType::OpMultAssign:
+                value = Value::ApplyOperation(LexemeType::OpMult, target->AsValue(), value);
+                break;
+            case LexemeType::OpDivAssign:
+                value = Value::ApplyOperation(LexemeType::OpDiv, target->AsValue(), value);
+                break;
+            case LexemeType::OpModAssign:
+                value = Value::ApplyOperation(LexemeType::OpMod, target->AsValue(), value);
+                break;
+            default:
+                break;
+        }
+
+        target->SetValue(value);
+        myStack.resize(myStack.size() - 2);
+        return;
+    }
 
     Pointer<IVariable> exprRes = PopFromStack();
     Pointer<IVariable> assignable = PopFromStack();
@@ -230,35 +393,42 @@ void Interpreter::EnterNode(const Assignment& node) {
             exprRes = InterpreterUtil::TryDereference(exprRes.get())->ApplyOperation(
                 LexemeType::OpMod, InterpreterUtil::TryDereference(assignable.get()));
             break;
+        default:
+            break;
     }
 
-    *assignable->GetValue<IVariable*>() = *InterpreterUtil::TryDereference(exprRes.get())->Clone();
+    target->Assign(*InterpreterUtil::TryDereference(exprRes.get()));
 }
 
 void Interpreter::EnterNode(const ContinueNode& node) {
-    throw ContinueException();
+    myCompletion = Completion::Continue;
 }
 
 void Interpreter::EnterNode(const BreakNode& node) {
-    throw BreakException();
+    myCompletion = Completion::Break;
 }
 
 void Interpreter::EnterNode(const ReturnNode& node) {
     if (node.HasExpression() && dynamic_cast<const EmptyStatement*>(node.GetExpression()) == nullptr) {
         node.GetExpression()->RunVisitor(*this);
-        myReturn = InterpreterUtil::TryDereference(PopFromStack().get())->Clone();
+        if (IsJumping()) {
+            return;
+        }
+        myReturn = PopCopy();
     }
 
-    throw ReturnException();
+    myCompletion = Completion::Return;
 }
 
 void Interpreter::EnterNode(const IfExpression& node) {
-    StackGuard guard(myStack, myStack.top(), true);
+    StackGuard guard(myStack, true);
 
     node.GetExpression()->RunVisitor(*this);
+    if (IsJumping()) {
+        return;
+    }
 
-    Pointer<IVariable> exprRes = PopFromStack();
-    if (InterpreterUtil::TryDereference(exprRes.get())->GetValue<bool>()) {
+    if (PopScalar().Get<bool>()) {
         node.GetIfBody()->RunVisitor(*this);
     } else {
         node.GetElseBody()->RunVisitor(*this);
@@ -267,76 +437,136 @@ void Interpreter::EnterNode(const IfExpression& node) {
 
 void Interpreter::EnterNode(const WhileNode& node) {
     node.GetExpression().RunVisitor(*this);
+    if (IsJumping()) {
+        return;
+    }
 
-    Pointer<IVariable> exprRes = PopFromStack();
-    while (InterpreterUtil::TryDereference(exprRes.get())->GetValue<bool>()) {
+    while (PopScalar().Get<bool>()) {
         {
-            StackGuard guard(myStack, myStack.top(), false);
-            try {
-                node.GetBody().RunVisitor(*this);
-            } catch (const ContinueException&) {
-            } catch (const BreakException&) {
+            StackGuard guard(myStack);
+            node.GetBody().RunVisitor(*this);
+            if (IsLoopExited()) {
                 break;
             }
         }
 
         node.GetExpression().RunVisitor(*this);
-        exprRes = PopFromStack();
+        if (IsJumping()) {
+            return;
+        }
     }
 }
 
 void Interpreter::EnterNode(const DoWhileNode& node) {
-    Pointer<IVariable> exprRes = nullptr;
+    bool isRunning = false;
     do {  
-        StackGuard guard(myStack, myStack.top(), false);
-        try {
-            node.GetBody().RunVisitor(*this);
-        } catch (const ContinueException&) {
-        } catch (const BreakException&) {
+        StackGuard guard(myStack);
+        node.GetBody().RunVisitor(*this);
+        if (IsLoopExited()) {
             break;
         }
 
         node.GetExpression().RunVisitor(*this);
-        exprRes = PopFromStack();
+        if (IsJumping()) {
+            return;
+        }
+        isRunning = PopScalar().Get<bool>();
         
-    } while (InterpreterUtil::TryDereference(exprRes.get())->GetValue<bool>());
+    } while (isRunning);
 }
 
 void Interpreter::EnterNode(const ForNode& node) {
+    auto rangeSym = dynamic_cast<const RangeSymbol*>(node.GetExpression().GetType());
+    if (rangeSym != nullptr && dynamic_cast<const IntegerSymbol*>(rangeSym->GetType()) != nullptr) {
+        RunCountedLoop(node);
+        return;
+    }
+
+    StackGuard iterableGuard(myStack);
     node.GetExpression().RunVisitor(*this);
-    Pointer<IVariable> iterablePtr = PopFromStack();
-    
-    auto iterable = dynamic_cast<IterableRef*>(InterpreterUtil::TryDereference(iterablePtr.get()));
+    if (IsJumping()) {
+        return;
+    }
+
+    auto iterable = dynamic_cast<IterableRef*>(GetVariable(myStack.back()));
     int iterableSize = iterable->Size();
+    auto variableSym = dynamic_cast<const VariableSymbol*>(node.GetVariable().GetSymbol());
 
     for (int i = 0; i < iterableSize; i++) {
         Pointer<IVariable> iteratorRef = iterable->GetIterator(i);
         IVariable* iterator = InterpreterUtil::TryDereference(iteratorRef.get());
 
-        StackGuard guard(myStack, myStack.top(), false);
-        myStack.top().AddGlobal(node.GetVariable().GetIdentifierName(), iterator);
+        StackGuard guard(myStack);
+        GetFrame(variableSym)->SetVariable(variableSym->GetOffset(), iterator->Clone());
 
-        try {
-            node.GetBody().RunVisitor(*this);
-        } catch (const ContinueException&) {
-        } catch (const BreakException&) {
+        node.GetBody().RunVisitor(*this);
+        if (IsLoopExited()) {
+            break;
+        }
+    }
+}
+
+void Interpreter::RunCountedLoop(const ForNode& node) {
+    int first;
+    int last;
+    {
+        StackGuard boundsGuard(myStack);
+        auto range = dynamic_cast<const BinOperationNode*>(&node.GetExpression());
+        if (range != nullptr && range->GetLexeme().GetType() == LexemeType::OpDDot) {
+            range->GetLeftOperand().RunVisitor(*this);
+            if (IsJumping()) {
+                return;
+            }
+            range->GetRightOperand().RunVisitor(*this);
+            if (IsJumping()) {
+                return;
+            }
+            first = GetScalar(myStack[myStack.size() - 2]).Get<int>();
+            last = GetScalar(myStack.back()).Get<int>();
+        } else {
+            node.GetExpression().RunVisitor(*this);
+            if (IsJumping()) {
+                return;
+            }
+            auto iterable = dynamic_cast<Range*>(GetVariable(myStack.back()));
+            first = iterable->GetLeft()->GetValue<int>();
+            last = iterable->GetRight()->GetValue<int>();
+        }
+    }
+
+    auto variableSym = dynamic_cast<const VariableSymbol*>(node.GetVariable().GetSymbol());
+    auto counter = std::make_unique<Integer>(first);
+    Integer* current = counter.get();
+    GetFrame(variableSym)->SetVariable(variableSym->GetOffset(), std::move(counter));
+
+    int size = last - first + 1;
+    for (int i = 0; i < size; i++) {
+        current->SetValue(first + i);
+
+        StackGuard guard(myStack);
+        node.GetBody().RunVisitor(*this);
+        if (IsLoopExited()) {
             break;
         }
     }
 }
 
 void Interpreter::EnterNode(const MemberAccessNode& node) {
-    node.GetExpression()->RunVisitor(*this);
-    auto lhs = PopFromStack();
-    auto classVar = dynamic_cast<Class*>(InterpreterUtil::TryDereference(lhs.get()));
+    auto memberSym = dynamic_cast<const VariableSymbol*>(node.GetMember()->GetSymbol());
 
-    if (classVar == nullptr || !classVar->Contains(node.GetMember()->GetIdentifier())) {
-        LoadOnStack(std::move(lhs));
+    node.GetExpression()->RunVisitor(*this);
+    if (IsJumping()) {
+        return;
+    }
+    auto classVar = dynamic_cast<Class*>(GetVariable(myStack.back()));
+    if (classVar == nullptr || memberSym == nullptr) {
         return;
     }
 
-    StackGuard guard(myStack, classVar->GetLocalSpace(), true);
-    node.GetMember()->RunVisitor(*this);
+    // The object stays reachable through the frame of its fields while the field is on the stack
+    const StackFrame* fields = &classVar->GetLocalSpace();
+    myStack.pop_back();
+    LoadSlot(fields, memberSym->GetOffset());
 }
 
 void Interpreter::Println(const FunctionSymbol* sym, const std::vector<IVariable*>& params) {
@@ -346,12 +576,8 @@ void Interpreter::Println(const FunctionSymbol* sym, const std::vector<IVariable
     if (dynamic_cast<const IntegerSymbol*>(sym->GetParameter(0))) {
         std::cout << params[0]->GetValue<int>() << std::endl;
     } else if (dynamic_cast<const DoubleSymbol*>(sym->GetParameter(0))) {
-        double integral;
-        if (std::modf(params[0]->GetValue<double>(), &integral) == 0) {
-            std::cout << std::fixed << std::setprecision(1) << params[0]->GetValue<double>() << std::endl;
-        } else {
-            std::cout << params[0]->GetValue<double>() << std::endl;
-        }
+        Value::PrintDouble(std::cout, params[0]->GetValue<double>());
+        std::cout << std::endl;
     } else if (dynamic_cast<const StringSymbol*>(sym->GetParameter(0))) {
         std::cout << params[0]->GetValue<std::string>() << std::endl;
     } else if (dynamic_cast<const BooleanSymbol*>(sym->GetParameter(0))) {
@@ -360,12 +586,7 @@ void Interpreter::Println(const FunctionSymbol* sym, const std::vector<IVariable
 }
 
 void Interpreter::ArrayOf(const FunctionSymbol* sym, const std::vector<IVariable*>& params) {
-    std::vector<IVariable*> argsRefs;
-    for (int i = 0; i < sym->GetParametersCount(); i++) {
-        argsRefs.push_back(LoadOnHeap(params[i]->Clone()));
-    }
-
-    StructArray* arrRef = dynamic_cast<StructArray*>(LoadOnHeap(std::make_unique<StructArray>(argsRefs)));
+    StructArray* arrRef = dynamic_cast<StructArray*>(LoadOnHeap(std::make_unique<StructArray>(params)));
     LoadOnStack(std::make_unique<Array>(arrRef));
 }
 
@@ -382,3 +603,88 @@ void Interpreter::Cast(const FunctionSymbol* sym, IVariable* var) {
     LoadOnStack(std::move(res));
 }
 
+bool Interpreter::IsJumping() const {
+    return myCompletion != Completion::Normal;
+}
+
+bool Interpreter::IsLoopExited() {
+    switch (myCompletion) {
+        case Completion::Continue:
+            myCompletion = Completion::Normal;
+            return false;
+        case Completion::Break:
+            myCompletion = Completion::Normal;
+            return true;
+        case Completion::Return:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void Interpreter::MarkRoots(GarbageCollector& collector) const {
+    for (auto& it : myStack) {
+        collector.MarkVariable(it.myObject.get());
+        if (it.myFrame != nullptr) {
+            it.myFrame->Trace(collector);
+        }
+    }
+    for (auto& it : myActivations) {
+        it.Trace(collector);
+    }
+    if (myFrame != nullptr) {
+        myFrame->Trace(collector);
+    }
+    collector.MarkVariable(myReturn.get());
+}
+
+StackFrame* Interpreter::GetFrame(const VariableSymbol* sym) const {
+    return myDisplay[sym->GetDepth()];
+}
+
+void Interpreter::LoadSlot(const StackFrame* frame, int offset) {
+    IVariable* slot = frame->GetSlot(offset);
+    Value value = slot != nullptr && slot->AsValue().IsScalar() ? slot->AsValue() : Value();
+    myStack.push_back(Operand{ value, nullptr, frame, offset });
+}
+
+Value Interpreter::GetScalar(const Operand& operand) const {
+    if (operand.myObject == nullptr) {
+        return operand.myValue;
+    }
+
+    const Value& value = InterpreterUtil::TryDereference(operand.myObject.get())->AsValue();
+    return value.IsScalar() ? value : Value();
+}
+
+IVariable* Interpreter::GetVariable(const Operand& operand) const {
+    if (operand.myFrame != nullptr) {
+        return operand.myFrame->GetSlot(operand.myOffset);
+    }
+    return InterpreterUtil::TryDereference(operand.myObject.get());
+}
+
+Value Interpreter::PopScalar() {
+    Value res = GetScalar(myStack.back());
+    myStack.pop_back();
+    return res;
+}
+
+Pointer<IVariable> Interpreter::PopCopy() {
+    Operand res = std::move(myStack.back());
+    myStack.pop_back();
+    IVariable* variable = GetVariable(res);
+    return variable != nullptr ? variable->Clone() : IVariable::FromValue(res.myValue);
+}
+
+Value Interpreter::StepSlot(const Operand& operand, LexemeType operation) {
+    if (operand.myFrame == nullptr || !operand.myValue.IsScalar()
+        || (operation != LexemeType::OpInc && operation != LexemeType::OpDec)) {
+        return Value();
+    }
+
+    LexemeType step = operation == LexemeType::OpInc ? LexemeType::OpAdd : LexemeType::OpSub;
+    Value value = Value::ApplyOperation(step, operand.myValue, Value(1));
+    operand.myFrame->GetSlot(operand.myOffset)->SetValue(value);
+    return value;
+}
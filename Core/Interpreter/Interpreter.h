@@ -1,8 +1,12 @@
 #pragma once
 
-#include <stack>
+#include <deque>
+#include <vector>
 
+#include "GarbageCollector.h"
+#include "JitCompiler.h"
 #include "StackFrame.h"
+#include "StackGuard.h"
 #include "../Parser/INodeVisitor.h"
 #include "../Parser/Semantics/SymbolTable.h"
 
@@ -13,9 +17,13 @@ public:
     Interpreter(const DeclarationBlock* syntaxTree, const SymbolTable* symbolTable);
 
     void RunMain();
+    void EnableJit(int threshold);
+
+    const GcStatistics& GetGcStatistics() const;
 
     IVariable* LoadOnHeap(Pointer<IVariable> variable);
     void LoadOnStack(Pointer<IVariable> variable);
+    void LoadOnStack(const Value& value);
     Pointer<IVariable> PopFromStack();
 
     void EnterNode(const DeclarationBlock& node) override;
@@ -57,14 +65,44 @@ public:
     void Cast(const FunctionSymbol* sym, IVariable* var);
 
 private:
+    enum class Completion {
+        Normal,
+        Break,
+        Continue,
+        Return,
+    };
+
+    bool IsJumping() const;
+    bool IsLoopExited();
+    void MarkRoots(GarbageCollector& collector) const;
+    StackFrame* GetFrame(const VariableSymbol* sym) const;
+    void LoadSlot(const StackFrame* frame, int offset);
+    // Returns the scalar held by a stack entry, either unboxed or behind a reference, or Unit for any other object
+    Value GetScalar(const Operand& operand) const;
+    // Returns the variable a stack entry holds or was read from, or nullptr for an unboxed scalar
+    IVariable* GetVariable(const Operand& operand) const;
+    Value PopScalar();
+    // Pops the top entry as a copy of its own, the way a declaration or a return keeps it
+    Pointer<IVariable> PopCopy();
+    // Applies ++ or -- in place to the scalar slot a variable read left on the stack and returns the new value,
+    // or Unit when the entry isn't such a slot
+    Value StepSlot(const Operand& operand, LexemeType operation);
+    void RunCountedLoop(const ForNode& node);
+
     const DeclarationBlock* myTree;
     const SymbolTable* myTable;
 
     const FunctionSymbol* myMain;
 
-    std::stack<StackFrame> myStack;
+    std::vector<Operand> myStack;
+    SlotStack mySlots;
+    std::deque<StackFrame> myActivations;
+    StackFrame* myFrame = nullptr;
+    // Frames of the static chain of myFrame by depth
+    std::vector<StackFrame*> myDisplay;
 
-    std::vector<Pointer<IVariable>> myHeap;
-    std::map<const ISymbol*, StackFrame> myVisibilityMap;
+    GarbageCollector myHeap;
+    Pointer<JitCompiler> myJit;
     Pointer<IVariable> myReturn;
+    Completion myCompletion = Completion::Normal;
 };
@@ -0,0 +1,957 @@
+#include "JitCompiler.h"
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "../Parser/DeclarationNodes.h"
+#include "../Parser/INodeVisitor.h"
+#include "../Parser/ExpressionNodes.h"
+#include "../Parser/StatementNodes.h"
+#include "../Parser/Semantics/FunctionSymbol.h"
+#include "../Parser/Semantics/FundamentalType.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+const int MAX_ARGUMENTS = 16;
+
+enum class Kind {
+    Int,
+    Double,
+    Boolean,
+};
+
+enum Register : uint8_t {
+    RAX = 0,
+    RCX = 1,
+    RDX = 2,
+    XMM0 = 0,
+    XMM1 = 1,
+    XMM2 = 2,
+};
+
+enum Condition : uint8_t {
+    Always = 0,
+    Parity = 0xA,
+    NotParity = 0xB,
+    Above = 0x7,
+    AboveOrEqual = 0x3,
+    Equal = 0x4,
+    NotEqual = 0x5,
+    Less = 0xC,
+    LessOrEqual = 0xE,
+    Greater = 0xF,
+    GreaterOrEqual = 0xD,
+};
+
+#ifdef _WIN32
+// mov rax, [rcx + disp32] / lea rcx, [rsp]
+const uint8_t ARGUMENTS_MODRM = 0x81;
+const uint8_t ARGUMENTS_LEA = 0x0C;
+const int32_t SHADOW_SPACE = 32;
+#else
+// mov rax, [rdi + disp32] / lea rdi, [rsp]
+const uint8_t ARGUMENTS_MODRM = 0x87;
+const uint8_t ARGUMENTS_LEA = 0x3C;
+const int32_t SHADOW_SPACE = 0;
+#endif
+
+double Remainder(double left, double right) {
+    return std::fmod(left, right);
+}
+
+template<typename T>
+bool Is(const AbstractType* type) {
+    return dynamic_cast<const T*>(type) != nullptr;
+}
+
+Kind GetKind(const AbstractType* type) {
+    if (Is<IntegerSymbol>(type)) {
+        return Kind::Int;
+    }
+    if (Is<DoubleSymbol>(type)) {
+        return Kind::Double;
+    }
+    if (Is<BooleanSymbol>(type)) {
+        return Kind::Boolean;
+    }
+    throw std::invalid_argument("Unsupported type");
+}
+
+void Expect(Kind actual, Kind expected) {
+    if (actual != expected) {
+        throw std::invalid_argument("Implicit conversion");
+    }
+}
+
+// Template compiler: every expression leaves an Int or Boolean in eax and a Double in xmm0, the left operand of a
+// binary operation waits on the machine stack. Locals live in the native frame at rbp - 8 * (offset + 1).
+// An Int division by zero sets the fault flag and returns, every caller returns as soon as it sees the flag set
+class NativeEmitter : public INodeVisitor {
+public:
+    using EntryResolver = std::function<JitCompiler::Entry*(const FunctionSymbol*)>;
+
+    NativeEmitter(const FunctionSymbol* function, EntryResolver resolver, uint8_t* fault)
+        : myFunction(function), myResolver(std::move(resolver)), myFault(fault) {}
+
+    std::vector<uint8_t> Compile() {
+        auto decl = dynamic_cast<const FunctionDeclaration*>(myFunction->GetDeclaration());
+        if (decl == nullptr || myFunction->GetParametersCount() > MAX_ARGUMENTS) {
+            throw std::invalid_argument("Unsupported function");
+        }
+        myDepth = decl->GetDepth();
+        myReturnKind = GetKind(myFunction->GetReturnType());
+
+        Emit({ 0x55, 0x48, 0x89, 0xE5, 0x48, 0x81, 0xEC });
+        Emit32((decl->GetFrameSize() + 1) / 2 * 16);
+
+        const auto& params = decl->GetParameters().GetParameters();
+        for (size_t i = 0; i < params.size(); i++) {
+            const VariableSymbol& param = GetLocal(params[i]->GetSymbol());
+            GetKind(param.GetType());
+            Emit({ 0x48, 0x8B, ARGUMENTS_MODRM });
+            Emit32(static_cast<uint32_t>(8 * (params.size() - 1 - i)));
+            Emit({ 0x48, 0x89, 0x85 });
+            Emit32(Slot(param));
+        }
+
+        if (dynamic_cast<const BlockNode*>(&decl->GetBody()) != nullptr) {
+            decl->GetBody().RunVisitor(*this);
+            Emit({ 0x31, 0xC0 });
+            Return();
+        } else {
+            Expect(CompileValue(decl->GetBody()), myReturnKind);
+            Return();
+        }
+
+        return myCode;
+    }
+
+    void EnterNode(const IVisitable& node) override {}
+
+    void EnterNode(const FunctionDeclaration& node) override {}
+    void EnterNode(const ClassDeclaration& node) override {}
+
+    void EnterNode(const PropertyDeclaration& node) override {
+        const VariableSymbol& variable = GetLocal(node.GetSymbol());
+        Kind kind = CompileValue(node.GetInitialization());
+        Expect(kind, GetKind(variable.GetType()));
+        Store(variable, kind);
+    }
+
+    void EnterNode(const BlockNode& node) override {
+        for (auto& it : node.GetStatements()) {
+            it->RunVisitor(*this);
+        }
+    }
+
+    void EnterNode(const EmptyStatement& node) override {}
+
+    void EnterNode(const CallSuffixNode& node) override {
+        auto funcSym = dynamic_cast<const FunctionSymbol*>(node.GetExpression()->GetSymbol());
+        const auto& arguments = node.GetArguments().GetArguments();
+        if (funcSym->GetDeclaration() == nullptr) {
+            CompileCast(node, funcSym);
+            return;
+        }
+        if (dynamic_cast<const IdentifierNode*>(node.GetExpression()) == nullptr
+            || static_cast<int>(arguments.size()) != funcSym->GetParametersCount()) {
+            throw std::invalid_argument("Unsupported call");
+        }
+
+        Kind returnKind = GetKind(funcSym->GetReturnType());
+        JitCompiler::Entry* entry = myResolver(funcSym);
+
+        // Keep rsp 16-byte aligned at the call once the arguments are pushed
+        int padding = (myPushed + arguments.size()) % 2 == 1 ? 8 : 0;
+        if (padding != 0) {
+            AdjustStack(-padding);
+            myPushed++;
+        }
+        for (size_t i = 0; i < arguments.size(); i++) {
+            Kind kind = CompileValue(*arguments[i]);
+            Expect(kind, GetKind(funcSym->GetParameter(static_cast<int>(i))));
+            Push(kind);
+        }
+
+        Emit({ 0x48, 0x8D, ARGUMENTS_LEA, 0x24 });
+        if (SHADOW_SPACE != 0) {
+            AdjustStack(-SHADOW_SPACE);
+        }
+        Emit({ 0x48, 0xB8 });
+        Emit64(reinterpret_cast<uint64_t>(entry));
+        Emit({ 0xFF, 0x10 });
+        AdjustStack(SHADOW_SPACE + padding + static_cast<int32_t>(8 * arguments.size()));
+        myPushed -= static_cast<int>(arguments.size()) + padding / 8;
+
+        // cmp byte [rdx], 0 on the fault flag
+        LoadFault();
+        Emit({ 0x80, 0x3A, 0x00 });
+        size_t done = Jump(Equal);
+        Return();
+        Bind(done);
+
+        if (returnKind == Kind::Double) {
+            MoveToDouble(XMM0);
+        }
+    }
+
+    void EnterNode(const UnaryPrefixOperationNode& node) override {
+        LexemeType operation = node.GetLexeme().GetType();
+        if (operation == LexemeType::OpInc || operation == LexemeType::OpDec) {
+            CompileIncrement(node.GetOperand(), operation, true);
+            return;
+        }
+
+        Kind kind = CompileValue(node.GetOperand());
+        if (operation == LexemeType::OpAdd && kind != Kind::Boolean) {
+            return;
+        }
+        if (operation == LexemeType::OpSub && kind == Kind::Int) {
+            Emit({ 0xF7, 0xD8 });
+        } else if (operation == LexemeType::OpSub && kind == Kind::Double) {
+            MoveFromDouble(XMM0);
+            Emit({ 0x48, 0x0F, 0xBA, 0xF8, 0x3F });
+            MoveToDouble(XMM0);
+        } else if (operation == LexemeType::OpExclMark && kind == Kind::Boolean) {
+            Emit({ 0x83, 0xF0, 0x01 });
+        } else {
+            throw std::invalid_argument("Unsupported operation");
+        }
+    }
+
+    void EnterNode(const UnaryPostfixOperationNode& node) override {
+        LexemeType operation = node.GetLexeme().GetType();
+        if (operation != LexemeType::OpInc && operation != LexemeType::OpDec) {
+            throw std::invalid_argument("Unsupported operation");
+        }
+        CompileIncrement(node.GetOperand(), operation, false);
+    }
+
+    void EnterNode(const IndexSuffixNode& node) override {
+        throw std::invalid_argument("Unsupported operation");
+    }
+
+    void EnterNode(const MemberAccessNode& node) override {
+        throw std::invalid_argument("Unsupported operation");
+    }
+
+    void EnterNode(const BinOperationNode& node) override {
+        LexemeType operation = node.GetLexeme().GetType();
+        Kind resultKind = GetKind(node.GetType());
+        if (operation == LexemeType::OpAnd || operation == LexemeType::OpOr) {
+            Expect(CompileValue(node.GetLeftOperand()), Kind::Boolean);
+            Emit({ 0x85, 0xC0 });
+            size_t end = Jump(operation == LexemeType::OpAnd ? Equal : NotEqual);
+            Expect(CompileValue(node.GetRightOperand()), Kind::Boolean);
+            Bind(end);
+            Expect(resultKind, Kind::Boolean);
+            return;
+        }
+
+        Kind left = CompileValue(node.GetLeftOperand());
+        Push(left);
+        Kind right = CompileValue(node.GetRightOperand());
+        MoveToRight(right);
+        Pop(left);
+        Expect(CompileBinary(operation, left, right), resultKind);
+    }
+
+    void EnterNode(const IntegerNode& node) override {
+        Emit({ 0xB8 });
+        Emit32(static_cast<uint32_t>(node.GetLexeme().GetValue<uint64_t>()));
+    }
+
+    void EnterNode(const DoubleNode& node) override {
+        LoadDouble(XMM0, node.GetLexeme().GetValue<double>());
+    }
+
+    void EnterNode(const BooleanNode& node) override {
+        Emit({ 0xB8 });
+        Emit32(node.GetLexeme().GetKeyword() == Keyword::True ? 1 : 0);
+    }
+
+    void EnterNode(const StringNode& node) override {
+        throw std::invalid_argument("Unsupported type");
+    }
+
+    void EnterNode(const IdentifierNode& node) override {
+        const VariableSymbol& variable = GetLocal(node.GetSymbol());
+        Load(variable, GetKind(variable.GetType()));
+    }
+
+    void EnterNode(const Assignment& node) override {
+        LexemeType operation = LexemeType::Error;
+        switch (node.GetLexeme().GetType()) {
+            case LexemeType::OpPlusAssign:
+                operation = LexemeType::OpAdd;
+                break;
+            case LexemeType::OpMinusAssign:
+                operation = LexemeType::OpSub;
+                break;
+            case LexemeType::OpMultAssign:
+                operation = LexemeType::OpMult;
+                break;
+            case LexemeType::OpDivAssign:
+                operation = LexemeType::OpDiv;
+                break;
+            case LexemeType::OpModAssign:
+                operation = LexemeType::OpMod;
+                break;
+            default:
+                break;
+        }
+
+        if (dynamic_cast<const IdentifierNode*>(&node.GetAssignable()) == nullptr) {
+            throw std::invalid_argument("Unsupported assignment");
+        }
+        const VariableSymbol& variable = GetLocal(node.GetAssignable().GetSymbol());
+        Kind kind = GetKind(variable.GetType());
+
+        Kind value = CompileValue(node.GetExpression());
+        if (operation != LexemeType::Error) {
+            MoveToRight(value);
+            Load(variable, kind);
+            value = CompileBinary(operation, kind, value);
+        }
+        Expect(value, kind);
+        Store(variable, kind);
+    }
+
+    void EnterNode(const ContinueNode& node) override {
+        if (myLoops.empty()) {
+            throw std::invalid_argument("Jump out of loop");
+        }
+        myLoops.back().myContinues.push_back(Jump(Always));
+    }
+
+    void EnterNode(const BreakNode& node) override {
+        if (myLoops.empty()) {
+            throw std::invalid_argument("Jump out of loop");
+        }
+        myLoops.back().myBreaks.push_back(Jump(Always));
+    }
+
+    void EnterNode(const ReturnNode& node) override {
+        if (!node.HasExpression() || dynamic_cast<const EmptyStatement*>(node.GetExpression()) != nullptr) {
+            throw std::invalid_argument("Return without value");
+        }
+        Expect(CompileValue(*node.GetExpression()), myReturnKind);
+        Return();
+    }
+
+    void EnterNode(const IfExpression& node) override {
+        bool isValue = !Is<UnitTypeSymbol>(node.GetType());
+        Kind kind = isValue ? GetKind(node.GetType()) : Kind::Int;
+
+        Expect(CompileValue(*node.GetExpression()), Kind::Boolean);
+        Emit({ 0x85, 0xC0 });
+        size_t elseBranch = Jump(Equal);
+        CompileBranch(*node.GetIfBody(), isValue, kind);
+        size_t end = Jump(Always);
+        Bind(elseBranch);
+        CompileBranch(*node.GetElseBody(), isValue, kind);
+        Bind(end);
+    }
+
+    void EnterNode(const WhileNode& node) override {
+        size_t start = myCode.size();
+        Expect(CompileValue(node.GetExpression()), Kind::Boolean);
+        Emit({ 0x85, 0xC0 });
+        size_t exit = Jump(Equal);
+
+        myLoops.emplace_back();
+        node.GetBody().RunVisitor(*this);
+        JumpTo(Always, start);
+        Bind(exit);
+        CloseLoop(start);
+    }
+
+    void EnterNode(const DoWhileNode& node) override {
+        size_t start = myCode.size();
+        myLoops.emplace_back();
+        node.GetBody().RunVisitor(*this);
+
+        size_t condition = myCode.size();
+        Expect(CompileValue(node.GetExpression()), Kind::Boolean);
+        Emit({ 0x85, 0xC0 });
+        JumpTo(NotEqual, start);
+        CloseLoop(condition);
+    }
+
+    void EnterNode(const ForNode& node) override {
+        throw std::invalid_argument("Unsupported loop");
+    }
+
+private:
+    struct Loop {
+        std::vector<size_t> myBreaks;
+        std::vector<size_t> myContinues;
+    };
+
+    Kind CompileValue(const IAnnotatedNode& node) {
+        node.RunVisitor(*this);
+        return GetKind(node.GetType());
+    }
+
+    void CompileBranch(const IAnnotatedNode& node, bool isValue, Kind kind) {
+        if (isValue) {
+            Expect(CompileValue(node), kind);
+        } else {
+            node.RunVisitor(*this);
+        }
+    }
+
+    // Left operand in eax / xmm0, right one in ecx / xmm1
+    Kind CompileBinary(LexemeType operation, Kind left, Kind right) {
+        if (left == Kind::Int && right == Kind::Int) {
+            switch (operation) {
+                case LexemeType::OpAdd:
+                    Emit({ 0x01, 0xC8 });
+                    return Kind::Int;
+                case LexemeType::OpSub:
+                    Emit({ 0x29, 0xC8 });
+                    return Kind::Int;
+                case LexemeType::OpMult:
+                    Emit({ 0x0F, 0xAF, 0xC1 });
+                    return Kind::Int;
+                case LexemeType::OpDiv:
+                case LexemeType::OpMod:
+                    CompileDivision(operation == LexemeType::OpDiv);
+                    return Kind::Int;
+                // Comparisons are compiled below, together with the Boolean ones
+                case LexemeType::OpLess:
+                case LexemeType::OpLessOrEq:
+                case LexemeType::OpGreater:
+                case LexemeType::OpGreaterOrEq:
+                case LexemeType::OpEqual:
+                case LexemeType::OpStrictEq:
+                case LexemeType::OpInequal:
+                case LexemeType::OpStrictIneq:
+                    break;
+                default:
+                    throw std::invalid_argument("Unsupported operation");
+            }
+        }
+
+        if (left == Kind::Boolean || right == Kind::Boolean || (left == Kind::Int && right == Kind::Int)) {
+            Condition condition = GetIntCondition(operation);
+            if (left != right) {
+                throw std::invalid_argument("Unsupported operation");
+            }
+            Emit({ 0x39, 0xC8 });
+            SetCondition(condition, RAX);
+            return Kind::Boolean;
+        }
+
+        bool isBothDouble = left == Kind::Double && right == Kind::Double;
+        if (left == Kind::Int) {
+            Sse(0xF2, 0x2A, XMM0, RAX);
+        }
+        if (right == Kind::Int) {
+            Sse(0xF2, 0x2A, XMM1, RCX);
+        }
+
+        switch (operation) {
+            case LexemeType::OpAdd:
+                Sse(0xF2, 0x58, XMM0, XMM1);
+                return Kind::Double;
+            case LexemeType::OpSub:
+                Sse(0xF2, 0x5C, XMM0, XMM1);
+                return Kind::Double;
+            case LexemeType::OpMult:
+                Sse(0xF2, 0x59, XMM0, XMM1);
+                return Kind::Double;
+            case LexemeType::OpDiv:
+                Sse(0xF2, 0x5E, XMM0, XMM1);
+                return Kind::Double;
+            case LexemeType::OpMod:
+                CallRemainder();
+                return Kind::Double;
+            // Unordered operands leave every flag set, so only "above" conditions are false for NaN
+            case LexemeType::OpLess:
+                Sse(0x66, 0x2E, XMM1, XMM0);
+                SetCondition(Above, RAX);
+                return Kind::Boolean;
+            case LexemeType::OpLessOrEq:
+                Sse(0x66, 0x2E, XMM1, XMM0);
+                SetCondition(AboveOrEqual, RAX);
+                return Kind::Boolean;
+            case LexemeType::OpGreater:
+                Sse(0x66, 0x2E, XMM0, XMM1);
+                SetCondition(Above, RAX);
+                return Kind::Boolean;
+            case LexemeType::OpGreaterOrEq:
+                Sse(0x66, 0x2E, XMM0, XMM1);
+                SetCondition(AboveOrEqual, RAX);
+                return Kind::Boolean;
+            case LexemeType::OpEqual:
+            case LexemeType::OpStrictEq:
+                if (isBothDouble) {
+                    Sse(0x66, 0x2E, XMM0, XMM1);
+                    SetCondition(Equal, RAX);
+                    SetCondition(NotParity, RCX);
+                    // and al, cl
+                    Emit({ 0x20, 0xC8 });
+                    return Kind::Boolean;
+                }
+                break;
+            case LexemeType::OpInequal:
+            case LexemeType::OpStrictIneq:
+                if (isBothDouble) {
+                    Sse(0x66, 0x2E, XMM0, XMM1);
+                    SetCondition(NotEqual, RAX);
+                    SetCondition(Parity, RCX);
+                    // or al, cl
+                    Emit({ 0x08, 0xC8 });
+                    return Kind::Boolean;
+                }
+                break;
+            default:
+                throw std::invalid_argument("Unsupported operation");
+        }
+
+        throw std::invalid_argument("Unsupported operation");
+    }
+
+    static Condition GetIntCondition(LexemeType operation) {
+        switch (operation) {
+            case LexemeType::OpLess:
+                return Less;
+            case LexemeType::OpLessOrEq:
+                return LessOrEqual;
+            case LexemeType::OpGreater:
+                return Greater;
+            case LexemeType::OpGreaterOrEq:
+                return GreaterOrEqual;
+            case LexemeType::OpEqual:
+            case LexemeType::OpStrictEq:
+                return Equal;
+            case LexemeType::OpInequal:
+            case LexemeType::OpStrictIneq:
+                return NotEqual;
+            default:
+                throw std::invalid_argument("Unsupported operation");
+        }
+    }
+
+    void CompileCast(const CallSuffixNode& node, const FunctionSymbol* funcSym) {
+        auto memberAccess = dynamic_cast<const MemberAccessNode*>(node.GetExpression());
+        if (memberAccess == nullptr) {
+            throw std::invalid_argument("Unsupported builtin");
+        }
+
+        Kind kind = CompileValue(*memberAccess->GetExpression());
+        if (funcSym->GetName() == "toInt" && kind == Kind::Double) {
+            Sse(0xF2, 0x2C, RAX, XMM0);
+        } else if (funcSym->GetName() == "toDouble" && kind == Kind::Int) {
+            Sse(0xF2, 0x2A, XMM0, RAX);
+        } else if (!(funcSym->GetName() == "toInt" && kind != Kind::Double)
+                   && !(funcSym->GetName() == "toDouble" && kind == Kind::Double)) {
+            throw std::invalid_argument("Unsupported builtin");
+        }
+    }
+
+    void CompileIncrement(const IAnnotatedNode& operand, LexemeType operation, bool isPrefix) {
+        if (dynamic_cast<const IdentifierNode*>(&operand) == nullptr) {
+            throw std::invalid_argument("Unsupported assignment");
+        }
+        const VariableSymbol& variable = GetLocal(operand.GetSymbol());
+        Kind kind = GetKind(variable.GetType());
+        bool isIncrement = operation == LexemeType::OpInc;
+
+        Load(variable, kind);
+        if (kind == Kind::Int) {
+            // add eax / ecx, +-1
+            uint8_t step = isIncrement ? 0x01 : 0xFF;
+            if (isPrefix) {
+                Emit({ 0x83, 0xC0, step });
+                Store(variable, kind);
+            } else {
+                Emit({ 0x89, 0xC1, 0x83, 0xC1, step });
+                IntSlot(0x89, RCX, Slot(variable));
+            }
+        } else if (kind == Kind::Double) {
+            LoadDouble(XMM1, 1.0);
+            Sse(0x66, 0x28, XMM2, XMM0);
+            Sse(0xF2, isIncrement ? 0x58 : 0x5C, XMM2, XMM1);
+            SseSlot(0x11, XMM2, Slot(variable));
+            if (isPrefix) {
+                Sse(0x66, 0x28, XMM0, XMM2);
+            }
+        } else {
+            throw std::invalid_argument("Unsupported operation");
+        }
+    }
+
+    // idiv traps on a zero divisor and on MIN_VALUE / -1, so both are handled before it
+    void CompileDivision(bool isQuotient) {
+        // test ecx, ecx
+        Emit({ 0x85, 0xC9 });
+        size_t nonZero = Jump(NotEqual);
+        // mov byte [rdx], 1
+        LoadFault();
+        Emit({ 0xC6, 0x02, 0x01 });
+        Return();
+        Bind(nonZero);
+
+        // cmp ecx, -1
+        Emit({ 0x83, 0xF9, 0xFF });
+        size_t regular = Jump(NotEqual);
+        if (isQuotient) {
+            // neg eax
+            Emit({ 0xF7, 0xD8 });
+        } else {
+            // xor eax, eax
+            Emit({ 0x31, 0xC0 });
+        }
+        size_t end = Jump(Always);
+        Bind(regular);
+        // cdq; idiv ecx, then mov eax, edx for the remainder
+        Emit({ 0x99, 0xF7, 0xF9 });
+        if (!isQuotient) {
+            Emit({ 0x89, 0xD0 });
+        }
+        Bind(end);
+    }
+
+    // mov rdx, imm64
+    void LoadFault() {
+        Emit({ 0x48, 0xBA });
+        Emit64(reinterpret_cast<uint64_t>(myFault));
+    }
+
+    void CallRemainder() {
+        int padding = myPushed % 2 == 1 ? 8 : 0;
+        AdjustStack(-(padding + SHADOW_SPACE));
+        Emit({ 0x48, 0xB8 });
+        Emit64(reinterpret_cast<uint64_t>(&Remainder));
+        Emit({ 0xFF, 0xD0 });
+        AdjustStack(padding + SHADOW_SPACE);
+    }
+
+    void CloseLoop(size_t continueTarget) {
+        Loop loop = std::move(myLoops.back());
+        myLoops.pop_back();
+        for (size_t jump : loop.myContinues) {
+            Bind(jump, continueTarget);
+        }
+        for (size_t jump : loop.myBreaks) {
+            Bind(jump);
+        }
+    }
+
+    const VariableSymbol& GetLocal(const ISymbol* symbol) const {
+        auto variable = dynamic_cast<const VariableSymbol*>(symbol);
+        if (variable == nullptr || variable->GetOffset() == -1 || variable->GetDepth() != myDepth) {
+            throw std::invalid_argument("Variable outside of the function frame");
+        }
+        return *variable;
+    }
+
+    static int32_t Slot(const VariableSymbol& variable) {
+        return -8 * (variable.GetOffset() + 1);
+    }
+
+    void Load(const VariableSymbol& variable, Kind kind) {
+        if (kind == Kind::Double) {
+            SseSlot(0x10, XMM0, Slot(variable));
+        } else {
+            IntSlot(0x8B, RAX, Slot(variable));
+        }
+    }
+
+    void Store(const VariableSymbol& variable, Kind kind) {
+        if (kind == Kind::Double) {
+            SseSlot(0x11, XMM0, Slot(variable));
+        } else {
+            IntSlot(0x89, RAX, Slot(variable));
+        }
+    }
+
+    void Push(Kind kind) {
+        if (kind == Kind::Double) {
+            MoveFromDouble(XMM0);
+        }
+        Emit({ 0x50 });
+        myPushed++;
+    }
+
+    void Pop(Kind kind) {
+        Emit({ 0x58 });
+        myPushed--;
+        if (kind == Kind::Double) {
+            MoveToDouble(XMM0);
+        }
+    }
+
+    void MoveToRight(Kind kind) {
+        if (kind == Kind::Double) {
+            Sse(0x66, 0x28, XMM1, XMM0);
+        } else {
+            Emit({ 0x89, 0xC1 });
+        }
+    }
+
+    void Return() {
+        if (myReturnKind == Kind::Double) {
+            MoveFromDouble(XMM0);
+        }
+        // mov rsp, rbp; pop rbp; ret
+        Emit({ 0x48, 0x89, 0xEC, 0x5D, 0xC3 });
+    }
+
+    void LoadDouble(uint8_t xmm, double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        Emit({ 0x48, 0xB8 });
+        Emit64(bits);
+        MoveToDouble(xmm);
+    }
+
+    // movq xmm, rax
+    void MoveToDouble(uint8_t xmm) {
+        Emit({ 0x66, 0x48, 0x0F, 0x6E, static_cast<uint8_t>(0xC0 | xmm << 3) });
+    }
+
+    // movq rax, xmm
+    void MoveFromDouble(uint8_t xmm) {
+        Emit({ 0x66, 0x48, 0x0F, 0x7E, static_cast<uint8_t>(0xC0 | xmm << 3) });
+    }
+
+    void AdjustStack(int32_t bytes) {
+        if (bytes == 0) {
+            return;
+        }
+        // add rsp, imm32 / sub rsp, imm32
+        Emit({ 0x48, 0x81, static_cast<uint8_t>(bytes > 0 ? 0xC4 : 0xEC) });
+        Emit32(static_cast<uint32_t>(bytes > 0 ? bytes : -bytes));
+    }
+
+    // setcc reg8; movzx eax, al for the first one
+    void SetCondition(Condition condition, uint8_t reg) {
+        Emit({ 0x0F, static_cast<uint8_t>(0x90 | condition), static_cast<uint8_t>(0xC0 | reg) });
+        if (reg == RAX) {
+            Emit({ 0x0F, 0xB6, 0xC0 });
+        }
+    }
+
+    void Sse(uint8_t prefix, uint8_t opcode, uint8_t reg, uint8_t rm) {
+        Emit({ prefix, 0x0F, opcode, static_cast<uint8_t>(0xC0 | reg << 3 | rm) });
+    }
+
+    void SseSlot(uint8_t opcode, uint8_t xmm, int32_t offset) {
+        Emit({ 0xF2, 0x0F, opcode, static_cast<uint8_t>(0x85 | xmm << 3) });
+        Emit32(static_cast<uint32_t>(offset));
+    }
+
+    void IntSlot(uint8_t opcode, uint8_t reg, int32_t offset) {
+        Emit({ opcode, static_cast<uint8_t>(0x85 | reg << 3) });
+        Emit32(static_cast<uint32_t>(offset));
+    }
+
+    size_t Jump(Condition condition) {
+        if (condition == Always) {
+            Emit({ 0xE9 });
+        } else {
+            Emit({ 0x0F, static_cast<uint8_t>(0x80 | condition) });
+        }
+        Emit32(0);
+        return myCode.size() - 4;
+    }
+
+    void JumpTo(Condition condition, size_t target) {
+        Bind(Jump(condition), target);
+    }
+
+    void Bind(size_t jump) {
+        Bind(jump, myCode.size());
+    }
+
+    void Bind(size_t jump, size_t target) {
+        auto displacement = static_cast<uint32_t>(static_cast<int32_t>(target - (jump + 4)));
+        for (int i = 0; i < 4; i++) {
+            myCode[jump + i] = static_cast<uint8_t>(displacement >> (8 * i));
+        }
+    }
+
+    void Emit(std::initializer_list<uint8_t> bytes) {
+        myCode.insert(myCode.end(), bytes);
+    }
+
+    void Emit32(uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            myCode.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void Emit64(uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            myCode.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    const FunctionSymbol* myFunction;
+    EntryResolver myResolver;
+    uint8_t* myFault;
+
+    int myDepth = 0;
+    Kind myReturnKind = Kind::Int;
+    int myPushed = 0;
+    std::vector<Loop> myLoops;
+    std::vector<uint8_t> myCode;
+};
+
+void* AllocateExecutable(const std::vector<uint8_t>& code) {
+#ifdef _WIN32
+    void* memory = VirtualAlloc(nullptr, code.size(), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (memory == nullptr) {
+        return nullptr;
+    }
+    std::memcpy(memory, code.data(), code.size());
+    DWORD previous;
+    if (!VirtualProtect(memory, code.size(), PAGE_EXECUTE_READ, &previous)) {
+        VirtualFree(memory, 0, MEM_RELEASE);
+        return nullptr;
+    }
+    FlushInstructionCache(GetCurrentProcess(), memory, code.size());
+#else
+    void* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    std::memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, code.size());
+        return nullptr;
+    }
+#endif
+    return memory;
+}
+
+void FreeExecutable(void* memory, size_t size) {
+#ifdef _WIN32
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, size);
+#endif
+}
+
+}
+
+JitCompiler::JitCompiler(int threshold) : myThreshold(threshold) {}
+
+JitCompiler::~JitCompiler() {
+    for (auto& [memory, size] : myPages) {
+        FreeExecutable(memory, size);
+    }
+}
+
+Pointer<IVariable> JitCompiler::TryCall(const FunctionSymbol* function, const std::vector<IVariable*>& params) {
+    Function& state = myFunctions[function];
+    if (state.myEntry == nullptr && (state.isRejected || ++state.myCalls < myThreshold || !Compile(function))) {
+        return nullptr;
+    }
+
+    uint64_t arguments[MAX_ARGUMENTS];
+    for (size_t i = 0; i < params.size(); i++) {
+        const Value& value = params[i]->AsValue();
+        uint64_t& argument = arguments[params.size() - 1 - i];
+        switch (value.GetTag()) {
+            case ValueTag::Integer:
+                argument = static_cast<uint32_t>(value.Get<int>());
+                break;
+            case ValueTag::Double: {
+                double number = value.Get<double>();
+                std::memcpy(&argument, &number, sizeof(argument));
+                break;
+            }
+            case ValueTag::Boolean:
+                argument = value.Get<bool>() ? 1 : 0;
+                break;
+            default:
+                return nullptr;
+        }
+    }
+
+    uint64_t result = state.myEntry(arguments);
+    if (myFault != 0) {
+        myFault = 0;
+        throw std::invalid_argument("Division by zero");
+    }
+    switch (GetKind(function->GetReturnType())) {
+        case Kind::Int:
+            return std::make_unique<Integer>(static_cast<int32_t>(static_cast<uint32_t>(result)));
+        case Kind::Double: {
+            double number;
+            std::memcpy(&number, &result, sizeof(number));
+            return std::make_unique<Double>(number);
+        }
+        default:
+            return std::make_unique<Boolean>((result & 0xFF) != 0);
+    }
+}
+
+// Compiles the function together with every function it calls. If any of them can't be compiled, the whole group
+// stays interpreted
+bool JitCompiler::Compile(const FunctionSymbol* function) {
+#if !defined(__x86_64__) && !defined(_M_X64)
+    myFunctions[function].isRejected = true;
+    return false;
+#else
+    std::vector<const FunctionSymbol*> pending{ function };
+    std::unordered_set<const FunctionSymbol*> queued{ function };
+    std::vector<std::pair<const FunctionSymbol*, std::vector<uint8_t>>> compiled;
+
+    try {
+        while (!pending.empty()) {
+            const FunctionSymbol* current = pending.back();
+            pending.pop_back();
+
+            NativeEmitter emitter(current, [&](const FunctionSymbol* callee) {
+                Function& state = myFunctions[callee];
+                if (state.isRejected) {
+                    throw std::invalid_argument("Callee is interpreted");
+                }
+                if (state.myEntry == nullptr && queued.insert(callee).second) {
+                    pending.push_back(callee);
+                }
+                return &state.myEntry;
+            }, &myFault);
+            compiled.emplace_back(current, emitter.Compile());
+        }
+    } catch (const std::invalid_argument&) {
+        myFunctions[function].isRejected = true;
+        return false;
+    }
+
+    std::vector<uint8_t> code;
+    std::vector<size_t> offsets;
+    for (auto& [current, body] : compiled) {
+        code.resize((code.size() + 15) / 16 * 16, 0xCC);
+        offsets.push_back(code.size());
+        code.insert(code.end(), body.begin(), body.end());
+    }
+
+    void* memory = AllocateExecutable(code);
+    if (memory == nullptr) {
+        myFunctions[function].isRejected = true;
+        return false;
+    }
+    myPages.emplace_back(memory, code.size());
+
+    for (size_t i = 0; i < compiled.size(); i++) {
+        myFunctions[compiled[i].first].myEntry = reinterpret_cast<Entry>(static_cast<uint8_t*>(memory) + offsets[i]);
+    }
+    return true;
+#endif
+}
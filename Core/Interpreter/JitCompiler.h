@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Variable.h"
+
+class FunctionSymbol;
+
+// Compiles hot functions that only compute with Int, Double and Boolean values in their own frame to x86-64
+// machine code. Functions it can't compile, and everything on other platforms, stay in the tree walker
+class JitCompiler {
+public:
+    // Arguments are passed in the order they are pushed, the last one first
+    using Entry = uint64_t (*)(const uint64_t* arguments);
+
+    explicit JitCompiler(int threshold);
+    ~JitCompiler();
+
+    JitCompiler(const JitCompiler&) = delete;
+    JitCompiler& operator=(const JitCompiler&) = delete;
+
+    // Counts the call and runs it natively once the function is hot, returns nullptr when it has to be interpreted.
+    // Throws std::invalid_argument when the native code divided an Int by zero
+    Pointer<IVariable> TryCall(const FunctionSymbol* function, const std::vector<IVariable*>& params);
+
+private:
+    struct Function {
+        int myCalls = 0;
+        bool isRejected = false;
+        Entry myEntry = nullptr;
+    };
+
+    bool Compile(const FunctionSymbol* function);
+
+    int myThreshold;
+    std::unordered_map<const FunctionSymbol*, Function> myFunctions;
+    std::vector<std::pair<void*, size_t>> myPages;
+    // Set by native code that divided an Int by zero
+    uint8_t myFault = 0;
+};
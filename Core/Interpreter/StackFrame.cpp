@@ -1,47 +1,106 @@
 #include "StackFrame.h"
-#include "InterpreterUtil.h"
+
+#include <algorithm>
+
+#include "GarbageCollector.h"
 #include "Variable.h"
 
-StackFrame StackFrame::Clone() const {
-    StackFrame newFrame;
-    newFrame.myGlobals = myGlobals;
-    for (auto& local : myLocals) {
-        newFrame.myGlobals[local.first] = local.second.get();
+namespace {
+    const int ChunkSize = 4096;
+}
+
+SlotStack::Chunk::Chunk(int capacity) : mySlots(new Pointer<IVariable>[capacity]), myCapacity(capacity) {}
+
+Pointer<IVariable>* SlotStack::Push(int size) {
+    if (myChunks.empty()) {
+        myChunks.emplace_back(std::max(size, ChunkSize));
+    }
+
+    // The chunks after the current one are empty, a frame that doesn't fit moves on to the next big enough chunk
+    while (myChunks[myCurrent].myTop + size > myChunks[myCurrent].myCapacity) {
+        myCurrent++;
+        if (myCurrent == myChunks.size()) {
+            myChunks.emplace_back(std::max(size, ChunkSize));
+        } else if (myChunks[myCurrent].myCapacity < size) {
+            myChunks[myCurrent] = Chunk(size);
+        }
     }
-    return newFrame;
+
+    Chunk& chunk = myChunks[myCurrent];
+    Pointer<IVariable>* slots = chunk.mySlots.get() + chunk.myTop;
+    chunk.myTop += size;
+    return slots;
 }
 
-void StackFrame::SetVariable(const std::string& name, Pointer<IVariable> variable) {
-    myLocals[name] = std::move(variable);
+void SlotStack::Pop(Pointer<IVariable>* slots, int size) {
+    for (int i = 0; i < size; i++) {
+        slots[i].reset();
+    }
+
+    Chunk& chunk = myChunks[myCurrent];
+    chunk.myTop -= size;
+    if (chunk.myTop == 0 && myCurrent > 0) {
+        myCurrent--;
+    }
 }
 
-void StackFrame::AddGlobal(const std::string& name, IVariable* variable) {
-    myGlobals[name] = variable;
+StackFrame::StackFrame(int depth, int size, StackFrame* parent)
+    : myDepth(depth), myParent(parent), mySize(size), myStorage(size) {
+    mySlots = myStorage.data();
 }
 
-Pointer<Reference> StackFrame::GetVariable(const std::string& name) const {
-    if (myLocals.count(name)) {
-        return InterpreterUtil::CreateReference(myLocals.at(name).get());
+StackFrame::StackFrame(int depth, int size, StackFrame* parent, SlotStack& slots)
+    : myDepth(depth), myParent(parent), myStack(&slots), mySize(size), mySlots(slots.Push(size)) {}
+
+// Moving the storage keeps its buffer, so the slots stay where they are
+StackFrame::StackFrame(StackFrame&& other) noexcept
+    : myDepth(other.myDepth), myParent(other.myParent), myOwner(other.myOwner), myStack(other.myStack),
+      mySize(other.mySize), mySlots(other.mySlots), myStorage(std::move(other.myStorage)) {
+    other.myStack = nullptr;
+    other.mySize = 0;
+}
+
+StackFrame::~StackFrame() {
+    if (myStack != nullptr) {
+        myStack->Pop(mySlots, mySize);
     }
+}
 
-    return InterpreterUtil::CreateReference(myGlobals.at(name));
+int StackFrame::GetDepth() const {
+    return myDepth;
 }
 
-bool StackFrame::Contains(const std::string& name) const {
-    return myLocals.count(name) + myGlobals.count(name) > 0;
+StackFrame* StackFrame::GetParent() const {
+    return myParent;
 }
 
-void StackFrame::Load(Pointer<IVariable> val) {
-    myExecutionStack.push(std::move(val));
+void StackFrame::SetOwner(const IVariable* owner) {
+    myOwner = owner;
 }
 
-Pointer<IVariable> StackFrame::Pop() {
-    Pointer<IVariable> res = std::move(myExecutionStack.top());
-    myExecutionStack.pop();
-    return res;
+void StackFrame::SetVariable(int offset, Pointer<IVariable> variable) {
+    mySlots[offset] = std::move(variable);
 }
 
-bool StackFrame::Empty() const {
-    return myExecutionStack.empty();
+Pointer<Reference> StackFrame::GetVariable(int offset) const {
+    return std::make_unique<Reference>(mySlots[offset].get(), myOwner);
 }
 
+IVariable* StackFrame::GetSlot(int offset) const {
+    return mySlots[offset].get();
+}
+
+void StackFrame::Trace(GarbageCollector& collector) const {
+    if (!collector.Mark(this)) {
+        return;
+    }
+
+    for (int i = 0; i < mySize; i++) {
+        collector.MarkVariable(mySlots[i].get());
+    }
+    collector.MarkVariable(myOwner);
+
+    if (myParent != nullptr) {
+        myParent->Trace(collector);
+    }
+}
@@ -1,25 +1,54 @@
 #pragma once
-#include <map>
-#include <string>
-#include <stack>
+#include <vector>
 
 #include "Variable.h"
 
+// Slots of the running calls. Calls return in the order opposite to how they were made, so a call takes its slots
+// from the top of a chunk instead of allocating them
+class SlotStack {
+public:
+    Pointer<IVariable>* Push(int size);
+    // Frees the variables in the topmost slots and gives the slots back
+    void Pop(Pointer<IVariable>* slots, int size);
+
+private:
+    struct Chunk {
+        explicit Chunk(int capacity);
+
+        std::unique_ptr<Pointer<IVariable>[]> mySlots;
+        int myCapacity;
+        int myTop = 0;
+    };
+
+    std::vector<Chunk> myChunks;
+    size_t myCurrent = 0;
+};
+
 class StackFrame {
 public:
-    StackFrame Clone() const;
+    // The frame owns its slots, used by objects that outlive the call creating them
+    StackFrame(int depth, int size, StackFrame* parent);
+    // The frame takes its slots from the stack and gives them back when it is destroyed
+    StackFrame(int depth, int size, StackFrame* parent, SlotStack& slots);
+    StackFrame(StackFrame&& other) noexcept;
+    ~StackFrame();
+
+    int GetDepth() const;
+    StackFrame* GetParent() const;
+    void SetOwner(const IVariable* owner);
 
-    void SetVariable(const std::string& name, Pointer<IVariable> variable);
-    void AddGlobal(const std::string& name, IVariable* variable);
-    Pointer<Reference> GetVariable(const std::string& name) const;
-    bool Contains(const std::string& name) const;
+    void SetVariable(int offset, Pointer<IVariable> variable);
+    Pointer<Reference> GetVariable(int offset) const;
+    IVariable* GetSlot(int offset) const;
 
-    void Load(Pointer<IVariable> val);
-    Pointer<IVariable> Pop();
-    bool Empty() const;
+    void Trace(GarbageCollector& collector) const;
 
 private:
-    std::map<std::string, Pointer<IVariable>> myLocals;
-    std::map<std::string, IVariable*> myGlobals;
-    std::stack<Pointer<IVariable>> myExecutionStack;
+    int myDepth;
+    StackFrame* myParent;
+    const IVariable* myOwner = nullptr;
+    SlotStack* myStack = nullptr;
+    int mySize;
+    Pointer<IVariable>* mySlots;
+    std::vector<Pointer<IVariable>> myStorage;
 };
@@ -1,13 +1,42 @@
 #include "StackGuard.h"
 
-StackGuard::StackGuard(std::stack<StackFrame>& stack, const StackFrame& frame, bool shouldReturn) : myStack(stack), myReturn(shouldReturn) {
-    stack.push(frame.Clone());
-}
+StackGuard::StackGuard(std::vector<Operand>& stack, bool shouldReturn)
+    : myStack(stack), myBase(stack.size()), myReturn(shouldReturn) {}
 
 StackGuard::~StackGuard() {
-    StackFrame lastFrame = std::move(myStack.top());
-    myStack.pop();
-    if (myReturn && !lastFrame.Empty()) {
-        myStack.top().Load(lastFrame.Pop());
+    if (myReturn && myStack.size() > myBase) {
+        myStack[myBase] = std::move(myStack.back());
+        myStack.resize(myBase + 1);
+    } else {
+        myStack.resize(myBase);
+    }
+}
+
+FrameGuard::FrameGuard(StackFrame*& current, std::vector<StackFrame*>& display, StackFrame* frame)
+    : myCurrent(current), myPrevious(current), myDisplay(display) {
+    Show(myDisplay, frame, myPrevious != nullptr ? myPrevious->GetDepth() : -1);
+    myCurrent = frame;
+}
+
+FrameGuard::~FrameGuard() {
+    if (myPrevious != nullptr) {
+        Show(myDisplay, myPrevious, myCurrent->GetDepth());
+    }
+    myCurrent = myPrevious;
+}
+
+// The entries up to valid hold the chain of the frame being left. Once the walk meets a frame already there,
+// the rest of the chain is shared, so a call from the same scope only updates its own entry
+void FrameGuard::Show(std::vector<StackFrame*>& display, StackFrame* frame, int valid) {
+    if (display.size() <= static_cast<size_t>(frame->GetDepth())) {
+        display.resize(frame->GetDepth() + 1);
+    }
+
+    for (; frame != nullptr; frame = frame->GetParent()) {
+        int depth = frame->GetDepth();
+        if (depth <= valid && display[depth] == frame) {
+            return;
+        }
+        display[depth] = frame;
     }
 }
@@ -1,13 +1,41 @@
 #pragma once
+#include <vector>
+
 #include "StackFrame.h"
 
+// Entry of the tree walker stack: scalars are kept unboxed in myValue, anything else is owned by myObject.
+// A variable read leaves the frame slot it was read from instead of a reference, with its scalar copied to myValue
+struct Operand {
+    Value myValue;
+    Pointer<IVariable> myObject;
+    const StackFrame* myFrame = nullptr;
+    int myOffset = 0;
+};
+
 class StackGuard {
 public:
-    explicit StackGuard(std::stack<StackFrame>& stack, const StackFrame& frame, bool shouldReturn = false);
+    explicit StackGuard(std::vector<Operand>& stack, bool shouldReturn = false);
 
     ~StackGuard();
 
 private:
-    std::stack<StackFrame>& myStack;
+    std::vector<Operand>& myStack;
+    size_t myBase;
     bool myReturn;
 };
+
+// Switches the running frame and points display[depth] at the frame of that depth in its static chain,
+// so a variable is found without walking the parents
+class FrameGuard {
+public:
+    FrameGuard(StackFrame*& current, std::vector<StackFrame*>& display, StackFrame* frame);
+
+    ~FrameGuard();
+
+private:
+    static void Show(std::vector<StackFrame*>& display, StackFrame* frame, int valid);
+
+    StackFrame*& myCurrent;
+    StackFrame* myPrevious;
+    std::vector<StackFrame*>& myDisplay;
+};
@@ -0,0 +1,202 @@
+#include "Value.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+    // Int arithmetic wraps around like Kotlin's Int (and kt_iadd and friends in the C runtime)
+    int WrapAdd(int lhs, int rhs) {
+        return static_cast<int32_t>(static_cast<uint32_t>(lhs) + static_cast<uint32_t>(rhs));
+    }
+
+    int WrapSub(int lhs, int rhs) {
+        return static_cast<int32_t>(static_cast<uint32_t>(lhs) - static_cast<uint32_t>(rhs));
+    }
+
+    int WrapMult(int lhs, int rhs) {
+        return static_cast<int32_t>(static_cast<uint32_t>(lhs) * static_cast<uint32_t>(rhs));
+    }
+
+    int WrapNeg(int value) {
+        return static_cast<int32_t>(0u - static_cast<uint32_t>(value));
+    }
+
+    void CheckDivisor(int rhs) {
+        if (rhs == 0) {
+            throw std::invalid_argument("Division by zero");
+        }
+    }
+}
+
+Value::Value() : myTag(ValueTag::Unit), myObject(nullptr) {}
+
+Value::Value(int value) : myTag(ValueTag::Integer), myInt(value) {}
+
+Value::Value(double value) : myTag(ValueTag::Double), myDouble(value) {}
+
+Value::Value(bool value) : myTag(ValueTag::Boolean), myBool(value) {}
+
+Value::Value(IVariable* value) : myTag(ValueTag::Object), myObject(value) {}
+
+ValueTag Value::GetTag() const {
+    return myTag;
+}
+
+bool Value::IsUnit() const {
+    return myTag == ValueTag::Unit;
+}
+
+bool Value::IsObject() const {
+    return myTag == ValueTag::Object;
+}
+
+bool Value::IsScalar() const {
+    return myTag == ValueTag::Integer || myTag == ValueTag::Double || myTag == ValueTag::Boolean;
+}
+
+Value Value::ApplyOperation(LexemeType operation, const Value& lhs, const Value& rhs) {
+    if (lhs.myTag == ValueTag::Integer && rhs.myTag == ValueTag::Integer) {
+        switch (operation) {
+            case LexemeType::OpAdd:
+                return Value(WrapAdd(lhs.myInt, rhs.myInt));
+            case LexemeType::OpSub:
+                return Value(WrapSub(lhs.myInt, rhs.myInt));
+            case LexemeType::OpMult:
+                return Value(WrapMult(lhs.myInt, rhs.myInt));
+            // MIN_VALUE / -1 overflows, so -1 never reaches the hardware division
+            case LexemeType::OpDiv:
+                CheckDivisor(rhs.myInt);
+                return Value(rhs.myInt == -1 ? WrapNeg(lhs.myInt) : lhs.myInt / rhs.myInt);
+            case LexemeType::OpMod:
+                CheckDivisor(rhs.myInt);
+                return Value(rhs.myInt == -1 ? 0 : lhs.myInt % rhs.myInt);
+            case LexemeType::OpEqual:
+            case LexemeType::OpStrictEq:
+                return Value(lhs.myInt == rhs.myInt);
+            case LexemeType::OpInequal:
+            case LexemeType::OpStrictIneq:
+                return Value(lhs.myInt != rhs.myInt);
+            case LexemeType::OpLess:
+                return Value(lhs.myInt < rhs.myInt);
+            case LexemeType::OpLessOrEq:
+                return Value(lhs.myInt <= rhs.myInt);
+            case LexemeType::OpGreater:
+                return Value(lhs.myInt > rhs.myInt);
+            case LexemeType::OpGreaterOrEq:
+                return Value(lhs.myInt >= rhs.myInt);
+            default:
+                break;
+        }
+    } else if ((lhs.myTag == ValueTag::Integer || lhs.myTag == ValueTag::Double)
+               && (rhs.myTag == ValueTag::Integer || rhs.myTag == ValueTag::Double)) {
+        double left = lhs.myTag == ValueTag::Integer ? lhs.myInt : lhs.myDouble;
+        double right = rhs.myTag == ValueTag::Integer ? rhs.myInt : rhs.myDouble;
+        bool isBothDouble = lhs.myTag == ValueTag::Double && rhs.myTag == ValueTag::Double;
+
+        switch (operation) {
+            case LexemeType::OpAdd:
+                return Value(left + right);
+            case LexemeType::OpSub:
+                return Value(left - right);
+            case LexemeType::OpMult:
+                return Value(left * right);
+            case LexemeType::OpDiv:
+                return Value(left / right);
+            case LexemeType::OpMod:
+                return Value(std::fmod(left, right));
+            case LexemeType::OpLess:
+                return Value(left < right);
+            case LexemeType::OpLessOrEq:
+                return Value(left <= right);
+            case LexemeType::OpGreater:
+                return Value(left > right);
+            case LexemeType::OpGreaterOrEq:
+                return Value(left >= right);
+            case LexemeType::OpEqual:
+            case LexemeType::OpStrictEq:
+                if (isBothDouble) {
+                    return Value(left == right);
+                }
+                break;
+            case LexemeType::OpInequal:
+            case LexemeType::OpStrictIneq:
+                if (isBothDouble) {
+                    return Value(left != right);
+                }
+                break;
+            default:
+                break;
+        }
+    } else if (lhs.myTag == ValueTag::Boolean && rhs.myTag == ValueTag::Boolean) {
+        switch (operation) {
+            case LexemeType::OpAnd:
+                return Value(lhs.myBool && rhs.myBool);
+            case LexemeType::OpOr:
+                return Value(lhs.myBool || rhs.myBool);
+            case LexemeType::OpEqual:
+            case LexemeType::OpStrictEq:
+                return Value(lhs.myBool == rhs.myBool);
+            case LexemeType::OpInequal:
+            case LexemeType::OpStrictIneq:
+                return Value(lhs.myBool != rhs.myBool);
+            case LexemeType::OpLess:
+                return Value(lhs.myBool < rhs.myBool);
+            case LexemeType::OpLessOrEq:
+                return Value(lhs.myBool <= rhs.myBool);
+            case LexemeType::OpGreater:
+                return Value(lhs.myBool > rhs.myBool);
+            case LexemeType::OpGreaterOrEq:
+                return Value(lhs.myBool >= rhs.myBool);
+            default:
+                break;
+        }
+    }
+
+    throw std::invalid_argument("Invalid operation");
+}
+
+Value Value::ApplyOperation(LexemeType operation, const Value& operand) {
+    switch (operand.myTag) {
+        case ValueTag::Integer:
+            if (operation == LexemeType::OpAdd) {
+                return operand;
+            }
+            if (operation == LexemeType::OpSub) {
+                return Value(WrapNeg(operand.myInt));
+            }
+            break;
+        case ValueTag::Double:
+            if (operation == LexemeType::OpAdd) {
+                return operand;
+            }
+            if (operation == LexemeType::OpSub) {
+                return Value(-operand.myDouble);
+            }
+            break;
+        case ValueTag::Boolean:
+            if (operation == LexemeType::OpExclMark) {
+                return Value(!operand.myBool);
+            }
+            break;
+        default:
+            break;
+    }
+
+    throw std::invalid_argument("Invalid operation");
+}
+
+void Value::PrintDouble(std::ostream& output, double value) {
+    double integral;
+    if (std::isnan(value)) {
+        output << "NaN";
+    } else if (std::isinf(value)) {
+        output << (value > 0 ? "Infinity" : "-Infinity");
+    } else if (std::modf(value, &integral) == 0) {
+        output << std::fixed << std::setprecision(1) << value;
+    } else {
+        output << value;
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <iosfwd>
+
+#include "../Lexer/LexerUtils.h"
+
+class IVariable;
+
+enum class ValueTag : uint8_t {
+    Unit,
+    Integer,
+    Double,
+    Boolean,
+    Object,
+};
+
+class Value {
+public:
+    Value();
+    explicit Value(int value);
+    explicit Value(double value);
+    explicit Value(bool value);
+    explicit Value(IVariable* value);
+
+    ValueTag GetTag() const;
+    bool IsUnit() const;
+    bool IsObject() const;
+    bool IsScalar() const;
+
+    template<typename T>
+    T Get() const;
+
+    static Value ApplyOperation(LexemeType operation, const Value& lhs, const Value& rhs);
+    static Value ApplyOperation(LexemeType operation, const Value& operand);
+
+    // Prints a Double the way Kotlin does: whole numbers keep one decimal digit, infinities and NaN are spelled out
+    static void PrintDouble(std::ostream& output, double value);
+
+private:
+    ValueTag myTag;
+    union {
+        int myInt;
+        double myDouble;
+        bool myBool;
+        IVariable* myObject;
+    };
+};
+
+static_assert(sizeof(Value) == 16, "Value must fit in two machine words");
+
+template<>
+inline int Value::Get<int>() const {
+    return myInt;
+}
+
+template<>
+inline double Value::Get<double>() const {
+    return myDouble;
+}
+
+template<>
+inline bool Value::Get<bool>() const {
+    return myBool;
+}
+
+template<>
+inline IVariable* Value::Get<IVariable*>() const {
+    return myObject;
+}
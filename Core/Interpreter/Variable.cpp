@@ -1,8 +1,35 @@
 #include "Variable.h"
+#include "GarbageCollector.h"
 
-#include <iomanip>
 #include <sstream>
 
+const Value& IVariable::AsValue() const {
+    return myValue;
+}
+
+Pointer<IVariable> IVariable::FromValue(const Value& value) {
+    switch (value.GetTag()) {
+        case ValueTag::Integer:
+            return std::make_unique<Integer>(value.Get<int>());
+        case ValueTag::Double:
+            return std::make_unique<Double>(value.Get<double>());
+        case ValueTag::Boolean:
+            return std::make_unique<Boolean>(value.Get<bool>());
+        default:
+            break;
+    }
+
+    throw std::invalid_argument("Invalid operation");
+}
+
+const std::string& IVariable::GetString() const {
+    throw std::invalid_argument("Invalid operation");
+}
+
+void IVariable::Assign(const IVariable& other) {
+    myValue = other.myValue;
+}
+
 Pointer<IVariable> IVariable::ApplyOperation(LexemeType operation, const Integer* rhs) const {
     throw std::invalid_argument("Invalid operation");
 }
@@ -35,6 +62,8 @@ Pointer<IVariable> IVariable::ApplyOperation(LexemeType operation) const {
     throw std::invalid_argument("Invalid operation");
 }
 
+void IVariable::Trace(GarbageCollector& collector) const {}
+
 Pointer<IVariable> ValueType::CastFrom(const Integer* val) const {
     throw std::invalid_argument("Invalid operation");
 }
@@ -75,60 +104,14 @@ Pointer<IVariable> Integer::ApplyOperation(LexemeType operation, const IVariable
     return lhs->ApplyOperation(operation, this);
 }
 Pointer<IVariable> Integer::ApplyOperation(LexemeType operation, const Integer* rhs) const {
-    switch (operation) {
-        case LexemeType::OpAdd:
-            return std::make_unique<Integer>(GetValue<int>() + rhs->GetValue<int>());
-        case LexemeType::OpSub:
-            return std::make_unique<Integer>(GetValue<int>() - rhs->GetValue<int>());
-        case LexemeType::OpMult:
-            return std::make_unique<Integer>(GetValue<int>() * rhs->GetValue<int>());
-        case LexemeType::OpDiv:
-            return std::make_unique<Integer>(GetValue<int>() / rhs->GetValue<int>());
-        case LexemeType::OpMod:
-            return std::make_unique<Integer>(GetValue<int>() % rhs->GetValue<int>());
-        case LexemeType::OpEqual:
-        case LexemeType::OpStrictEq:
-            return std::make_unique<Boolean>(GetValue<int>() == rhs->GetValue<int>());
-        case LexemeType::OpInequal:
-        case LexemeType::OpStrictIneq:
-            return std::make_unique<Boolean>(GetValue<int>() != rhs->GetValue<int>());
-        case LexemeType::OpLess:
-            return std::make_unique<Boolean>(GetValue<int>() < rhs->GetValue<int>());
-        case LexemeType::OpLessOrEq:
-            return std::make_unique<Boolean>(GetValue<int>() <= rhs->GetValue<int>());
-        case LexemeType::OpGreater:
-            return std::make_unique<Boolean>(GetValue<int>() > rhs->GetValue<int>());
-        case LexemeType::OpGreaterOrEq:
-            return std::make_unique<Boolean>(GetValue<int>() >= rhs->GetValue<int>());
-        case LexemeType::OpDDot:
-            return std::make_unique<StructRange>(this, rhs);
+    if (operation == LexemeType::OpDDot) {
+        return std::make_unique<StructRange>(this, rhs);
     }
 
-    return IVariable::ApplyOperation(operation, rhs);
+    return FromValue(Value::ApplyOperation(operation, AsValue(), rhs->AsValue()));
 }
 Pointer<IVariable> Integer::ApplyOperation(LexemeType operation, const Double* rhs) const {
-    switch (operation) {
-        case LexemeType::OpAdd:
-            return std::make_unique<Double>(GetValue<int>() + rhs->GetValue<double>());
-        case LexemeType::OpSub:
-            return std::make_unique<Double>(GetValue<int>() - rhs->GetValue<double>());
-        case LexemeType::OpMult:
-            return std::make_unique<Double>(GetValue<int>() * rhs->GetValue<double>());
-        case LexemeType::OpDiv:
-            return std::make_unique<Double>(GetValue<int>() / rhs->GetValue<double>());
-        case LexemeType::OpMod:
-            return std::make_unique<Double>(std::fmod(GetValue<int>(), rhs->GetValue<double>()));
-        case LexemeType::OpLess:
-            return std::make_unique<Boolean>(GetValue<int>() < rhs->GetValue<double>());
-        case LexemeType::OpLessOrEq:
-            return std::make_unique<Boolean>(GetValue<int>() <= rhs->GetValue<double>());
-        case LexemeType::OpGreater:
-            return std::make_unique<Boolean>(GetValue<int>() > rhs->GetValue<double>());
-        case LexemeType::OpGreaterOrEq:
-            return std::make_unique<Boolean>(GetValue<int>() >= rhs->GetValue<double>());
-    }
-
-    return IVariable::ApplyOperation(operation, rhs);
+    return FromValue(Value::ApplyOperation(operation, AsValue(), rhs->AsValue()));
 }
 
 Pointer<IVariable> Integer::ApplyOperation(LexemeType operation, const Array* rhs) const {
@@ -154,14 +137,7 @@ Pointer<IVariable> Integer::ApplyOperation(LexemeType operation, const Range* rh
 }
 
 Pointer<IVariable> Integer::ApplyOperation(LexemeType operation) const {
-    if (operation == LexemeType::OpAdd) {
-        return std::make_unique<Integer>(GetValue<int>());
-    }
-    if (operation == LexemeType::OpSub) {
-        return std::make_unique<Integer>(-GetValue<int>());
-    }
-
-    return IVariable::ApplyOperation(operation);
+    return FromValue(Value::ApplyOperation(operation, AsValue()));
 }
 
 
@@ -186,60 +162,14 @@ Pointer<IVariable> Double::ApplyOperation(LexemeType operation, const IVariable*
 }
 
 Pointer<IVariable> Double::ApplyOperation(LexemeType operation, const Integer* rhs) const {
-    switch (operation) {
-        case LexemeType::OpAdd:
-            return std::make_unique<Double>(GetValue<double>() + rhs->GetValue<int>());
-        case LexemeType::OpSub:
-            return std::make_unique<Double>(GetValue<double>() - rhs->GetValue<int>());
-        case LexemeType::OpMult:
-            return std::make_unique<Double>(GetValue<double>() * rhs->GetValue<int>());
-        case LexemeType::OpDiv:
-            return std::make_unique<Double>(GetValue<double>() / rhs->GetValue<int>());
-        case LexemeType::OpMod:
-            return std::make_unique<Double>(std::fmod(GetValue<double>(), rhs->GetValue<int>()));
-        case LexemeType::OpLess:
-            return std::make_unique<Boolean>(GetValue<double>() < rhs->GetValue<int>());
-        case LexemeType::OpLessOrEq:
-            return std::make_unique<Boolean>(GetValue<double>() <= rhs->GetValue<int>());
-        case LexemeType::OpGreater:
-            return std::make_unique<Boolean>(GetValue<double>() > rhs->GetValue<int>());
-        case LexemeType::OpGreaterOrEq:
-            return std::make_unique<Boolean>(GetValue<double>() >= rhs->GetValue<int>());
-    }
-
-    return IVariable::ApplyOperation(operation, rhs);
+    return FromValue(Value::ApplyOperation(operation, AsValue(), rhs->AsValue()));
 }
 Pointer<IVariable> Double::ApplyOperation(LexemeType operation, const Double* rhs) const {
-    switch (operation) {
-        case LexemeType::OpAdd:
-            return std::make_unique<Double>(GetValue<double>() + rhs->GetValue<double>());
-        case LexemeType::OpSub:
-            return std::make_unique<Double>(GetValue<double>() - rhs->GetValue<double>());
-        case LexemeType::OpMult:
-            return std::make_unique<Double>(GetValue<double>() * rhs->GetValue<double>());
-        case LexemeType::OpDiv:
-            return std::make_unique<Double>(GetValue<double>() / rhs->GetValue<double>());
-        case LexemeType::OpMod:
-            return std::make_unique<Double>(std::fmod(GetValue<double>(), rhs->GetValue<double>()));
-        case LexemeType::OpEqual:
-        case LexemeType::OpStrictEq:
-            return std::make_unique<Boolean>(GetValue<double>() == rhs->GetValue<double>());
-        case LexemeType::OpInequal:
-        case LexemeType::OpStrictIneq:
-            return std::make_unique<Boolean>(GetValue<double>() != rhs->GetValue<double>());
-        case LexemeType::OpLess:
-            return std::make_unique<Boolean>(GetValue<double>() < rhs->GetValue<double>());
-        case LexemeType::OpLessOrEq:
-            return std::make_unique<Boolean>(GetValue<double>() <= rhs->GetValue<double>());
-        case LexemeType::OpGreater:
-            return std::make_unique<Boolean>(GetValue<double>() > rhs->GetValue<double>());
-        case LexemeType::OpGreaterOrEq:
-            return std::make_unique<Boolean>(GetValue<double>() >= rhs->GetValue<double>());
-        case LexemeType::OpDDot:
-            return std::make_unique<StructRange>(this, rhs);
+    if (operation == LexemeType::OpDDot) {
+        return std::make_unique<StructRange>(this, rhs);
     }
 
-    return IVariable::ApplyOperation(operation, rhs);
+    return FromValue(Value::ApplyOperation(operation, AsValue(), rhs->AsValue()));
 }
 
 Pointer<IVariable> Double::ApplyOperation(LexemeType operation, const Array* rhs) const {
@@ -265,14 +195,7 @@ Pointer<IVariable> Double::ApplyOperation(LexemeType operation, const Range* rhs
 }
 
 Pointer<IVariable> Double::ApplyOperation(LexemeType operation) const {
-    if (operation == LexemeType::OpAdd) {
-        return std::make_unique<Double>(GetValue<double>());
-    }
-    if (operation == LexemeType::OpSub) {
-        return std::make_unique<Double>(-GetValue<double>());
-    }
-
-    return IVariable::ApplyOperation(operation);
+    return FromValue(Value::ApplyOperation(operation, AsValue()));
 }
 
 Boolean::Boolean(bool value) {
@@ -292,30 +215,11 @@ Pointer<IVariable> Boolean::ApplyOperation(LexemeType operation, const IVariable
 }
 
 Pointer<IVariable> Boolean::ApplyOperation(LexemeType operation, const Boolean* rhs) const {
-    switch (operation) {
-        case LexemeType::OpAnd:
-            return std::make_unique<Boolean>(GetValue<bool>() && rhs->GetValue<bool>());
-        case LexemeType::OpOr:
-            return std::make_unique<Boolean>(GetValue<bool>() || rhs->GetValue<bool>());
-        case LexemeType::OpEqual:
-        case LexemeType::OpStrictEq:
-            return std::make_unique<Boolean>(GetValue<bool>() == rhs->GetValue<bool>());
-        case LexemeType::OpInequal:
-        case LexemeType::OpStrictIneq:
-            return std::make_unique<Boolean>(GetValue<bool>() != rhs->GetValue<bool>());
-        case LexemeType::OpLess:
-            return std::make_unique<Boolean>(GetValue<bool>() < rhs->GetValue<bool>());
-        case LexemeType::OpLessOrEq:
-            return std::make_unique<Boolean>(GetValue<bool>() <= rhs->GetValue<bool>());
-        case LexemeType::OpGreater:
-            return std::make_unique<Boolean>(GetValue<bool>() > rhs->GetValue<bool>());
-        case LexemeType::OpGreaterOrEq:
-            return std::make_unique<Boolean>(GetValue<bool>() >= rhs->GetValue<bool>());
-        case LexemeType::OpDDot:
-            return std::make_unique<StructRange>(this, rhs);
+    if (operation == LexemeType::OpDDot) {
+        return std::make_unique<StructRange>(this, rhs);
     }
 
-    return IVariable::ApplyOperation(operation, rhs);
+    return FromValue(Value::ApplyOperation(operation, AsValue(), rhs->AsValue()));
 }
 
 Pointer<IVariable> Boolean::ApplyOperation(LexemeType operation, const Range* rhs) const {
@@ -341,16 +245,10 @@ Pointer<IVariable> Boolean::ApplyOperation(LexemeType operation, const Array* rh
 }
 
 Pointer<IVariable> Boolean::ApplyOperation(LexemeType operation) const {
-    if (operation == LexemeType::OpExclMark) {
-        return std::make_unique<Boolean>(!GetValue<bool>());
-    }
-
-    return IVariable::ApplyOperation(operation);
+    return FromValue(Value::ApplyOperation(operation, AsValue()));
 }
 
-String::String(const std::string& value) {
-    SetValue(value);
-}
+String::String(const std::string& value) : myString(value) {}
 
 Pointer<IVariable> String::Cast(const ValueType& resType) const {
     return resType.CastFrom(this);
@@ -362,12 +260,7 @@ Pointer<IVariable> String::CastFrom(const Boolean* val) const {
 
 Pointer<IVariable> String::CastFrom(const Double* val) const {
     std::stringstream ss;
-    double integral;
-    if (std::modf(val->GetValue<double>(), &integral) == 0) {
-        ss << std::fixed << std::setprecision(1) << val->GetValue<double>();
-    } else {
-        ss << val->GetValue<double>();
-    }
+    Value::PrintDouble(ss, val->GetValue<double>());
     return std::make_unique<String>(ss.str());
 }
 
@@ -376,7 +269,16 @@ Pointer<IVariable> String::CastFrom(const Integer* val) const {
 }
 
 Pointer<IVariable> String::Clone() const {
-    return std::make_unique<String>(GetValue<std::string>());
+    return std::make_unique<String>(myString);
+}
+
+const std::string& String::GetString() const {
+    return myString;
+}
+
+void String::Assign(const IVariable& other) {
+    IVariable::Assign(other);
+    myString = other.GetString();
 }
 
 Pointer<IVariable> String::ApplyOperation(LexemeType operation, const IVariable* lhs) const {
@@ -386,13 +288,15 @@ Pointer<IVariable> String::ApplyOperation(LexemeType operation, const IVariable*
 Pointer<IVariable> String::ApplyOperation(LexemeType operation, const String* rhs) const {
     switch (operation) {
         case LexemeType::OpAdd:
-            return std::make_unique<String>(GetValue<std::string>() + rhs->GetValue<std::string>());
+            return std::make_unique<String>(myString + rhs->myString);
         case LexemeType::OpEqual:
         case LexemeType::OpStrictEq:
-            return std::make_unique<Boolean>(GetValue<std::string>() == rhs->GetValue<std::string>());
+            return std::make_unique<Boolean>(myString == rhs->myString);
         case LexemeType::OpInequal:
         case LexemeType::OpStrictIneq:
-            return std::make_unique<Boolean>(GetValue<std::string>() != rhs->GetValue<std::string>());
+            return std::make_unique<Boolean>(myString != rhs->myString);
+        default:
+            break;
     }
 
     return IVariable::ApplyOperation(operation, rhs);
@@ -413,8 +317,17 @@ Reference::Reference(IVariable* src) {
     SetValue<IVariable*>(src);
 }
 
+Reference::Reference(IVariable* src, const IVariable* owner) : myOwner(owner) {
+    SetValue<IVariable*>(src);
+}
+
 Pointer<Reference> Reference::CloneRef() const {
-    return std::make_unique<Reference>(GetValue<IVariable*>());
+    return std::make_unique<Reference>(GetValue<IVariable*>(), myOwner);
+}
+
+void Reference::Trace(GarbageCollector& collector) const {
+    collector.MarkVariable(GetValue<IVariable*>());
+    collector.MarkVariable(myOwner);
 }
 
 Pointer<IVariable> Reference::Clone() const {
@@ -466,7 +379,8 @@ Pointer<IVariable> Reference::ApplyOperation(LexemeType operation) const {
     if (operation == LexemeType::OpInc || operation == LexemeType::OpDec) {
         IVariable* val = GetValue<IVariable*>();
         if (dynamic_cast<Integer*>(val)) {
-            val->SetValue(val->GetValue<int>() + (operation == LexemeType::OpInc ? 1 : -1));
+            LexemeType step = operation == LexemeType::OpInc ? LexemeType::OpAdd : LexemeType::OpSub;
+            val->SetValue(Value::ApplyOperation(step, val->AsValue(), Value(1)).Get<int>());
             return val->Clone();
         }
         if (dynamic_cast<Double*>(val)) {
@@ -484,6 +398,32 @@ StructArray::StructArray(const std::vector<IVariable*>& src) {
     }
 }
 
+StructArray::StructArray(ValueTag elementTag, const std::vector<Value>& src) : myElementTag(elementTag) {
+    switch (myElementTag) {
+        case ValueTag::Integer:
+            myInts.resize(src.size());
+            break;
+        case ValueTag::Double:
+            myDoubles.resize(src.size());
+            break;
+        case ValueTag::Boolean:
+            myBooleans.resize(src.size());
+            break;
+        default:
+            throw std::invalid_argument("Unsupported element type");
+    }
+
+    for (size_t i = 0; i < src.size(); i++) {
+        SetElement(i, src[i]);
+    }
+}
+
+void StructArray::Trace(GarbageCollector& collector) const {
+    for (auto& it : myVariables) {
+        collector.MarkVariable(it.get());
+    }
+}
+
 Pointer<IVariable> StructArray::Clone() const {
     throw std::invalid_argument("Unsupported operation");
 }
@@ -492,6 +432,10 @@ Pointer<IVariable> StructArray::ApplyOperation(LexemeType operation, const IVari
     return lhs->ApplyOperation(operation, this);
 }
 
+bool StructArray::IsPacked() const {
+    return myElementTag != ValueTag::Object;
+}
+
 std::vector<const IVariable*> StructArray::Get() const {
     std::vector<const IVariable*> res;
     for (auto& it : myVariables) {
@@ -501,17 +445,65 @@ std::vector<const IVariable*> StructArray::Get() const {
 }
 
 Pointer<Reference> StructArray::Get(int idx) const {
-    return std::make_unique<Reference>(myVariables[idx].get());
+    return std::make_unique<Reference>(myVariables[idx].get(), this);
+}
+
+IVariable* StructArray::GetVariable(int idx) const {
+    return myVariables[idx].get();
+}
+
+Value StructArray::GetElement(int idx) const {
+    switch (myElementTag) {
+        case ValueTag::Integer:
+            return Value(static_cast<int>(myInts[idx]));
+        case ValueTag::Double:
+            return Value(myDoubles[idx]);
+        case ValueTag::Boolean:
+            return Value(myBooleans[idx] != 0);
+        default:
+            break;
+    }
+    return myVariables[idx]->AsValue();
+}
+
+void StructArray::SetElement(int idx, const Value& value) {
+    switch (myElementTag) {
+        case ValueTag::Integer:
+            myInts[idx] = value.Get<int>();
+            break;
+        case ValueTag::Double:
+            myDoubles[idx] = value.Get<double>();
+            break;
+        case ValueTag::Boolean:
+            myBooleans[idx] = value.Get<bool>();
+            break;
+        default:
+            throw std::invalid_argument("Unsupported operation");
+    }
 }
 
 int StructArray::Size() const {
+    switch (myElementTag) {
+        case ValueTag::Integer:
+            return myInts.size();
+        case ValueTag::Double:
+            return myDoubles.size();
+        case ValueTag::Boolean:
+            return myBooleans.size();
+        default:
+            break;
+    }
     return myVariables.size();
 }
 
 bool StructArray::In(const IVariable* val) const {
     for (int i = 0; i < Size(); i++) {
         try {
-            if (val->ApplyOperation(LexemeType::OpStrictEq, myVariables[i].get())->GetValue<bool>()) {
+            if (IsPacked()) {
+                if (val->ApplyOperation(LexemeType::OpStrictEq, FromValue(GetElement(i)).get())->GetValue<bool>()) {
+                    return true;
+                }
+            } else if (val->ApplyOperation(LexemeType::OpStrictEq, myVariables[i].get())->GetValue<bool>()) {
                 return true;
             }
         } catch (const std::invalid_argument&) {}
@@ -536,7 +528,14 @@ Pointer<IVariable> Array::ApplyOperation(LexemeType operation, const IVariable*
 }
 
 Pointer<IVariable> Array::GetIterator(int idx) const {
-    return Dereference<StructArray>()->Get(idx);
+    auto elements = Dereference<StructArray>();
+    if (idx < 0 || idx >= elements->Size()) {
+        throw std::invalid_argument("Index " + std::to_string(idx) + " out of bounds for length " + std::to_string(elements->Size()));
+    }
+    if (elements->IsPacked()) {
+        return FromValue(elements->GetElement(idx));
+    }
+    return elements->Get(idx);
 }
 
 int Array::Size() const {
@@ -599,6 +598,8 @@ Pointer<IVariable> Range::ApplyOperation(LexemeType operation, const Range* rhs)
             return std::make_unique<Boolean>(*Dereference<StructRange>() == *rhs->Dereference<StructRange>());
         case LexemeType::OpInequal:
             return std::make_unique<Boolean>(*Dereference<StructRange>() != *rhs->Dereference<StructRange>());
+        default:
+            break;
     }
 
     return IVariable::ApplyOperation(operation, rhs);
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <any>
+#include <string>
+#include <type_traits>
 
+#include "Value.h"
 #include "../Parser/ParserUtils.h"
 
 class Range;
@@ -11,6 +13,7 @@ class String;
 class Boolean;
 class Double;
 class Integer;
+class GarbageCollector;
 
 class IVariable {
 public:
@@ -18,14 +21,25 @@ public:
 
     template<typename T>
     T GetValue() const {
-        return std::any_cast<T>(myValue);
+        if constexpr (std::is_same_v<T, std::string>) {
+            return GetString();
+        } else {
+            return myValue.Get<T>();
+        }
     }
 
     template<typename T>
     void SetValue(T newVal) {
-        myValue.emplace<T>(newVal);
+        myValue = Value(newVal);
     }
 
+    const Value& AsValue() const;
+    static Pointer<IVariable> FromValue(const Value& value);
+
+    virtual const std::string& GetString() const;
+    // Overwrites the contents of this variable with the contents of another one of the same type
+    virtual void Assign(const IVariable& other);
+
     virtual Pointer<IVariable> Clone() const = 0;
 
     virtual Pointer<IVariable> ApplyOperation(LexemeType operation, const IVariable* lhs) const = 0;
@@ -40,8 +54,10 @@ public:
 
     virtual Pointer<IVariable> ApplyOperation(LexemeType operation) const;
 
+    virtual void Trace(GarbageCollector& collector) const;
+
 private:
-    std::any myValue;
+    Value myValue;
 };
 
 class ValueType : public IVariable {
@@ -117,14 +133,21 @@ public:
 
     Pointer<IVariable> Clone() const override;
 
+    const std::string& GetString() const override;
+    void Assign(const IVariable& other) override;
+
     Pointer<IVariable> ApplyOperation(LexemeType operation, const IVariable* lhs) const override;
     Pointer<IVariable> ApplyOperation(LexemeType operation, const String* rhs) const override;
     Pointer<IVariable> ApplyOperation(LexemeType operation, const Array* rhs) const override;
+
+private:
+    std::string myString;
 };
 
 class Reference : public IVariable {
 public:
     explicit Reference(IVariable* src);
+    Reference(IVariable* src, const IVariable* owner);
 
     template<typename T>
     T* Dereference() const {
@@ -146,26 +169,42 @@ public:
 
     Pointer<IVariable> ApplyOperation(LexemeType operation) const override;
 
+    void Trace(GarbageCollector& collector) const override;
+
 protected:
     Pointer<Boolean> CheckStrictEquality(LexemeType operation, const IVariable* lhs) const;
 
+private:
+    const IVariable* myOwner = nullptr;
 };
 
 class StructArray : public IVariable {
 public:
     explicit StructArray(const std::vector<IVariable*>& src);
+    StructArray(ValueTag elementTag, const std::vector<Value>& src);
 
     Pointer<IVariable> Clone() const override;
     Pointer<IVariable> ApplyOperation(LexemeType operation, const IVariable* lhs) const override;
 
+    bool IsPacked() const;
+
     std::vector<const IVariable*> Get() const;
     Pointer<Reference> Get(int idx) const;
+    IVariable* GetVariable(int idx) const;
+    Value GetElement(int idx) const;
+    void SetElement(int idx, const Value& value);
     int Size() const;
 
     bool In(const IVariable* val) const;
 
+    void Trace(GarbageCollector& collector) const override;
+
 private:
+    ValueTag myElementTag = ValueTag::Object;
     std::vector<Pointer<IVariable>> myVariables;
+    std::vector<int32_t> myInts;
+    std::vector<double> myDoubles;
+    std::vector<uint8_t> myBooleans;
 };
 
 class IterableRef : public Reference {
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+enum class Keyword : std::uint8_t {
+    None,
+    Return, Continue, Break, This, Super, File, Field, Property, Get, Set, Receiver, Param, Setparam,
+    Delegate, Package, Import, Class, Interface, Fun, Object, Val, Var, Typealias, Constructor, By, Companion,
+    Init, Typeof, Where, If, Else, When, Try, Catch, Finally, For, Do, While, Throw, As, Is, In, Out, Dynamic,
+    Public, Private, Protected, Internal, Enum, Sealed, Annotation, Data, Inner, Tailrec, Operator, Inline,
+    Infix, External, Suspend, Override, Abstract, Final, Open, Const, Lateinit, Vararg, Noinline, Crossinline,
+    Reified, Expect, Actual, True, False, Null
+};
+
+class KeywordHash {
+public:
+    static constexpr std::size_t KEYWORDS_COUNT = 74;
+    static constexpr std::uint32_t SEED = 76391;
+
+    static constexpr std::array<std::string_view, KEYWORDS_COUNT> Names {
+        "return", "continue", "break", "this", "super", "file", "field", "property", "get", "set", "receiver",
+        "param", "setparam", "delegate", "package", "import", "class", "interface", "fun", "object", "val",
+        "var", "typealias", "constructor", "by", "companion", "init", "typeof", "where", "if", "else", "when",
+        "try", "catch", "finally", "for", "do", "while", "throw", "as", "is", "in", "out", "dynamic",
+        "public", "private", "protected", "internal", "enum", "sealed", "annotation", "data", "inner",
+        "tailrec", "operator", "inline", "infix", "external", "suspend", "override", "abstract", "final",
+        "open", "const", "lateinit", "vararg", "noinline", "crossinline", "reified", "expect", "actual",
+        "true", "false", "null"
+    };
+
+    static constexpr std::uint8_t Hash(std::string_view text) {
+        std::uint32_t hash = SEED;
+        for (char character : text) {
+            hash = (hash ^ static_cast<std::uint8_t>(character)) * 16777619u;
+        }
+        return static_cast<std::uint8_t>(hash >> 24);
+    }
+
+    static constexpr std::array<std::uint8_t, 256> BuildTable() {
+        std::array<std::uint8_t, 256> table{};
+        for (std::size_t i = 0; i < KEYWORDS_COUNT; i++) {
+            table[Hash(Names[i])] = static_cast<std::uint8_t>(i + 1);
+        }
+        return table;
+    }
+
+    static constexpr bool IsPerfect() {
+        std::array<bool, 256> isUsed{};
+        for (std::size_t i = 0; i < KEYWORDS_COUNT; i++) {
+            if (isUsed[Hash(Names[i])]) {
+                return false;
+            }
+            isUsed[Hash(Names[i])] = true;
+        }
+        return true;
+    }
+
+};
+
+class Keywords {
+public:
+    static constexpr std::array<std::uint8_t, 256> Table = KeywordHash::BuildTable();
+
+    static constexpr Keyword Find(std::string_view text) {
+        std::uint8_t idx = Table[KeywordHash::Hash(text)];
+        if (idx == 0 || KeywordHash::Names[idx - 1] != text) {
+            return Keyword::None;
+        }
+        return static_cast<Keyword>(idx);
+    }
+};
+
+static_assert(KeywordHash::IsPerfect(), "Keyword hash has collisions, pick another seed");
+static_assert(Keywords::Find("class") == Keyword::Class && Keywords::Find("classes") == Keyword::None, "Keyword lookup is broken");
@@ -1,11 +1,52 @@
 #include "Lexeme.h"
 
+#include <charconv>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 #include "../magic_enum.hpp"
 
 const std::string Lexeme::DEFAULT_LEXEME_ERROR = "Uninitialized lexeme";
 
+namespace {
+    // Reports failures the way std::stoull and std::stod do, which readers of serialized lexemes rely on
+    void CheckParsed(std::from_chars_result result) {
+        if (result.ec == std::errc::invalid_argument) {
+            throw std::invalid_argument("Malformed number");
+        }
+        if (result.ec == std::errc::result_out_of_range) {
+            throw std::out_of_range("Number is out of range");
+        }
+    }
+
+    std::uint64_t ParseInteger(std::string_view text) {
+        if (!text.empty() && text.front() == '-') {
+            std::int64_t value = 0;
+            CheckParsed(std::from_chars(text.data(), text.data() + text.size(), value));
+            return static_cast<std::uint64_t>(value);
+        }
+
+        std::uint64_t value = 0;
+        CheckParsed(std::from_chars(text.data(), text.data() + text.size(), value));
+        return value;
+    }
+
+    double ParseReal(std::string_view text) {
+        bool isNegative = !text.empty() && text.front() == '-';
+        std::string_view digits = isNegative ? text.substr(1) : text;
+
+        // Syntax tree files keep doubles in hexfloat, which from_chars reads only without the prefix
+        double value = 0;
+        if (digits.size() > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+            CheckParsed(std::from_chars(digits.data() + 2, digits.data() + digits.size(), value, std::chars_format::hex));
+            return isNegative ? -value : value;
+        }
+
+        CheckParsed(std::from_chars(text.data(), text.data() + text.size(), value));
+        return value;
+    }
+}
+
 Lexeme::NumberType Lexeme::GetNumberType(LexemeType lexemeType) {
     if (lexemeType >= LexemeType::Byte && lexemeType <= LexemeType::Long) {
         return NumberType::Integer;
@@ -20,36 +61,30 @@ Lexeme::NumberType Lexeme::GetNumberType(LexemeType lexemeType) {
 }
 Lexeme::Lexeme() : Lexeme(0, 0, "", LexemeType::Error, DEFAULT_LEXEME_ERROR, true) {}
 
-Lexeme::Lexeme(int col, int row, std::string text, LexemeType lexemeType, const std::string& valueRepresentation, bool isError)
-    : myColumn(col), myRow(row), myText(std::move(text)), myType(lexemeType), isError(isError) {
+Lexeme::Lexeme(int col, int row, std::string_view text, LexemeType lexemeType, std::string_view valueRepresentation, bool isError)
+    : myColumn(col), myRow(row), myText(StringInterner::Intern(text)), myType(lexemeType), isError(isError) {
+
+    if (lexemeType == LexemeType::Keyword) {
+        myKeyword = Keywords::Find(text);
+    }
+
+    if (isError) {
+        myValue = StringInterner::Intern(valueRepresentation);
+        return;
+    }
 
     switch (GetNumberType(lexemeType)) {
         case NumberType::Integer:
-        case NumberType::UInteger: {
-            if (isError) {
-                myValue.emplace<std::pair<std::any, std::string>>(0ull, valueRepresentation);
-            } else {
-                myValue.emplace<std::uint64_t>(std::stoull(valueRepresentation));
-            }
-            
+        case NumberType::UInteger:
+            myValue = ParseInteger(valueRepresentation);
             break;
-        }
-            
-        case NumberType::Real:
-            if (isError) {
-                myValue.emplace<std::pair<std::any, std::string>>(0.0, valueRepresentation);
-            } else {
-                myValue.emplace<double>(std::stod(valueRepresentation));
-            }
-            
+        case NumberType::Real: {
+            double value = ParseReal(valueRepresentation);
+            std::memcpy(&myValue, &value, sizeof(value));
             break;
+        }
         default:
-            if (isError) {
-                myValue.emplace<std::pair<std::any, std::string>>(text, valueRepresentation);
-            } else {
-                myValue = valueRepresentation;
-            }
-            
+            myValue = (valueRepresentation == text ? myText : StringInterner::Intern(valueRepresentation));
             break;
     }
 }
@@ -68,7 +103,7 @@ int Lexeme::GetRow() const {
 }
 
 const std::string& Lexeme::GetText() const {
-    return myText;
+    return StringInterner::GetString(myText);
 }
 
 bool Lexeme::IsError() const {
@@ -79,6 +114,17 @@ Lexeme::LexemeType Lexeme::GetType() const {
     return myType;
 }
 
+SymbolId Lexeme::GetId() const {
+    if (isError || (myType != LexemeType::Identifier && myType != LexemeType::StringRef)) {
+        return StringInterner::EMPTY_ID;
+    }
+    return static_cast<SymbolId>(myValue);
+}
+
+Keyword Lexeme::GetKeyword() const {
+    return myKeyword;
+}
+
 std::string Lexeme::ToString() const {
     std::stringstream ss;
 
@@ -88,8 +134,9 @@ std::string Lexeme::ToString() const {
         ss << "\t";
     }
 
-    ss << myText << "\t";
-    if (myText.size() < 8) {
+    const std::string& text = GetText();
+    ss << text << "\t";
+    if (text.size() < 8) {
         ss << "\t";
     }
 
@@ -1,14 +1,20 @@
 #pragma once
 
-#include <any>
+#include "Keywords.h"
+#include "StringInterner.h"
+
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 class Lexeme {
 public:
     friend class Lexer;
 
-    enum class LexemeType : int {
+    enum class LexemeType : std::uint8_t {
         EndOfFile,
         Identifier,
         Keyword,
@@ -106,7 +112,7 @@ public:
     static NumberType GetNumberType(LexemeType lexemeType);
 
     Lexeme();
-    Lexeme(int col, int row, std::string text, LexemeType type, const std::string& valueRepresentation, bool isError = false);
+    Lexeme(int col, int row, std::string_view text, LexemeType type, std::string_view valueRepresentation, bool isError = false);
 
     int GetColumn() const;
     int GetRow() const;
@@ -115,14 +121,11 @@ public:
     bool IsError() const;
 
     template<typename T>
-    T GetValue() const {
-        if (isError) {
-            return std::any_cast<T>(std::any_cast<std::pair<std::any, std::string>>(myValue).first);
-        }
-        return std::any_cast<T>(myValue);
-    }
+    T GetValue() const;
 
     LexemeType GetType() const;
+    SymbolId GetId() const;
+    Keyword GetKeyword() const;
 
     std::string ToString() const;
 
@@ -133,18 +136,32 @@ private:
 
     int myColumn;
     int myRow;
-    std::string myText;
-    std::any myValue;
+    SymbolId myText;
     LexemeType myType;
+    Keyword myKeyword = Keyword::None;
     bool isError;
+    std::uint64_t myValue = 0;
 };
 
+static_assert(std::is_trivially_copyable_v<Lexeme> && sizeof(Lexeme) <= 24, "Lexeme must stay a compact POD token");
+
 template<>
-inline std::string Lexeme::GetValue() const {
-    if (isError) {
-        return std::any_cast<std::pair<std::any, std::string>>(myValue).second;
+inline std::uint64_t Lexeme::GetValue() const {
+    return isError ? 0 : myValue;
+}
+
+template<>
+inline double Lexeme::GetValue() const {
+    double value = 0;
+    if (!isError) {
+        std::memcpy(&value, &myValue, sizeof(value));
     }
-    return std::any_cast<std::string>(myValue);
+    return value;
+}
+
+template<>
+inline std::string Lexeme::GetValue() const {
+    return StringInterner::GetString(static_cast<SymbolId>(myValue));
 }
 
 std::ostream& operator<<(std::ostream& out, const Lexeme& lexeme);
@@ -1,6 +1,8 @@
 #include "Lexer.h"
 
-Lexer::Lexer(std::ifstream& input) : myInputBuffer(input.rdbuf()),
+#include <algorithm>
+
+Lexer::Lexer(std::ifstream& input) : myInputBuffer(input),
     myCurrentLexeme(0, 0, "", LexemeType::EndOfFile, Lexeme::DEFAULT_LEXEME_ERROR) {}
 
 Lexer::Lexer(const std::string& filepath) : myInputBuffer(filepath),
@@ -41,11 +43,11 @@ void Lexer::ProcessNextLexeme() {
     if (LexerUtils::IsDigit(curChars[0])) {
         if (curChars[0] == '0') {
             if (curChars[1] == 'x' || curChars[1] == 'X') {
-                ProcessPrefixNumber(&LexerUtils::IsHexChar);
+                ProcessPrefixNumber(LexerUtils::HexDigit);
                 return;
             }
             if (curChars[1] == 'b' || curChars[1] == 'B') {
-                ProcessPrefixNumber(&LexerUtils::IsBinChar);
+                ProcessPrefixNumber(LexerUtils::BinDigit);
                 return;
             }
         }
@@ -100,7 +102,7 @@ void Lexer::ProcessNextLexeme() {
         return;
     }
 
-    if (LexerUtils::IsAlphabetic(curChars[0]) || curChars[0] == '_') {
+    if (LexerUtils::HasClass(curChars[0], LexerUtils::Alphabetic | LexerUtils::Underscore)) {
         ProcessIdentifier();
         return;
     }
@@ -110,11 +112,11 @@ void Lexer::ProcessNextLexeme() {
         return;
     }
 
-    if (LexerUtils::OperationsCharset.count(curChars[0])) {
+    if (LexerUtils::HasClass(curChars[0], LexerUtils::Operation)) {
         ProcessOperation();
         return;
     }
-    if (LexerUtils::SpacingCharset.count(curChars[0])) {
+    if (LexerUtils::IsSpacing(curChars[0])) {
         ProcessWhitespaces();
         return;
     }
@@ -124,14 +126,16 @@ void Lexer::ProcessNextLexeme() {
 
 void Lexer::ProcessWhitespaces() {
     myLexemeType = LexemeType::Ignored;
-    while (myInputBuffer.GetChar() != BUFFER_EOF && LexerUtils::SpacingCharset.count(myInputBuffer.GetChar())) {
-        GetNextChar();
+    while (LexerUtils::IsSpacing(myInputBuffer.GetChar())) {
+        if (SkipRun(&LexerUtils::ScanBlanks) == 0) {
+            GetNextChar();
+        }
     }
 }
 
 void Lexer::ProcessComment() {
     myLexemeType = LexemeType::Ignored;
-    while (myInputBuffer.GetChar() != BUFFER_EOF && !LexerUtils::NewlineCharset.count(myInputBuffer.GetChar())) {
+    while (myInputBuffer.GetChar() != BUFFER_EOF && !LexerUtils::IsNewline(myInputBuffer.GetChar())) {
         AddNextChar();
     }
 }
@@ -151,7 +155,6 @@ void Lexer::ProcessMultilineComment() {
             nestedCnt--;
             AddNextChar(2);
             if (nestedCnt == 0) {
-                myLexemeText.clear();
                 return;
             }
         }
@@ -164,18 +167,16 @@ void Lexer::ProcessMultilineComment() {
 }
 
 void Lexer::ProcessIdentifier() {
-    while (LexerUtils::IsAlphabetic(myInputBuffer.GetChar()) || LexerUtils::IsDigit(myInputBuffer.GetChar()) || myInputBuffer.GetChar() == '_') {
-        AddNextChar();
-    }
+    SkipRun(&LexerUtils::ScanIdentifier);
 
     myLexemeValue = myLexemeText;
-    myLexemeType = LexerUtils::KeywordSet.count(myLexemeText) ? LexemeType::Keyword : LexemeType::Identifier;
+    myLexemeType = Keywords::Find(myLexemeText) != Keyword::None ? LexemeType::Keyword : LexemeType::Identifier;
 }
 
 void Lexer::ProcessEscapedIdentifier() {
     myLexemeType = LexemeType::Identifier;
     AddNextChar();
-    while (myInputBuffer.GetChar() != BUFFER_EOF && !LexerUtils::NewlineCharset.count(myInputBuffer.GetChar()) && myInputBuffer.GetChar() != '`') {
+    while (myInputBuffer.GetChar() != BUFFER_EOF && !LexerUtils::IsNewline(myInputBuffer.GetChar()) && myInputBuffer.GetChar() != '`') {
         AddNextChar();
     }
 
@@ -191,7 +192,7 @@ void Lexer::ProcessEscapedIdentifier() {
 void Lexer::ProcessNumber() {
     myLexemeType = LexemeType::Int;
 
-    if (myInputBuffer.GetChar() != '.' && !ProcessIntegerNumber(&LexerUtils::IsDigit)) {
+    if (myInputBuffer.GetChar() != '.' && !ProcessIntegerNumber(LexerUtils::Digit)) {
         MakeError("Illegal underscore");
         AddNextChar();
     }
@@ -200,14 +201,15 @@ void Lexer::ProcessNumber() {
         myLexemeType = LexemeType::Double;
 
         if (!LexerUtils::IsDigit(myInputBuffer.LookAhead(1))) {
-            myLexemeValue = myLexemeText;
-            myLexemeValue.erase(std::remove(myLexemeValue.begin(), myLexemeValue.end(), '_'), myLexemeValue.end());
+            myValueBuffer.assign(myLexemeText);
+            myValueBuffer.erase(std::remove(myValueBuffer.begin(), myValueBuffer.end(), '_'), myValueBuffer.end());
+            myLexemeValue = myValueBuffer;
             return;
         }
 
         AddNextChar();
 
-        if (!ProcessIntegerNumber(&LexerUtils::IsDigit)) {
+        if (!ProcessIntegerNumber(LexerUtils::Digit)) {
             MakeError("Illegal underscore");
             AddNextChar();
         }
@@ -222,7 +224,7 @@ void Lexer::ProcessNumber() {
         }
 
         if (LexerUtils::IsDigit(myInputBuffer.GetChar())) {
-            if (!ProcessIntegerNumber(&LexerUtils::IsDigit)) {
+            if (!ProcessIntegerNumber(LexerUtils::Digit)) {
                 MakeError("Illegal underscore");
                 AddNextChar();
             }
@@ -247,7 +249,7 @@ void Lexer::ProcessNumber() {
         myLexemeType = (myLexemeType == LexemeType::UInt ? LexemeType::ULong : LexemeType::Long);
     }
 
-    if (LexerUtils::IsAlphabetic(myInputBuffer.GetChar()) || LexerUtils::IsDigit(myInputBuffer.GetChar()) || myInputBuffer.GetChar() == '_') {
+    if (LexerUtils::HasClass(myInputBuffer.GetChar(), LexerUtils::IdentifierPart)) {
         ConsumeLexeme();
         MakeError("Illegal suffix");
     }
@@ -256,33 +258,33 @@ void Lexer::ProcessNumber() {
         return;
     }
 
-    myLexemeValue = myLexemeText;
-    myLexemeValue.erase(std::remove(myLexemeValue.begin(), myLexemeValue.end(), '_'), myLexemeValue.end());
+    myValueBuffer.assign(myLexemeText);
+    myValueBuffer.erase(std::remove(myValueBuffer.begin(), myValueBuffer.end(), '_'), myValueBuffer.end());
 
-    if ((myLexemeType == LexemeType::Double || myLexemeType == LexemeType::Float)) {
-        if (!LexerUtils::TryGetReal(myLexemeValue)) {
-            MakeError("The value is out of range");
-        }
-    } else if (!LexerUtils::TryGetInteger(myLexemeValue, myLexemeType)) {
+    bool isInRange = (myLexemeType == LexemeType::Double || myLexemeType == LexemeType::Float)
+        ? LexerUtils::TryGetReal(myValueBuffer)
+        : LexerUtils::TryGetInteger(myValueBuffer, myLexemeType);
+    myLexemeValue = myValueBuffer;
+    if (!isInRange) {
         MakeError("The value is out of range");
     }
 }
 
-bool Lexer::ProcessIntegerNumber(std::function<bool(int)> isNumber) {
-    if (!isNumber(myInputBuffer.GetChar())) {
+bool Lexer::ProcessIntegerNumber(std::uint16_t digitClass) {
+    if (!LexerUtils::HasClass(myInputBuffer.GetChar(), digitClass)) {
         return true;
     }
 
     AddNextChar();
     int len = 0;
 
-    while ((isNumber(myInputBuffer.GetChar()) || myInputBuffer.GetChar() == '_')
-           && (isNumber(myInputBuffer.LookAhead(1)) || myInputBuffer.LookAhead(1) == '_')) {
+    while ((LexerUtils::HasClass(myInputBuffer.GetChar(), digitClass) || myInputBuffer.GetChar() == '_')
+           && (LexerUtils::HasClass(myInputBuffer.LookAhead(1), digitClass) || myInputBuffer.LookAhead(1) == '_')) {
         len++;
         AddNextChar();
     }
 
-    if (!isNumber(myInputBuffer.GetChar())) {
+    if (!LexerUtils::HasClass(myInputBuffer.GetChar(), digitClass)) {
         return len == 0;
     }
 
@@ -290,11 +292,11 @@ bool Lexer::ProcessIntegerNumber(std::function<bool(int)> isNumber) {
     return true;
 }
 
-void Lexer::ProcessPrefixNumber(std::function<bool(int)> isNumber) {
+void Lexer::ProcessPrefixNumber(std::uint16_t digitClass) {
     myLexemeType = LexemeType::Int;
     AddNextChar(2);
 
-    bool isDigitEnd = ProcessIntegerNumber(isNumber);
+    bool isDigitEnd = ProcessIntegerNumber(digitClass);
 
     if (myInputBuffer.GetChar() == 'u' || myInputBuffer.GetChar() == 'U') {
         myLexemeType = LexemeType::UInt;
@@ -318,7 +320,7 @@ void Lexer::ProcessPrefixNumber(std::function<bool(int)> isNumber) {
         AddNextChar();
     }
 
-    if (LexerUtils::IsAlphabetic(myInputBuffer.GetChar()) || LexerUtils::IsDigit(myInputBuffer.GetChar()) || myInputBuffer.GetChar() == '_') {
+    if (LexerUtils::HasClass(myInputBuffer.GetChar(), LexerUtils::IdentifierPart)) {
         ConsumeLexeme();
         MakeError("Illegal suffix");
     }
@@ -327,9 +329,11 @@ void Lexer::ProcessPrefixNumber(std::function<bool(int)> isNumber) {
         return;
     }
 
-    myLexemeValue = myLexemeText.substr(2);
-    myLexemeValue.erase(std::remove(myLexemeValue.begin(), myLexemeValue.end(), '_'), myLexemeValue.end());
-    if (!LexerUtils::TryGetInteger(myLexemeValue, myLexemeType, isNumber('F') ? 16 : 2)) {
+    myValueBuffer.assign(myLexemeText.substr(2));
+    myValueBuffer.erase(std::remove(myValueBuffer.begin(), myValueBuffer.end(), '_'), myValueBuffer.end());
+    bool isInRange = LexerUtils::TryGetInteger(myValueBuffer, myLexemeType, digitClass == LexerUtils::HexDigit ? 16 : 2);
+    myLexemeValue = myValueBuffer;
+    if (!isInRange) {
         MakeError("The value is out of range");
     }
 }
@@ -341,17 +345,18 @@ void Lexer::ProcessChar() {
 
     if (myInputBuffer.GetChar() == '\\') {
         AddNextChar();
-        isValidEscape = LexerUtils::EscapeCharset.count(myInputBuffer.GetChar());
-        myLexemeValue.push_back(LexerUtils::EscapeToChar(myInputBuffer.GetChar()));
+        isValidEscape = LexerUtils::HasClass(myInputBuffer.GetChar(), LexerUtils::Escape);
+        myValueBuffer.push_back(LexerUtils::EscapeToChar(myInputBuffer.GetChar()));
     }
-    if (myInputBuffer.GetChar() == BUFFER_EOF || LexerUtils::NewlineCharset.count(myInputBuffer.GetChar())) {
+    if (myInputBuffer.GetChar() == BUFFER_EOF || LexerUtils::IsNewline(myInputBuffer.GetChar())) {
         MakeError("Incorrect character literal");
         return;
     }
 
-    if (myLexemeValue.empty()) {
-        myLexemeValue.push_back(myInputBuffer.GetChar());
+    if (myValueBuffer.empty()) {
+        myValueBuffer.push_back(myInputBuffer.GetChar());
     }
+    myLexemeValue = myValueBuffer;
 
     AddNextChar();
 
@@ -365,7 +370,7 @@ void Lexer::ProcessChar() {
         return;
     }
 
-    while (myInputBuffer.GetChar() != BUFFER_EOF && !LexerUtils::SpacingCharset.count(myInputBuffer.GetChar()) && myInputBuffer.GetChar() != '\'') {
+    while (myInputBuffer.GetChar() != BUFFER_EOF && !LexerUtils::IsSpacing(myInputBuffer.GetChar()) && myInputBuffer.GetChar() != '\'') {
         AddNextChar();
     }
 
@@ -387,28 +392,29 @@ void Lexer::ProcessString() {
 
     AddNextChar();
     bool isValidEscape = true;
-    while (myInputBuffer.GetChar() != BUFFER_EOF && !LexerUtils::NewlineCharset.count(myInputBuffer.GetChar()) && myInputBuffer.GetChar() != '\"') {
+    while (myInputBuffer.GetChar() != BUFFER_EOF && !LexerUtils::IsNewline(myInputBuffer.GetChar()) && myInputBuffer.GetChar() != '\"') {
         if (myInputBuffer.GetChar() == '$') {
             ProcessStringTemplate(LexemeType::String);
             continue;
         }
 
         if (myInputBuffer.GetChar() == '\\') {
-            if (myInputBuffer.LookAhead(1) == BUFFER_EOF || !LexerUtils::EscapeCharset.count(myInputBuffer.LookAhead(1))) {
+            if (myInputBuffer.LookAhead(1) == BUFFER_EOF || !LexerUtils::HasClass(myInputBuffer.LookAhead(1), LexerUtils::Escape)) {
                 isValidEscape = false;
             }
 
             AddNextChar();
-            myLexemeValue.push_back(LexerUtils::EscapeToChar(myInputBuffer.GetChar()));
+            myValueBuffer.push_back(LexerUtils::EscapeToChar(myInputBuffer.GetChar()));
             AddNextChar();
             continue;
         }
 
-        myLexemeValue.push_back(myInputBuffer.GetChar());
+        myValueBuffer.push_back(myInputBuffer.GetChar());
         AddNextChar();
     }
 
     myLexemeType = LexemeType::String;
+    myLexemeValue = myValueBuffer;
 
     if (myInputBuffer.GetChar() == '\"') {
         AddNextChar();
@@ -433,17 +439,18 @@ void Lexer::ProcessRawString() {
     AddNextChar(3);
 
     while (!(myInputBuffer.GetChar() == BUFFER_EOF
-             || myInputBuffer.GetChar() == '\"' && myInputBuffer.LookAhead(1) == '\"' && myInputBuffer.LookAhead(2) == '\"'
-             && myInputBuffer.LookAhead(3) != '\"')) {
+             || (myInputBuffer.GetChar() == '\"' && myInputBuffer.LookAhead(1) == '\"' && myInputBuffer.LookAhead(2) == '\"'
+                 && myInputBuffer.LookAhead(3) != '\"'))) {
         if (myInputBuffer.GetChar() == '$') {
             ProcessStringTemplate(LexemeType::RawString);
             continue;
         }
 
-        myLexemeValue.push_back(myInputBuffer.GetChar());
+        myValueBuffer.push_back(myInputBuffer.GetChar());
         AddNextChar();
     }
 
+    myLexemeValue = myValueBuffer;
     if (myInputBuffer.GetChar() == BUFFER_EOF) {
         MakeError("Expecting '\"'");
     } else {
@@ -455,7 +462,7 @@ void Lexer::ProcessRawString() {
 
 bool Lexer::ProcessStringTemplate(LexemeType stringType) {
     if (myInputBuffer.LookAhead(1) == '{' || LexerUtils::IsAlphabetic(myInputBuffer.LookAhead(1)) || myInputBuffer.LookAhead(1) == '_') {
-        myLexemeBuffer.emplace_back(myStartCol, myStartRow, myLexemeText, stringType, myLexemeValue);
+        myLexemeBuffer.emplace_back(myStartCol, myStartRow, myLexemeText, stringType, myValueBuffer);
         ResetLexeme();
 
         if (myInputBuffer.LookAhead(1) == '{') {
@@ -481,7 +488,6 @@ void Lexer::ReturnCurrentStringLexeme(bool unlockString) {
     if (unlockString) {
         isInString = false;
     } else if (isInString) {
-        myLexemeText.clear();
         myLexemeType = LexemeType::Ignored;
         return;
     }
@@ -490,7 +496,7 @@ void Lexer::ReturnCurrentStringLexeme(bool unlockString) {
     myStartCol = frontLexeme.GetColumn();
     myStartRow = frontLexeme.GetRow();
     myLexemeText = frontLexeme.GetText();
-    myLexemeValue = frontLexeme.GetValue<std::string>();
+    myLexemeValue = StringInterner::GetString(static_cast<SymbolId>(frontLexeme.myValue));
     myLexemeType = frontLexeme.GetType();
     myLexemeBuffer.pop_front();
 }
@@ -509,27 +515,30 @@ void Lexer::ProcessStrExpression() {
 }
 
 void Lexer::ProcessOperation() {
-    std::string operation;
+    int state = 0;
+    int acceptedState = 0;
+    int acceptedLength = 0;
     for (int i = 0; i < 3; i++) {
         int curChar = myInputBuffer.LookAhead(i);
-        if (curChar == BUFFER_EOF) {
+        if (static_cast<unsigned>(curChar) >= 128) {
             break;
         }
-        operation.push_back(myInputBuffer.LookAhead(i));
-    }
-
-    while (!operation.empty()) {
-        if (LexerUtils::OperationsSets[operation.size() - 1].count(operation)) {
-            for (auto c : operation) {
-                AddNextChar();
-            }
 
-            myLexemeType = LexerUtils::OperationsSets[operation.size() - 1].at(operation);
-            myLexemeValue = myLexemeText;
-            return;
+        state = LexerUtils::OperatorStates[state].myNext[curChar];
+        if (state == 0) {
+            break;
+        }
+        if (LexerUtils::OperatorStates[state].isAccepting) {
+            acceptedState = state;
+            acceptedLength = i + 1;
         }
+    }
 
-        operation.pop_back();
+    if (acceptedLength != 0) {
+        AddNextChar(acceptedLength);
+        myLexemeType = LexerUtils::OperatorStates[acceptedState].myType;
+        myLexemeValue = myLexemeText;
+        return;
     }
 
     AddNextChar();
@@ -544,8 +553,8 @@ void Lexer::ProcessUnknown() {
 }
 
 void Lexer::ConsumeLexeme() {
-    while (!LexerUtils::SpacingCharset.count(myInputBuffer.GetChar())
-           && !LexerUtils::OperationsCharset.count(myInputBuffer.GetChar())
+    while (!LexerUtils::IsSpacing(myInputBuffer.GetChar())
+           && !LexerUtils::HasClass(myInputBuffer.GetChar(), LexerUtils::Operation)
            && myInputBuffer.GetChar() != BUFFER_EOF) {
         AddNextChar();
     }
@@ -555,7 +564,7 @@ int Lexer::GetNextChar() {
     int character = myInputBuffer.NextChar();
     if (character != BUFFER_EOF) {
         myCol++;
-        if (LexerUtils::NewlineCharset.count(character)) {
+        if (LexerUtils::IsNewline(character)) {
             myRow++;
             myCol = 0;
         }
@@ -564,21 +573,33 @@ int Lexer::GetNextChar() {
     return character;
 }
 
+std::size_t Lexer::SkipRun(std::size_t (*scanner)(const char*, const char*)) {
+    std::string_view rest = myInputBuffer.GetRemaining();
+    std::size_t length = scanner(rest.data(), rest.data() + rest.size());
+    myInputBuffer.Skip(length);
+    myCol += length;
+    myLexemeText = myInputBuffer.GetText(myStartOffset, myInputBuffer.GetOffset());
+    return length;
+}
+
 void Lexer::AddNextChar(int cnt) {
     for (int i = 0; i < cnt; i++) {
-        myLexemeText.push_back(GetNextChar());
+        GetNextChar();
     }
+    myLexemeText = myInputBuffer.GetText(myStartOffset, myInputBuffer.GetOffset());
 }
 
 void Lexer::ResetLexeme() {
     myStartCol = myCol;
     myStartRow = myRow;
-    myLexemeText.clear();
-    myLexemeValue.clear();
+    myStartOffset = myInputBuffer.GetOffset();
+    myLexemeText = {};
+    myLexemeValue = {};
+    myValueBuffer.clear();
     isError = false;
 }
 
-void Lexer::MakeError(const std::string& errorMessage) {
+void Lexer::MakeError(std::string_view errorMessage) {
     isError = true;
     myLexemeValue = errorMessage;
 }
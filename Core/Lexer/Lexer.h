@@ -1,11 +1,11 @@
 #pragma once
 
 #include "LexerUtils.h"
-#include "../InputBuffer.h"
+#include "../MappedInputBuffer.h"
 
-#include <functional>
 #include <queue>
 #include <string>
+#include <string_view>
 
 class Lexer {
 public:
@@ -31,8 +31,8 @@ private:
     void ProcessEscapedIdentifier();
 
     void ProcessNumber();
-    bool ProcessIntegerNumber(std::function<bool(int)> isNumber);
-    void ProcessPrefixNumber(std::function<bool(int)> isNumber);
+    bool ProcessIntegerNumber(std::uint16_t digitClass);
+    void ProcessPrefixNumber(std::uint16_t digitClass);
 
     void ProcessChar();
 
@@ -48,26 +48,30 @@ private:
     void ConsumeLexeme();
 
     int GetNextChar();
+    std::size_t SkipRun(std::size_t (*scanner)(const char*, const char*));
     void AddNextChar(int cnt = 1);
 
     void ResetLexeme();
 
-    void MakeError(const std::string& errorMessage);
+    void MakeError(std::string_view errorMessage);
          
     std::size_t myCol = 0;
     std::size_t myRow = 0;
 
     std::size_t myStartCol = 0;
     std::size_t myStartRow = 0;
+    std::size_t myStartOffset = 0;
 
-    InputBuffer<std::ifstream> myInputBuffer;
+    MappedInputBuffer myInputBuffer;
     std::deque<Lexeme> myLexemeBuffer;
 
     Lexeme myCurrentLexeme;
     Lexeme myPreviousLexeme = Lexeme(-1, -1, "", Lexeme::LexemeType::EndOfFile, "", true);
 
-    std::string myLexemeText;
-    std::string myLexemeValue;
+    // Views into the mapped source, or into myValueBuffer for literals whose value differs from their text
+    std::string_view myLexemeText;
+    std::string_view myLexemeValue;
+    std::string myValueBuffer;
 
     LexemeType myLexemeType = LexemeType::Error;
     bool isError = false;
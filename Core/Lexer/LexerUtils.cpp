@@ -3,26 +3,112 @@
 #include <iomanip>
 #include <sstream>
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86_FP) && _M_IX86_FP >= 2
+#define LEXER_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 using LexemeType = LexemeType;
 
-const std::unordered_set<char> LexerUtils::OperationsCharset { '+', '-', '*', '/', '=', '>', '<', '.',
-        ',', ';', ':', '@', '$', '?', '!', '#', '|', '&', '%', '(', ')', '[', ']', '{', '}', '\"', '\'' };
+namespace {
+    std::array<std::uint16_t, 256> BuildCharClasses() {
+        std::array<std::uint16_t, 256> classes{};
+        for (int character = '0'; character <= '9'; character++) {
+            classes[character] |= LexerUtils::Digit | LexerUtils::HexDigit;
+        }
+        classes['0'] |= LexerUtils::BinDigit;
+        classes['1'] |= LexerUtils::BinDigit;
+        for (int character = 'a'; character <= 'z'; character++) {
+            classes[character] |= LexerUtils::Alphabetic;
+            classes[character - 'a' + 'A'] |= LexerUtils::Alphabetic;
+        }
+        for (int character = 'a'; character <= 'f'; character++) {
+            classes[character] |= LexerUtils::HexDigit;
+            classes[character - 'a' + 'A'] |= LexerUtils::HexDigit;
+        }
+        classes['_'] |= LexerUtils::Underscore;
 
-const std::unordered_set<char> LexerUtils::SpacingCharset { ' ', '\t', '\r', '\n' };
+        for (unsigned char character : std::string(" \t\r\n")) {
+            classes[character] |= LexerUtils::Spacing;
+        }
+        for (unsigned char character : std::string("\r\n")) {
+            classes[character] |= LexerUtils::Newline;
+        }
+        for (unsigned char character : std::string("+-*/=><.,;:@$?!#|&%()[]{}\"\'")) {
+            classes[character] |= LexerUtils::Operation;
+        }
+        for (unsigned char character : std::string("tbrn\'\"\\$")) {
+            classes[character] |= LexerUtils::Escape;
+        }
 
-const std::unordered_set<char> LexerUtils::NewlineCharset { '\n', '\r' };
+        return classes;
+    }
 
-const std::unordered_set<char> LexerUtils::EscapeCharset{ 't', 'b', 'r', 'n', '\'', '\"', '\\', '$' };
+    std::vector<OperatorState> BuildOperatorStates() {
+        std::vector<OperatorState> states(1, OperatorState{ {}, LexemeType::Error, false });
+        for (auto& operations : LexerUtils::OperationsSets) {
+            for (auto& [operation, type] : operations) {
+                int state = 0;
+                for (unsigned char character : operation) {
+                    if (states[state].myNext[character] == 0) {
+                        states[state].myNext[character] = static_cast<std::int16_t>(states.size());
+                        states.push_back(OperatorState{ {}, LexemeType::Error, false });
+                    }
+                    state = states[state].myNext[character];
+                }
+                states[state].myType = type;
+                states[state].isAccepting = true;
+            }
+        }
 
-const std::unordered_set<std::string> LexerUtils::KeywordSet {
-        "return", "continue", "break", "this", "super", "file", "field", "property", "get", "set", "receiver",
-        "param", "setparam", "delegate", "package", "import", "class", "interface", "fun", "object", "val", "var",
-        "typealias", "constructor", "by", "companion", "init", "typeof", "where", "if", "else", "when", "try",
-        "catch", "finally", "for", "do", "while", "throw", "as", "is", "in", "out", "dynamic", "public", "private",
-        "protected", "internal", "enum", "sealed", "annotation", "data", "inner", "tailrec", "operator", "inline",
-        "infix", "external", "suspend", "override", "abstract", "final", "open", "const", "lateinit", "vararg",
-        "noinline", "crossinline", "reified", "expect", "actual", "true", "false", "null"
-};
+        return states;
+    }
+
+#ifdef LEXER_SSE2
+    int CountTrailingZeros(unsigned mask) {
+#ifdef _MSC_VER
+        unsigned long idx;
+        _BitScanForward(&idx, mask);
+        return static_cast<int>(idx);
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+    std::size_t ScanChunks(const char*& current, const char* end, __m128i (*classify)(__m128i)) {
+        while (end - current >= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(classify(chunk)));
+            if (mask != 0xFFFF) {
+                return CountTrailingZeros(~mask);
+            }
+            current += 16;
+        }
+
+        return 16;
+    }
+
+    __m128i InRange(__m128i chunk, char low, char high) {
+        return _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(low - 1)), _mm_cmplt_epi8(chunk, _mm_set1_epi8(high + 1)));
+    }
+
+    __m128i ClassifyIdentifier(__m128i chunk) {
+        __m128i isLetter = InRange(_mm_or_si128(chunk, _mm_set1_epi8(0x20)), 'a', 'z');
+        __m128i isDigit = InRange(chunk, '0', '9');
+        __m128i isUnderscore = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_'));
+        return _mm_or_si128(_mm_or_si128(isLetter, isDigit), isUnderscore);
+    }
+
+    __m128i ClassifyBlank(__m128i chunk) {
+        return _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\t')));
+    }
+#endif
+}
+
+const std::array<std::uint16_t, 256> LexerUtils::CharClasses = BuildCharClasses();
 
 const std::unordered_map<std::string, LexemeType> LexerUtils::OperationsSets[3]{
     {
@@ -44,6 +130,8 @@ const std::unordered_map<std::string, LexemeType> LexerUtils::OperationsSets[3]{
     }
 };
 
+const std::vector<OperatorState> LexerUtils::OperatorStates = BuildOperatorStates();
+
 #define MAX_I(Type) std::numeric_limits<Type>::max()
 
 const std::uint64_t LexerUtils::IntegersLimits[]{
@@ -52,19 +140,55 @@ const std::uint64_t LexerUtils::IntegersLimits[]{
 };
 
 bool LexerUtils::IsDigit(int character) {
-    return character >= '0' && character <= '9';
+    return HasClass(character, Digit);
 }
 
 bool LexerUtils::IsBinChar(int character) {
-    return character == '0' || character == '1';
+    return HasClass(character, BinDigit);
 }
 
 bool LexerUtils::IsHexChar(int character) {
-    return IsDigit(character) || (character >= 'a' && character <= 'f') || (character >= 'A' && character <= 'F');
+    return HasClass(character, HexDigit);
 }
 
 bool LexerUtils::IsAlphabetic(int character) {
-    return character >= 'a' && character <= 'z' || character >= 'A' && character <= 'Z';
+    return HasClass(character, Alphabetic);
+}
+
+bool LexerUtils::IsSpacing(int character) {
+    return HasClass(character, Spacing);
+}
+
+bool LexerUtils::IsNewline(int character) {
+    return HasClass(character, Newline);
+}
+
+std::size_t LexerUtils::ScanIdentifier(const char* begin, const char* end) {
+    const char* current = begin;
+#ifdef LEXER_SSE2
+    std::size_t length = ScanChunks(current, end, &ClassifyIdentifier);
+    if (length < 16) {
+        return current - begin + length;
+    }
+#endif
+    while (current != end && HasClass(*current, IdentifierPart)) {
+        current++;
+    }
+    return current - begin;
+}
+
+std::size_t LexerUtils::ScanBlanks(const char* begin, const char* end) {
+    const char* current = begin;
+#ifdef LEXER_SSE2
+    std::size_t length = ScanChunks(current, end, &ClassifyBlank);
+    if (length < 16) {
+        return current - begin + length;
+    }
+#endif
+    while (current != end && (*current == ' ' || *current == '\t')) {
+        current++;
+    }
+    return current - begin;
 }
 
 bool LexerUtils::TryGetReal(std::string& floatStr) {
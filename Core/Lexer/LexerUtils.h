@@ -2,25 +2,47 @@
 
 #include "Lexeme.h"
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 using LexemeType = Lexeme::LexemeType;
 
+struct OperatorState {
+    std::int16_t myNext[128];
+    LexemeType myType;
+    bool isAccepting;
+};
+
 class LexerUtils {
 public:
-    static const std::unordered_set<char> OperationsCharset;
-    static const std::unordered_set<char> SpacingCharset;
-    static const std::unordered_set<char> NewlineCharset;
-
-    static const std::unordered_set<char> EscapeCharset;
+    enum CharClass : std::uint16_t {
+        Digit = 1 << 0,
+        BinDigit = 1 << 1,
+        HexDigit = 1 << 2,
+        Alphabetic = 1 << 3,
+        Underscore = 1 << 4,
+        Spacing = 1 << 5,
+        Newline = 1 << 6,
+        Operation = 1 << 7,
+        Escape = 1 << 8,
+
+        IdentifierPart = Digit | Alphabetic | Underscore,
+    };
+
+    static const std::array<std::uint16_t, 256> CharClasses;
 
-    static const std::unordered_set<std::string> KeywordSet;
     static const std::unordered_map<std::string, LexemeType> OperationsSets[3];
+    static const std::vector<OperatorState> OperatorStates;
 
     static const std::uint64_t IntegersLimits[];
 
+    static bool HasClass(int character, std::uint16_t charClass) {
+        return static_cast<unsigned>(character) < CharClasses.size() && (CharClasses[character] & charClass) != 0;
+    }
+
     static bool IsDigit(int character);
 
     static bool IsBinChar(int character);
@@ -29,6 +51,12 @@ public:
 
     static bool IsAlphabetic(int character);
 
+    static bool IsSpacing(int character);
+    static bool IsNewline(int character);
+
+    static std::size_t ScanIdentifier(const char* begin, const char* end);
+    static std::size_t ScanBlanks(const char* begin, const char* end);
+
     static bool TryGetReal(std::string& floatStr);
     static bool TryGetInteger(std::string& intStr, LexemeType& initialType, int base = 10);
 
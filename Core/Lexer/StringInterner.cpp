@@ -0,0 +1,93 @@
+#include "StringInterner.h"
+
+#include <stdexcept>
+
+StringInterner::StringInterner() {
+    InnerIntern(std::string_view());
+}
+
+StringInterner& StringInterner::GetInstance() {
+    static StringInterner instance;
+    return instance;
+}
+
+SymbolId StringInterner::Intern(std::string_view text) {
+    // Most lookups hit names the current thread has already seen, so they never touch the shared lock
+    thread_local std::unordered_map<std::string_view, SymbolId> cache;
+    thread_local std::uint32_t generation = 0;
+    std::uint32_t currentGeneration = GetInstance().myGeneration.load(std::memory_order_acquire);
+    if (generation != currentGeneration) {
+        cache.clear();
+        generation = currentGeneration;
+    }
+
+    auto cached = cache.find(text);
+    if (cached != cache.end()) {
+        return cached->second;
+    }
+
+    SymbolId id = GetInstance().InnerIntern(text);
+    cache.emplace(GetString(id), id);
+    return id;
+}
+
+const std::string& StringInterner::GetString(SymbolId id) {
+    std::string* chunk = GetInstance().myChunks[id >> CHUNK_BITS].load(std::memory_order_acquire);
+    if (chunk == nullptr) {
+        throw std::out_of_range("Unknown string id");
+    }
+    return chunk[id & (CHUNK_SIZE - 1)];
+}
+
+SymbolId StringInterner::InnerIntern(std::string_view text) {
+    std::lock_guard<std::mutex> lock(myMutex);
+
+    auto it = myIds.find(text);
+    if (it != myIds.end()) {
+        return it->second;
+    }
+
+    SymbolId id = mySize;
+    std::size_t chunkIdx = id >> CHUNK_BITS;
+    if (chunkIdx >= MAX_CHUNKS) {
+        throw std::length_error("Too many interned strings");
+    }
+    if (chunkIdx == myOwnedChunks.size()) {
+        myOwnedChunks.push_back(std::make_unique<std::string[]>(CHUNK_SIZE));
+    }
+
+    std::string& stored = myOwnedChunks[chunkIdx][id & (CHUNK_SIZE - 1)];
+    stored.assign(text.data(), text.size());
+    // Publishing the chunk after the string is written lets readers skip the lock
+    myChunks[chunkIdx].store(myOwnedChunks[chunkIdx].get(), std::memory_order_release);
+    myIds.emplace(stored, id);
+    mySize++;
+    return id;
+}
+
+SymbolId StringInterner::GetSize() {
+    std::lock_guard<std::mutex> lock(myMutex);
+    return mySize;
+}
+
+void StringInterner::Truncate(SymbolId size) {
+    std::lock_guard<std::mutex> lock(myMutex);
+    if (size >= mySize) {
+        return;
+    }
+
+    for (SymbolId id = size; id < mySize; id++) {
+        std::string& stored = myOwnedChunks[id >> CHUNK_BITS][id & (CHUNK_SIZE - 1)];
+        myIds.erase(stored);
+        std::string().swap(stored);
+    }
+    mySize = size;
+    // Thread caches may still map the dropped strings to their ids
+    myGeneration.fetch_add(1, std::memory_order_release);
+}
+
+StringInterner::Scope::Scope() : myMark(GetInstance().GetSize()) {}
+
+StringInterner::Scope::~Scope() {
+    GetInstance().Truncate(myMark);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using SymbolId = std::uint32_t;
+
+// Process-wide, thread-safe string pool. Interned strings are never moved, so reading one back needs no lock
+class StringInterner {
+public:
+    static constexpr SymbolId EMPTY_ID = 0;
+
+    static SymbolId Intern(std::string_view text);
+    static const std::string& GetString(SymbolId id);
+
+    // Strings interned while a scope is alive are dropped when it ends, so a long-running process doesn't keep
+    // the names and literals of every source it has seen. Ids from inside the scope must not outlive it, and no
+    // other thread may intern meanwhile
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        SymbolId myMark;
+    };
+
+private:
+    static constexpr std::size_t CHUNK_BITS = 12;
+    static constexpr std::size_t CHUNK_SIZE = std::size_t(1) << CHUNK_BITS;
+    static constexpr std::size_t MAX_CHUNKS = std::size_t(1) << 16;
+
+    StringInterner();
+
+    static StringInterner& GetInstance();
+
+    SymbolId InnerIntern(std::string_view text);
+    SymbolId GetSize();
+    void Truncate(SymbolId size);
+
+    std::mutex myMutex;
+    std::vector<std::unique_ptr<std::string[]>> myOwnedChunks;
+    std::array<std::atomic<std::string*>, MAX_CHUNKS> myChunks {};
+    SymbolId mySize = 0;
+    std::atomic<std::uint32_t> myGeneration { 0 };
+    std::unordered_map<std::string_view, SymbolId> myIds;
+};
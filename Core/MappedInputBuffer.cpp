@@ -0,0 +1,118 @@
+#include "MappedInputBuffer.h"
+
+#include <iterator>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedInputBuffer::MappedInputBuffer(const std::string& filepath) {
+    Map(filepath);
+}
+
+MappedInputBuffer::MappedInputBuffer(std::istream& input)
+    : myOwnedText(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()) {
+    myBegin = myOwnedText.data();
+    myCurrent = myBegin;
+    myEnd = myBegin + myOwnedText.size();
+}
+
+MappedInputBuffer::MappedInputBuffer(MappedInputBuffer&& other) noexcept
+    : myOwnedText(std::move(other.myOwnedText)), isMapped(other.isMapped) {
+    if (isMapped) {
+        myBegin = other.myBegin;
+        myCurrent = other.myCurrent;
+        myEnd = other.myEnd;
+    } else {
+        myBegin = myOwnedText.data();
+        myCurrent = myBegin + (other.myCurrent - other.myBegin);
+        myEnd = myBegin + myOwnedText.size();
+    }
+
+    other.myBegin = other.myCurrent = other.myEnd = nullptr;
+    other.isMapped = false;
+}
+
+MappedInputBuffer::~MappedInputBuffer() {
+    Unmap();
+}
+
+std::size_t MappedInputBuffer::GetOffset() const {
+    return myCurrent - myBegin;
+}
+
+std::string_view MappedInputBuffer::GetText(std::size_t begin, std::size_t end) const {
+    return std::string_view(myBegin + begin, end - begin);
+}
+
+std::string_view MappedInputBuffer::GetRemaining() const {
+    return std::string_view(myCurrent, myEnd - myCurrent);
+}
+
+void MappedInputBuffer::Skip(std::size_t count) {
+    myCurrent += count;
+}
+
+#ifdef _WIN32
+void MappedInputBuffer::Map(const std::string& filepath) {
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (view != nullptr) {
+                myBegin = static_cast<const char*>(view);
+                myEnd = myBegin + size.QuadPart;
+                isMapped = true;
+            }
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+    myCurrent = myBegin;
+}
+
+void MappedInputBuffer::Unmap() {
+    if (isMapped) {
+        UnmapViewOfFile(myBegin);
+        isMapped = false;
+    }
+}
+#else
+void MappedInputBuffer::Map(const std::string& filepath) {
+    int file = open(filepath.c_str(), O_RDONLY);
+    if (file == -1) {
+        return;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) == 0 && info.st_size > 0) {
+        void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (view != MAP_FAILED) {
+            madvise(view, info.st_size, MADV_SEQUENTIAL);
+            myBegin = static_cast<const char*>(view);
+            myEnd = myBegin + info.st_size;
+            isMapped = true;
+        }
+    }
+    close(file);
+    myCurrent = myBegin;
+}
+
+void MappedInputBuffer::Unmap() {
+    if (isMapped) {
+        munmap(const_cast<char*>(myBegin), myEnd - myBegin);
+        isMapped = false;
+    }
+}
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "InputBuffer.h"
+
+#include <istream>
+#include <string>
+#include <string_view>
+
+class MappedInputBuffer {
+public:
+    explicit MappedInputBuffer(const std::string& filepath);
+    explicit MappedInputBuffer(std::istream& input);
+
+    MappedInputBuffer(MappedInputBuffer&& other) noexcept;
+    MappedInputBuffer(const MappedInputBuffer&) = delete;
+    MappedInputBuffer& operator=(const MappedInputBuffer&) = delete;
+    MappedInputBuffer& operator=(MappedInputBuffer&&) = delete;
+
+    ~MappedInputBuffer();
+
+    int NextChar() {
+        if (myCurrent >= myEnd) {
+            return BUFFER_EOF;
+        }
+        return *myCurrent++;
+    }
+
+    int LookAhead(std::size_t offset) const {
+        if (offset >= static_cast<std::size_t>(myEnd - myCurrent)) {
+            return BUFFER_EOF;
+        }
+        return myCurrent[offset];
+    }
+
+    int GetChar() const {
+        if (myCurrent >= myEnd) {
+            return BUFFER_EOF;
+        }
+        return *myCurrent;
+    }
+
+    std::size_t GetOffset() const;
+    std::string_view GetText(std::size_t begin, std::size_t end) const;
+    std::string_view GetRemaining() const;
+    void Skip(std::size_t count);
+
+private:
+    void Map(const std::string& filepath);
+    void Unmap();
+
+    std::string myOwnedText;
+
+    const char* myBegin = nullptr;
+    const char* myCurrent = nullptr;
+    const char* myEnd = nullptr;
+    bool isMapped = false;
+};
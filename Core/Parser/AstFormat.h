@@ -0,0 +1,128 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+
+// Layout of the binary syntax tree files. Every section is an array of fixed-size records of 32-bit fields,
+// so a mapped file can be read in place. Nodes are stored in preorder, children always follow their parent.
+namespace AstFormat {
+    const char MAGIC[] = "KAST";
+    const int32_t VERSION = 1;
+    const char FILE_EXTENSION[] = ".kast";
+
+    enum class NodeKind : int32_t {
+        Identifier,
+        Integer,
+        Double,
+        Boolean,
+        String,
+        Type,
+        Break,
+        Continue,
+        Return,
+        EmptyStatement,
+        Assignment,
+        While,
+        DoWhile,
+        For,
+        BinOperation,
+        UnaryPrefixOperation,
+        UnaryPostfixOperation,
+        CallArguments,
+        TypeArguments,
+        IndexSuffix,
+        CallSuffix,
+        MemberAccess,
+        If,
+        Block,
+        DeclarationBlock,
+        ClassDeclaration,
+        Parameter,
+        Variable,
+        ParameterList,
+        FunctionDeclaration,
+        PropertyDeclaration,
+    };
+
+    // Symbols declared by the program are stored in full, built-in ones are looked up again when loading
+    enum class SymbolKind : int32_t {
+        Unresolved,
+        Unit,
+        Boolean,
+        Integer,
+        Double,
+        String,
+        Array,
+        Range,
+        BuiltinFunction,
+        Class,
+        Function,
+        Variable,
+    };
+
+    struct Header {
+        char myMagic[4];
+        int32_t myVersion;
+        int32_t myNodesOffset;
+        int32_t myNodesCount;
+        int32_t myChildrenOffset;
+        int32_t myChildrenCount;
+        int32_t mySymbolsOffset;
+        int32_t mySymbolsCount;
+        int32_t myReferencesOffset;
+        int32_t myReferencesCount;
+        int32_t myTablesOffset;
+        int32_t myTablesCount;
+        int32_t myStringsOffset;
+        int32_t myStringsCount;
+    };
+
+    // Numbers are kept in their text form so that the lexeme can be rebuilt by its usual constructor
+    struct LexemeRecord {
+        int32_t myColumn;
+        int32_t myRow;
+        int32_t myType;
+        int32_t isError;
+        int32_t myText;
+        int32_t myValue;
+    };
+
+    struct NodeRecord {
+        NodeKind myKind;
+        int32_t mySymbol;
+        int32_t myFirstChild;
+        int32_t myChildrenCount;
+        int32_t myDepth;
+        int32_t myFrameSize;
+        LexemeRecord myLexeme;
+    };
+
+    struct SymbolRecord {
+        SymbolKind myKind;
+        int32_t myName;
+        int32_t myTable;
+        int32_t myType;
+        int32_t myOwner;
+        int32_t myFirstParameter;
+        int32_t myParametersCount;
+        int32_t myOwnTable;
+        int32_t myDeclaration;
+        int32_t isMutable;
+        int32_t myDepth;
+        int32_t myOffset;
+    };
+
+    // Table 0 is the unit's own table; tables of classes and functions are owned by their symbol, others are blocks
+    struct TableRecord {
+        int32_t myParent;
+        int32_t myOwner;
+    };
+
+    // Strings are stored as an array of (offset, size) pairs relative to the start of the strings section
+    struct StringRecord {
+        int32_t myOffset;
+        int32_t mySize;
+    };
+
+    static_assert(std::is_trivially_copyable_v<NodeRecord> && sizeof(NodeRecord) == 48, "Node records must stay flat");
+    static_assert(std::is_trivially_copyable_v<SymbolRecord> && sizeof(SymbolRecord) == 48, "Symbol records must stay flat");
+}
@@ -0,0 +1,470 @@
+#include "AstReader.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "ExpressionNodes.h"
+#include "StatementNodes.h"
+#include "Semantics/ClassSymbol.h"
+#include "Semantics/FunctionSymbol.h"
+#include "Semantics/FundamentalType.h"
+
+using namespace AstFormat;
+
+AstReader::AstReader(const std::string& filepath, SymbolTable* symbolTable)
+    : myInput(filepath), myData(myInput.GetRemaining()), myHeader(), myTable(symbolTable) {}
+
+Pointer<DeclarationBlock> AstReader::Read() {
+    if (myData.size() < sizeof(Header)) {
+        throw std::invalid_argument("Not a syntax tree file");
+    }
+
+    std::memcpy(&myHeader, myData.data(), sizeof(Header));
+    if (std::memcmp(myHeader.myMagic, MAGIC, sizeof(myHeader.myMagic)) != 0) {
+        throw std::invalid_argument("Not a syntax tree file");
+    }
+    if (myHeader.myVersion != VERSION) {
+        throw std::invalid_argument("Syntax tree file of unsupported version " + std::to_string(myHeader.myVersion));
+    }
+
+    std::pair<int32_t, int64_t> sections[] = {
+        { myHeader.myNodesOffset, int64_t(myHeader.myNodesCount) * sizeof(NodeRecord) },
+        { myHeader.myChildrenOffset, int64_t(myHeader.myChildrenCount) * sizeof(int32_t) },
+        { myHeader.mySymbolsOffset, int64_t(myHeader.mySymbolsCount) * sizeof(SymbolRecord) },
+        { myHeader.myReferencesOffset, int64_t(myHeader.myReferencesCount) * sizeof(int32_t) },
+        { myHeader.myTablesOffset, int64_t(myHeader.myTablesCount) * sizeof(TableRecord) },
+        { myHeader.myStringsOffset, int64_t(myHeader.myStringsCount) * sizeof(StringRecord) },
+    };
+    for (auto& section : sections) {
+        if (section.first < static_cast<int32_t>(sizeof(Header)) || section.second < 0 || section.first + section.second > static_cast<int64_t>(myData.size())) {
+            throw std::invalid_argument("Malformed syntax tree file");
+        }
+    }
+
+    ReadTables();
+    ReadSymbols();
+
+    // Children always follow their parent, so building from the end finds every child ready
+    myNodes.resize(myHeader.myNodesCount);
+    for (int i = myHeader.myNodesCount - 1; i >= 0; i--) {
+        myNodes[i] = ReadNode(i);
+    }
+
+    for (auto& it : myDeclarations) {
+        auto declaration = it.second >= 0 && it.second < static_cast<int>(myNodePointers.size()) ? dynamic_cast<const AbstractDeclaration*>(myNodePointers[it.second]) : nullptr;
+        if (declaration == nullptr) {
+            throw std::invalid_argument("Malformed function declaration");
+        }
+        it.first->SetDeclaration(declaration);
+    }
+
+    return TakeNode<DeclarationBlock>(-1, 0);
+}
+
+bool AstReader::IsAstFile(const std::string& filepath) {
+    std::string extension(FILE_EXTENSION);
+    return filepath.size() >= extension.size() && filepath.compare(filepath.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+template<typename T>
+T AstReader::GetRecord(int32_t offset, int32_t count, int idx) const {
+    if (idx < 0 || idx >= count) {
+        throw std::invalid_argument("Malformed syntax tree file");
+    }
+
+    T record;
+    std::memcpy(&record, myData.data() + offset + static_cast<size_t>(idx) * sizeof(T), sizeof(T));
+    return record;
+}
+
+std::string AstReader::GetString(int idx) const {
+    StringRecord record = GetRecord<StringRecord>(myHeader.myStringsOffset, myHeader.myStringsCount, idx);
+    int64_t begin = int64_t(myHeader.myStringsOffset) + record.myOffset;
+    if (record.myOffset < 0 || record.mySize < 0 || begin + record.mySize > static_cast<int64_t>(myData.size())) {
+        throw std::invalid_argument("Malformed syntax tree file");
+    }
+    return std::string(myData.substr(begin, record.mySize));
+}
+
+Lexeme AstReader::GetLexeme(const LexemeRecord& record) const {
+    if (record.myType < 0 || record.myType > static_cast<int32_t>(LexemeType::Ignored)) {
+        throw std::invalid_argument("Malformed lexeme");
+    }
+
+    try {
+        return Lexeme(record.myColumn, record.myRow, GetString(record.myText), static_cast<LexemeType>(record.myType),
+            GetString(record.myValue), record.isError != 0);
+    } catch (const std::out_of_range&) {
+        throw std::invalid_argument("Malformed lexeme");
+    }
+}
+
+void AstReader::ReadTables() {
+    for (int i = 0; i < myHeader.myTablesCount; i++) {
+        TableRecord record = GetRecord<TableRecord>(myHeader.myTablesOffset, myHeader.myTablesCount, i);
+        if (i == 0) {
+            if (record.myParent != -1) {
+                throw std::invalid_argument("Malformed symbol table");
+            }
+            myTables.push_back(myTable);
+            myOwnedTables.push_back(nullptr);
+            continue;
+        }
+
+        if (record.myParent < 0 || record.myParent >= i) {
+            throw std::invalid_argument("Malformed symbol table");
+        }
+
+        Pointer<SymbolTable> table = std::make_unique<SymbolTable>(myTables[record.myParent]);
+        myTables.push_back(table.get());
+        if (record.myOwner < 0) {
+            myTables[record.myParent]->Add(std::move(table));
+        }
+        myOwnedTables.push_back(std::move(table));
+    }
+
+    if (myTables.empty()) {
+        throw std::invalid_argument("Malformed symbol table");
+    }
+}
+
+void AstReader::ReadSymbols() {
+    std::vector<SymbolRecord> records;
+    for (int i = 0; i < myHeader.mySymbolsCount; i++) {
+        records.push_back(GetRecord<SymbolRecord>(myHeader.mySymbolsOffset, myHeader.mySymbolsCount, i));
+    }
+    mySymbols.resize(records.size(), nullptr);
+
+    auto takeTable = [this](const SymbolRecord& record) {
+        if (record.myOwnTable < 0) {
+            return std::make_unique<SymbolTable>(GetTable(record.myTable));
+        }
+        if (record.myOwnTable >= static_cast<int>(myOwnedTables.size()) || myOwnedTables[record.myOwnTable] == nullptr) {
+            throw std::invalid_argument("Malformed symbol table");
+        }
+        return std::move(myOwnedTables[record.myOwnTable]);
+    };
+
+    // Symbols are created in dependency order: classes, the built-in types, variables, then functions
+    for (int i = 0; i < static_cast<int>(records.size()); i++) {
+        if (records[i].myKind == SymbolKind::Class) {
+            mySymbols[i] = AddSymbol(records[i].myTable, std::make_unique<ClassSymbol>(GetString(records[i].myName), takeTable(records[i])));
+        }
+    }
+
+    for (int i = 0; i < static_cast<int>(records.size()); i++) {
+        switch (records[i].myKind) {
+        case SymbolKind::Unresolved:
+            mySymbols[i] = myTable->GetUnresolvedSymbol();
+            break;
+        case SymbolKind::Unit:
+            mySymbols[i] = myTable->GetUnitSymbol();
+            break;
+        case SymbolKind::Boolean:
+            mySymbols[i] = myTable->GetBooleanSymbol();
+            break;
+        case SymbolKind::Integer:
+            mySymbols[i] = myTable->GetIntegerSymbol();
+            break;
+        case SymbolKind::Double:
+            mySymbols[i] = myTable->GetDoubleSymbol();
+            break;
+        case SymbolKind::String:
+            mySymbols[i] = myTable->GetStringSymbol();
+            break;
+        case SymbolKind::Array:
+            mySymbols[i] = myTable->GetArraySymbol(GetType(records[i].myType));
+            break;
+        case SymbolKind::Range:
+            mySymbols[i] = myTable->GetRangeSymbol(GetType(records[i].myType));
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (int i = 0; i < static_cast<int>(records.size()); i++) {
+        if (records[i].myKind == SymbolKind::Variable) {
+            auto varSym = std::make_unique<VariableSymbol>(GetString(records[i].myName), GetType(records[i].myType), records[i].isMutable != 0);
+            varSym->SetSlot(records[i].myDepth, records[i].myOffset);
+            mySymbols[i] = AddSymbol(records[i].myTable, std::move(varSym));
+        }
+    }
+
+    for (int i = 0; i < static_cast<int>(records.size()); i++) {
+        const SymbolRecord& record = records[i];
+        if (record.myKind == SymbolKind::Function) {
+            auto funcSym = std::make_unique<FunctionSymbol>(GetString(record.myName), GetType(record.myType), GetParameters(record), takeTable(record), nullptr);
+            myDeclarations.emplace_back(funcSym.get(), record.myDeclaration);
+            mySymbols[i] = AddSymbol(record.myTable, std::move(funcSym));
+        } else if (record.myKind == SymbolKind::BuiltinFunction) {
+            std::string name = GetString(record.myName);
+            std::vector<const AbstractType*> params = GetParameters(record);
+            auto arraySym = dynamic_cast<const ArraySymbol*>(GetType(record.myType));
+
+            const ISymbol* funcSym;
+            if (record.myOwner >= 0) {
+                funcSym = GetType(record.myOwner)->GetTable()->GetFunction(name, params);
+            } else if (arraySym != nullptr && name == "arrayOf") {
+                funcSym = myTable->GetArrayBuilder(arraySym, params.size());
+            } else {
+                funcSym = myTable->GetFunction(name, params);
+            }
+
+            if (dynamic_cast<const FunctionSymbol*>(funcSym) == nullptr) {
+                throw std::invalid_argument("Unknown built-in function " + name);
+            }
+            mySymbols[i] = funcSym;
+        }
+    }
+
+    for (auto symbol : mySymbols) {
+        if (symbol == nullptr) {
+            throw std::invalid_argument("Malformed symbol");
+        }
+    }
+}
+
+Pointer<ISyntaxNode> AstReader::ReadNode(int idx) {
+    NodeRecord record = GetRecord<NodeRecord>(myHeader.myNodesOffset, myHeader.myNodesCount, idx);
+    Lexeme lexeme = GetLexeme(record.myLexeme);
+    const UnitTypeSymbol* unit = myTable->GetUnitSymbol();
+    auto child = [&](int number) {
+        return number < record.myChildrenCount ? GetRecord<int32_t>(myHeader.myChildrenOffset, myHeader.myChildrenCount, record.myFirstChild + number) : -1;
+    };
+    auto declare = [&](AbstractDeclaration& declaration) {
+        // Setting the declaration's symbol resolves its identifier too, which may have been annotated differently
+        const ISymbol* identifierSym = declaration.GetIdentifier().GetSymbol();
+        declaration.SetSymbol(GetSymbol(record.mySymbol));
+        declaration.GetIdentifier().Resolve(identifierSym);
+    };
+
+    Pointer<ISyntaxNode> res;
+    switch (record.myKind) {
+    case NodeKind::Identifier: {
+        auto node = std::make_unique<IdentifierNode>(lexeme, nullptr, SymbolLookup());
+        node->Resolve(GetSymbol(record.mySymbol));
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::Integer:
+        res = std::make_unique<IntegerNode>(lexeme, GetSymbol(record.mySymbol));
+        break;
+    case NodeKind::Double:
+        res = std::make_unique<DoubleNode>(lexeme, GetSymbol(record.mySymbol));
+        break;
+    case NodeKind::Boolean:
+        res = std::make_unique<BooleanNode>(lexeme, GetSymbol(record.mySymbol));
+        break;
+    case NodeKind::String:
+        res = std::make_unique<StringNode>(lexeme, GetSymbol(record.mySymbol));
+        break;
+    case NodeKind::Type: {
+        auto node = std::make_unique<TypeNode>(lexeme, GetSymbol(record.mySymbol));
+        node->SetTypeArgs(TakeNode<TypeArgumentsNode>(idx, child(0), true));
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::Break:
+        res = std::make_unique<BreakNode>(lexeme, unit);
+        break;
+    case NodeKind::Continue:
+        res = std::make_unique<ContinueNode>(lexeme, unit);
+        break;
+    case NodeKind::Return: {
+        auto node = std::make_unique<ReturnNode>(lexeme, unit);
+        node->SetExpression(TakeNode<IAnnotatedNode>(idx, child(0), true));
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::EmptyStatement:
+        res = std::make_unique<EmptyStatement>(lexeme, unit);
+        break;
+    case NodeKind::Assignment:
+        res = std::make_unique<Assignment>(lexeme, TakeNode<IAnnotatedNode>(idx, child(0)), TakeNode<IAnnotatedNode>(idx, child(1)), unit);
+        break;
+    case NodeKind::While:
+        res = std::make_unique<WhileNode>(lexeme, TakeNode<IAnnotatedNode>(idx, child(0)), TakeNode<ISyntaxNode>(idx, child(1)), unit);
+        break;
+    case NodeKind::DoWhile:
+        res = std::make_unique<DoWhileNode>(lexeme, TakeNode<IAnnotatedNode>(idx, child(0)), TakeNode<ISyntaxNode>(idx, child(1)), unit);
+        break;
+    case NodeKind::For:
+        res = std::make_unique<ForNode>(lexeme, TakeNode<IAnnotatedNode>(idx, child(0)), TakeNode<ISyntaxNode>(idx, child(1)),
+            TakeNode<VariableNode>(idx, child(2)), unit);
+        break;
+    case NodeKind::BinOperation:
+        res = std::make_unique<BinOperationNode>(lexeme, TakeNode<IAnnotatedNode>(idx, child(0)), TakeNode<IAnnotatedNode>(idx, child(1)),
+            GetType(record.mySymbol));
+        break;
+    case NodeKind::UnaryPrefixOperation:
+        res = std::make_unique<UnaryPrefixOperationNode>(lexeme, TakeNode<IAnnotatedNode>(idx, child(0)), GetType(record.mySymbol));
+        break;
+    case NodeKind::UnaryPostfixOperation:
+        res = std::make_unique<UnaryPostfixOperationNode>(lexeme, TakeNode<IAnnotatedNode>(idx, child(0)), GetType(record.mySymbol));
+        break;
+    case NodeKind::CallArguments: {
+        auto node = std::make_unique<CallArgumentsNode>(lexeme);
+        for (int i = 0; i < record.myChildrenCount; i++) {
+            node->AddArgument(TakeNode<IAnnotatedNode>(idx, child(i)));
+        }
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::TypeArguments: {
+        auto node = std::make_unique<TypeArgumentsNode>(lexeme);
+        for (int i = 0; i < record.myChildrenCount; i++) {
+            node->AddArgument(TakeNode<TypeNode>(idx, child(i)));
+        }
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::IndexSuffix:
+        res = std::make_unique<IndexSuffixNode>(TakeNode<IAnnotatedNode>(idx, child(0)), TakeNode<CallArgumentsNode>(idx, child(1)),
+            GetType(record.mySymbol));
+        break;
+    case NodeKind::CallSuffix: {
+        auto node = std::make_unique<CallSuffixNode>(TakeNode<IAnnotatedNode>(idx, child(0)), TakeNode<CallArgumentsNode>(idx, child(1)),
+            GetType(record.mySymbol));
+        node->SetTypeArguments(TakeNode<TypeArgumentsNode>(idx, child(2), true));
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::MemberAccess:
+        res = std::make_unique<MemberAccessNode>(lexeme, TakeNode<IAnnotatedNode>(idx, child(0)), TakeNode<IdentifierNode>(idx, child(1)));
+        break;
+    case NodeKind::If:
+        res = std::make_unique<IfExpression>(lexeme, unit, TakeNode<IAnnotatedNode>(idx, child(0)), TakeNode<IAnnotatedNode>(idx, child(1)),
+            TakeNode<IAnnotatedNode>(idx, child(2)));
+        break;
+    case NodeKind::Block: {
+        auto node = std::make_unique<BlockNode>(lexeme, unit);
+        for (int i = 0; i < record.myChildrenCount; i++) {
+            node->AddStatement(TakeNode<IAnnotatedNode>(idx, child(i)));
+        }
+        node->SetSymbol(GetType(record.mySymbol));
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::DeclarationBlock: {
+        auto node = std::make_unique<DeclarationBlock>(lexeme);
+        for (int i = 0; i < record.myChildrenCount; i++) {
+            node->AddDeclaration(TakeNode<AbstractDeclaration>(idx, child(i)));
+        }
+        node->SetFrame(record.myDepth, record.myFrameSize);
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::ClassDeclaration: {
+        auto node = std::make_unique<ClassDeclaration>(TakeNode<IdentifierNode>(idx, child(0)), unit);
+        node->SetBody(TakeNode<DeclarationBlock>(idx, child(1), true));
+        declare(*node);
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::Parameter: {
+        auto node = std::make_unique<ParameterNode>(TakeNode<IdentifierNode>(idx, child(0)), unit, TakeNode<IAnnotatedNode>(idx, child(1)));
+        node->SetDefault(TakeNode<IAnnotatedNode>(idx, child(2), true));
+        declare(*node);
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::Variable: {
+        auto node = std::make_unique<VariableNode>(TakeNode<IdentifierNode>(idx, child(0)), unit);
+        node->SetTypeNode(TakeNode<IAnnotatedNode>(idx, child(1), true));
+        declare(*node);
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::ParameterList: {
+        auto node = std::make_unique<ParameterList>(lexeme);
+        for (int i = 0; i < record.myChildrenCount; i++) {
+            node->AddParameter(TakeNode<ParameterNode>(idx, child(i)));
+        }
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::FunctionDeclaration: {
+        auto node = std::make_unique<FunctionDeclaration>(TakeNode<IdentifierNode>(idx, child(0)), unit, TakeNode<ParameterList>(idx, child(1)));
+        node->SetReturn(TakeNode<IAnnotatedNode>(idx, child(2), true));
+        node->SetBody(TakeNode<IAnnotatedNode>(idx, child(3)));
+        node->SetFrame(record.myDepth, record.myFrameSize);
+        declare(*node);
+        res = std::move(node);
+        break;
+    }
+    case NodeKind::PropertyDeclaration: {
+        auto node = std::make_unique<PropertyDeclaration>(TakeNode<IdentifierNode>(idx, child(0)), unit, lexeme);
+        node->SetTypeNode(TakeNode<IAnnotatedNode>(idx, child(1), true));
+        node->SetInitialization(TakeNode<IAnnotatedNode>(idx, child(2), true));
+        declare(*node);
+        res = std::move(node);
+        break;
+    }
+    default:
+        throw std::invalid_argument("Unknown node kind");
+    }
+
+    myNodePointers.resize(myHeader.myNodesCount, nullptr);
+    myNodePointers[idx] = res.get();
+    return res;
+}
+
+const ISymbol* AstReader::GetSymbol(int idx) const {
+    if (idx == -1) {
+        return nullptr;
+    }
+    if (idx < 0 || idx >= static_cast<int>(mySymbols.size()) || mySymbols[idx] == nullptr) {
+        throw std::invalid_argument("Malformed symbol reference");
+    }
+    return mySymbols[idx];
+}
+
+const AbstractType* AstReader::GetType(int idx) const {
+    const ISymbol* symbol = GetSymbol(idx);
+    auto type = dynamic_cast<const AbstractType*>(symbol);
+    if (symbol != nullptr && type == nullptr) {
+        throw std::invalid_argument("Symbol " + symbol->GetName() + " is not a type");
+    }
+    return type;
+}
+
+std::vector<const AbstractType*> AstReader::GetParameters(const SymbolRecord& record) const {
+    std::vector<const AbstractType*> params;
+    for (int i = 0; i < record.myParametersCount; i++) {
+        params.push_back(GetType(GetRecord<int32_t>(myHeader.myReferencesOffset, myHeader.myReferencesCount, record.myFirstParameter + i)));
+    }
+    return params;
+}
+
+SymbolTable* AstReader::GetTable(int idx) const {
+    if (idx < 0 || idx >= static_cast<int>(myTables.size())) {
+        throw std::invalid_argument("Malformed symbol table");
+    }
+    return myTables[idx];
+}
+
+const ISymbol* AstReader::AddSymbol(int table, Pointer<ISymbol> symbol) {
+    const ISymbol* res = GetTable(table)->Add(std::move(symbol));
+    if (dynamic_cast<const UnresolvedSymbol*>(res) != nullptr) {
+        throw std::invalid_argument("Conflicting symbols in the symbol table");
+    }
+    return res;
+}
+
+template<typename T>
+Pointer<T> AstReader::TakeNode(int parent, int idx, bool isOptional) {
+    if (idx == -1 && isOptional) {
+        return nullptr;
+    }
+    if (idx <= parent || idx >= static_cast<int>(myNodes.size()) || myNodes[idx] == nullptr) {
+        throw std::invalid_argument("Malformed syntax tree");
+    }
+
+    auto node = dynamic_cast<T*>(myNodes[idx].get());
+    if (node == nullptr) {
+        throw std::invalid_argument("Malformed syntax tree");
+    }
+    myNodes[idx].release();
+    return Pointer<T>(node);
+}
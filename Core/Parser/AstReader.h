@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "AstFormat.h"
+#include "DeclarationNodes.h"
+#include "../MappedInputBuffer.h"
+
+class AbstractType;
+class FunctionSymbol;
+class SymbolTable;
+
+// Loads a tree stored by AstWriter into the given table, which must be a fresh unit table.
+// The file is mapped and its records are read in place, nothing is lexed or checked again
+class AstReader {
+public:
+    AstReader(const std::string& filepath, SymbolTable* symbolTable);
+
+    // Throws std::invalid_argument on malformed input
+    Pointer<DeclarationBlock> Read();
+
+    static bool IsAstFile(const std::string& filepath);
+
+private:
+    template<typename T>
+    T GetRecord(int32_t offset, int32_t count, int idx) const;
+
+    std::string GetString(int idx) const;
+    Lexeme GetLexeme(const AstFormat::LexemeRecord& record) const;
+
+    void ReadTables();
+    void ReadSymbols();
+    Pointer<ISyntaxNode> ReadNode(int idx);
+
+    const ISymbol* GetSymbol(int idx) const;
+    const AbstractType* GetType(int idx) const;
+    std::vector<const AbstractType*> GetParameters(const AstFormat::SymbolRecord& record) const;
+    SymbolTable* GetTable(int idx) const;
+    const ISymbol* AddSymbol(int table, Pointer<ISymbol> symbol);
+
+    // Children always have greater indices than their parent and belong to exactly one of them
+    template<typename T>
+    Pointer<T> TakeNode(int parent, int idx, bool isOptional = false);
+
+    MappedInputBuffer myInput;
+    std::string_view myData;
+    AstFormat::Header myHeader;
+    SymbolTable* myTable;
+
+    std::vector<SymbolTable*> myTables;
+    std::vector<Pointer<SymbolTable>> myOwnedTables;
+    std::vector<const ISymbol*> mySymbols;
+    std::vector<std::pair<FunctionSymbol*, int>> myDeclarations;
+    std::vector<Pointer<ISyntaxNode>> myNodes;
+    std::vector<const ISyntaxNode*> myNodePointers;
+};
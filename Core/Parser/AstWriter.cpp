@@ -0,0 +1,469 @@
+#include "AstWriter.h"
+
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "DeclarationNodes.h"
+#include "ExpressionNodes.h"
+#include "StatementNodes.h"
+#include "Semantics/ClassSymbol.h"
+#include "Semantics/FunctionSymbol.h"
+#include "Semantics/FundamentalType.h"
+
+using namespace AstFormat;
+
+namespace {
+    SymbolRecord EmptySymbol() {
+        SymbolRecord record{};
+        record.myName = record.myTable = record.myType = record.myOwner = record.myOwnTable = record.myDeclaration = -1;
+        record.myDepth = record.myOffset = -1;
+        return record;
+    }
+
+    template<typename T>
+    void WriteSection(std::ostream& output, const std::vector<T>& records) {
+        output.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+    }
+}
+
+AstWriter::AstWriter(const SymbolTable* symbolTable) : myTable(symbolTable) {}
+
+void AstWriter::Write(const DeclarationBlock& syntaxTree, std::ostream& output) {
+    myTable->RunVisitor(*this);
+    WriteNode(&syntaxTree);
+
+    for (int i = 0; i < static_cast<int>(mySymbols.size()); i++) {
+        if (!isDefined[i]) {
+            throw std::invalid_argument("Symbol is not declared in the unit");
+        }
+    }
+
+    for (auto& it : mySymbolIndices) {
+        auto funcSym = dynamic_cast<const FunctionSymbol*>(it.first);
+        if (funcSym != nullptr && funcSym->GetDeclaration() != nullptr) {
+            auto declaration = myNodeIndices.find(funcSym->GetDeclaration());
+            if (declaration == myNodeIndices.end()) {
+                throw std::invalid_argument("Declaration of " + funcSym->GetName() + " is not in the tree");
+            }
+            mySymbols[it.second].myDeclaration = declaration->second;
+        }
+    }
+
+    std::vector<StringRecord> strings;
+    int32_t stringsSize = myStrings.size() * sizeof(StringRecord);
+    for (auto& str : myStrings) {
+        strings.push_back({ stringsSize, static_cast<int32_t>(str.size()) });
+        stringsSize += str.size();
+    }
+
+    Header header{};
+    std::copy(MAGIC, MAGIC + sizeof(header.myMagic), header.myMagic);
+    header.myVersion = VERSION;
+    header.myNodesOffset = sizeof(Header);
+    header.myNodesCount = myNodes.size();
+    header.myChildrenOffset = header.myNodesOffset + myNodes.size() * sizeof(NodeRecord);
+    header.myChildrenCount = myChildren.size();
+    header.mySymbolsOffset = header.myChildrenOffset + myChildren.size() * sizeof(int32_t);
+    header.mySymbolsCount = mySymbols.size();
+    header.myReferencesOffset = header.mySymbolsOffset + mySymbols.size() * sizeof(SymbolRecord);
+    header.myReferencesCount = myReferences.size();
+    header.myTablesOffset = header.myReferencesOffset + myReferences.size() * sizeof(int32_t);
+    header.myTablesCount = myTables.size();
+    header.myStringsOffset = header.myTablesOffset + myTables.size() * sizeof(TableRecord);
+    header.myStringsCount = myStrings.size();
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WriteSection(output, myNodes);
+    WriteSection(output, myChildren);
+    WriteSection(output, mySymbols);
+    WriteSection(output, myReferences);
+    WriteSection(output, myTables);
+    WriteSection(output, strings);
+    for (auto& str : myStrings) {
+        output.write(str.data(), str.size());
+    }
+}
+
+void AstWriter::EnterNode(const IVisitable& node) {
+    if (dynamic_cast<const SymbolTable*>(&node) != nullptr) {
+        TableRecord record{ -1, -1 };
+        for (auto it = myScopes.rbegin(); it != myScopes.rend(); ++it) {
+            if (it->isTable) {
+                record.myParent = it->myIndex;
+                break;
+            }
+        }
+        if (!myScopes.empty() && !myScopes.back().isTable) {
+            record.myOwner = myScopes.back().myIndex;
+            mySymbols[record.myOwner].myOwnTable = myTables.size();
+        }
+
+        myScopes.push_back({ true, static_cast<int>(myTables.size()) });
+        myTables.push_back(record);
+        INodeVisitor::EnterNode(node);
+        myScopes.pop_back();
+        return;
+    }
+
+    auto symbol = dynamic_cast<const ISymbol*>(&node);
+    if (symbol == nullptr || IsBuiltin(*symbol)) {
+        return;
+    }
+
+    DefineSymbol(*symbol);
+    myScopes.push_back({ false, mySymbolIndices.at(symbol) });
+    INodeVisitor::EnterNode(node);
+    myScopes.pop_back();
+}
+
+void AstWriter::EnterNode(const IdentifierNode& node) {
+    AddNode(NodeKind::Identifier, node, node.GetSymbol());
+}
+
+void AstWriter::EnterNode(const IntegerNode& node) {
+    AddNode(NodeKind::Integer, node, node.GetSymbol());
+}
+
+void AstWriter::EnterNode(const DoubleNode& node) {
+    AddNode(NodeKind::Double, node, node.GetSymbol());
+}
+
+void AstWriter::EnterNode(const BooleanNode& node) {
+    AddNode(NodeKind::Boolean, node, node.GetSymbol());
+}
+
+void AstWriter::EnterNode(const StringNode& node) {
+    AddNode(NodeKind::String, node, node.GetSymbol());
+}
+
+void AstWriter::EnterNode(const TypeNode& node) {
+    int idx = AddNode(NodeKind::Type, node, node.GetSymbol());
+    SetChildren(idx, { WriteNode(node.GetTypeArgs()) });
+}
+
+void AstWriter::EnterNode(const BreakNode& node) {
+    AddNode(NodeKind::Break, node);
+}
+
+void AstWriter::EnterNode(const ContinueNode& node) {
+    AddNode(NodeKind::Continue, node);
+}
+
+void AstWriter::EnterNode(const ReturnNode& node) {
+    int idx = AddNode(NodeKind::Return, node);
+    SetChildren(idx, { WriteNode(node.GetExpression()) });
+}
+
+void AstWriter::EnterNode(const EmptyStatement& node) {
+    AddNode(NodeKind::EmptyStatement, node);
+}
+
+void AstWriter::EnterNode(const Assignment& node) {
+    int idx = AddNode(NodeKind::Assignment, node);
+    SetChildren(idx, { WriteNode(&node.GetAssignable()), WriteNode(&node.GetExpression()) });
+}
+
+void AstWriter::EnterNode(const WhileNode& node) {
+    int idx = AddNode(NodeKind::While, node);
+    SetChildren(idx, { WriteNode(&node.GetExpression()), WriteNode(&node.GetBody()) });
+}
+
+void AstWriter::EnterNode(const DoWhileNode& node) {
+    int idx = AddNode(NodeKind::DoWhile, node);
+    SetChildren(idx, { WriteNode(&node.GetExpression()), WriteNode(&node.GetBody()) });
+}
+
+void AstWriter::EnterNode(const ForNode& node) {
+    int idx = AddNode(NodeKind::For, node);
+    SetChildren(idx, { WriteNode(&node.GetExpression()), WriteNode(&node.GetBody()), WriteNode(&node.GetVariable()) });
+}
+
+void AstWriter::EnterNode(const BinOperationNode& node) {
+    int idx = AddNode(NodeKind::BinOperation, node, node.GetType());
+    SetChildren(idx, { WriteNode(&node.GetLeftOperand()), WriteNode(&node.GetRightOperand()) });
+}
+
+void AstWriter::EnterNode(const UnaryPrefixOperationNode& node) {
+    int idx = AddNode(NodeKind::UnaryPrefixOperation, node, node.GetType());
+    SetChildren(idx, { WriteNode(&node.GetOperand()) });
+}
+
+void AstWriter::EnterNode(const UnaryPostfixOperationNode& node) {
+    int idx = AddNode(NodeKind::UnaryPostfixOperation, node, node.GetType());
+    SetChildren(idx, { WriteNode(&node.GetOperand()) });
+}
+
+void AstWriter::EnterNode(const CallArgumentsNode& node) {
+    int idx = AddNode(NodeKind::CallArguments, node);
+    SetChildren(idx, WriteNodes(node.GetArguments()));
+}
+
+void AstWriter::EnterNode(const TypeArgumentsNode& node) {
+    int idx = AddNode(NodeKind::TypeArguments, node);
+    SetChildren(idx, WriteNodes(node.GetArguments()));
+}
+
+void AstWriter::EnterNode(const IndexSuffixNode& node) {
+    int idx = AddNode(NodeKind::IndexSuffix, node, node.GetType());
+    SetChildren(idx, { WriteNode(node.GetExpression()), WriteNode(&node.GetArguments()) });
+}
+
+void AstWriter::EnterNode(const CallSuffixNode& node) {
+    int idx = AddNode(NodeKind::CallSuffix, node, node.GetType());
+    SetChildren(idx, { WriteNode(node.GetExpression()), WriteNode(&node.GetArguments()),
+        WriteNode(node.HasTypeArguments() ? &node.GetTypeArguments() : nullptr) });
+}
+
+void AstWriter::EnterNode(const MemberAccessNode& node) {
+    int idx = AddNode(NodeKind::MemberAccess, node);
+    int expression = WriteNode(node.GetExpression());
+
+    // Built-in members are found again through the type of the receiver
+    const AbstractType* previous = myReceiver;
+    myReceiver = node.GetExpression()->GetType();
+    int member = WriteNode(node.GetMember());
+    myReceiver = previous;
+
+    SetChildren(idx, { expression, member });
+}
+
+void AstWriter::EnterNode(const IfExpression& node) {
+    int idx = AddNode(NodeKind::If, node);
+    SetChildren(idx, { WriteNode(node.GetExpression()), WriteNode(node.GetIfBody()), WriteNode(node.GetElseBody()) });
+}
+
+void AstWriter::EnterNode(const BlockNode& node) {
+    int idx = AddNode(NodeKind::Block, node, node.GetType());
+    SetChildren(idx, WriteNodes(node.GetStatements()));
+}
+
+void AstWriter::EnterNode(const DeclarationBlock& node) {
+    int idx = AddNode(NodeKind::DeclarationBlock, node);
+    myNodes[idx].myDepth = node.GetDepth();
+    myNodes[idx].myFrameSize = node.GetFrameSize();
+    SetChildren(idx, WriteNodes(node.GetDeclarations()));
+}
+
+void AstWriter::EnterNode(const ClassDeclaration& node) {
+    int idx = AddNode(NodeKind::ClassDeclaration, node, node.GetSymbol());
+    SetChildren(idx, { WriteNode(&node.GetIdentifier()), WriteNode(node.HasBody() ? &node.GetBody() : nullptr) });
+}
+
+void AstWriter::EnterNode(const ParameterNode& node) {
+    int idx = AddNode(NodeKind::Parameter, node, node.GetSymbol());
+    SetChildren(idx, { WriteNode(&node.GetIdentifier()), WriteNode(&node.GetTypeNode()),
+        WriteNode(node.HasDefault() ? &node.GetDefault() : nullptr) });
+}
+
+void AstWriter::EnterNode(const VariableNode& node) {
+    int idx = AddNode(NodeKind::Variable, node, node.GetSymbol());
+    SetChildren(idx, { WriteNode(&node.GetIdentifier()), WriteNode(node.HasTypeNode() ? &node.GetTypeNode() : nullptr) });
+}
+
+void AstWriter::EnterNode(const ParameterList& node) {
+    int idx = AddNode(NodeKind::ParameterList, node);
+    SetChildren(idx, WriteNodes(node.GetParameters()));
+}
+
+void AstWriter::EnterNode(const FunctionDeclaration& node) {
+    int idx = AddNode(NodeKind::FunctionDeclaration, node, node.GetSymbol());
+    myNodes[idx].myDepth = node.GetDepth();
+    myNodes[idx].myFrameSize = node.GetFrameSize();
+    SetChildren(idx, { WriteNode(&node.GetIdentifier()), WriteNode(&node.GetParameters()),
+        WriteNode(node.HasReturnNode() ? &node.GetReturn() : nullptr), WriteNode(&node.GetBody()) });
+}
+
+void AstWriter::EnterNode(const PropertyDeclaration& node) {
+    int idx = AddNode(NodeKind::PropertyDeclaration, node, node.GetSymbol());
+
+    // The node's own lexeme is the identifier's, the slot keeps the keyword instead
+    Lexeme lexeme = node.GetLexeme();
+    myNodes[idx].myLexeme = ToRecord(Lexeme(lexeme.GetColumn(), lexeme.GetRow(), node.GetKeyword(), LexemeType::Keyword, node.GetKeyword()));
+
+    SetChildren(idx, { WriteNode(&node.GetIdentifier()), WriteNode(node.HasTypeNode() ? &node.GetTypeNode() : nullptr),
+        WriteNode(node.HasInitialization() ? &node.GetInitialization() : nullptr) });
+}
+
+int AstWriter::AddNode(NodeKind kind, const ISyntaxNode& node, const ISymbol* symbol) {
+    NodeRecord record{};
+    record.myKind = kind;
+    record.mySymbol = GetSymbolIndex(symbol);
+    record.myLexeme = ToRecord(node.GetLexeme());
+
+    myLastNode = myNodes.size();
+    myNodes.push_back(record);
+    myNodeIndices.emplace(&node, myLastNode);
+    return myLastNode;
+}
+
+void AstWriter::SetChildren(int node, const std::vector<int>& children) {
+    myNodes[node].myFirstChild = myChildren.size();
+    myNodes[node].myChildrenCount = children.size();
+    myChildren.insert(myChildren.end(), children.begin(), children.end());
+}
+
+int AstWriter::WriteNode(const ISyntaxNode* node) {
+    if (node == nullptr) {
+        return -1;
+    }
+
+    node->RunVisitor(*this);
+    return myNodeIndices.at(node);
+}
+
+template<typename T>
+std::vector<int> AstWriter::WriteNodes(const std::vector<T>& nodes) {
+    std::vector<int> indices;
+    for (auto& node : nodes) {
+        indices.push_back(WriteNode(node.get()));
+    }
+    return indices;
+}
+
+int AstWriter::GetSymbolIndex(const ISymbol* symbol) {
+    if (symbol == nullptr) {
+        return -1;
+    }
+
+    auto it = mySymbolIndices.find(symbol);
+    if (it != mySymbolIndices.end()) {
+        return it->second;
+    }
+
+    // Symbols of the unit are only reserved here and filled in when the symbol table reaches them
+    SymbolRecord record = IsBuiltin(*symbol) ? GetBuiltinRecord(*symbol) : EmptySymbol();
+    int idx = mySymbols.size();
+    mySymbols.push_back(record);
+    isDefined.push_back(IsBuiltin(*symbol));
+    mySymbolIndices.emplace(symbol, idx);
+    return idx;
+}
+
+SymbolRecord AstWriter::GetBuiltinRecord(const ISymbol& symbol) {
+    SymbolRecord record = EmptySymbol();
+    if (dynamic_cast<const UnresolvedSymbol*>(&symbol)) {
+        record.myKind = SymbolKind::Unresolved;
+    } else if (dynamic_cast<const UnitTypeSymbol*>(&symbol)) {
+        record.myKind = SymbolKind::Unit;
+    } else if (dynamic_cast<const BooleanSymbol*>(&symbol)) {
+        record.myKind = SymbolKind::Boolean;
+    } else if (dynamic_cast<const IntegerSymbol*>(&symbol)) {
+        record.myKind = SymbolKind::Integer;
+    } else if (dynamic_cast<const DoubleSymbol*>(&symbol)) {
+        record.myKind = SymbolKind::Double;
+    } else if (dynamic_cast<const StringSymbol*>(&symbol)) {
+        record.myKind = SymbolKind::String;
+    } else if (auto arraySym = dynamic_cast<const ArraySymbol*>(&symbol)) {
+        record.myKind = SymbolKind::Array;
+        record.myType = GetSymbolIndex(arraySym->GetType());
+    } else if (auto rangeSym = dynamic_cast<const RangeSymbol*>(&symbol)) {
+        record.myKind = SymbolKind::Range;
+        record.myType = GetSymbolIndex(rangeSym->GetType());
+    } else if (auto funcSym = dynamic_cast<const FunctionSymbol*>(&symbol)) {
+        std::vector<const AbstractType*> params;
+        for (int i = 0; i < funcSym->GetParametersCount(); i++) {
+            params.push_back(funcSym->GetParameter(i));
+        }
+
+        record.myKind = SymbolKind::BuiltinFunction;
+        if (myReceiver != nullptr && myReceiver->GetTable()->GetFunction(funcSym->GetName(), params) == funcSym) {
+            record.myOwner = GetSymbolIndex(myReceiver);
+        } else if (myTable->GetFunction(funcSym->GetName(), params) != funcSym) {
+            throw std::invalid_argument("Cannot store built-in function " + funcSym->GetName());
+        }
+        record.myName = AddString(funcSym->GetName());
+        record.myType = GetSymbolIndex(funcSym->GetReturnType());
+        record.myFirstParameter = AddReferences(*funcSym);
+        record.myParametersCount = funcSym->GetParametersCount();
+    } else {
+        throw std::invalid_argument("Cannot store built-in symbol " + symbol.GetName());
+    }
+
+    return record;
+}
+
+int AstWriter::AddReferences(const FunctionSymbol& symbol) {
+    std::vector<int32_t> params;
+    for (int i = 0; i < symbol.GetParametersCount(); i++) {
+        params.push_back(GetSymbolIndex(symbol.GetParameter(i)));
+    }
+
+    int first = myReferences.size();
+    myReferences.insert(myReferences.end(), params.begin(), params.end());
+    return first;
+}
+
+void AstWriter::DefineSymbol(const ISymbol& symbol) {
+    int idx = GetSymbolIndex(&symbol);
+    SymbolRecord record = EmptySymbol();
+    record.myName = AddString(symbol.GetName());
+    record.myTable = myScopes.back().myIndex;
+
+    if (dynamic_cast<const ClassSymbol*>(&symbol)) {
+        record.myKind = SymbolKind::Class;
+    } else if (auto funcSym = dynamic_cast<const FunctionSymbol*>(&symbol)) {
+        record.myKind = SymbolKind::Function;
+        record.myType = GetSymbolIndex(funcSym->GetReturnType());
+        record.myFirstParameter = AddReferences(*funcSym);
+        record.myParametersCount = funcSym->GetParametersCount();
+    } else if (auto varSym = dynamic_cast<const VariableSymbol*>(&symbol)) {
+        record.myKind = SymbolKind::Variable;
+        record.myType = GetSymbolIndex(varSym->GetType());
+        record.isMutable = varSym->IsMutable();
+        record.myDepth = varSym->GetDepth();
+        record.myOffset = varSym->GetOffset();
+    } else {
+        throw std::invalid_argument("Cannot store symbol " + symbol.GetName());
+    }
+
+    mySymbols[idx] = record;
+    isDefined[idx] = true;
+}
+
+int AstWriter::AddString(const std::string& text) {
+    auto it = myStringIndices.find(text);
+    if (it != myStringIndices.end()) {
+        return it->second;
+    }
+
+    myStrings.push_back(text);
+    myStringIndices.emplace(text, myStrings.size() - 1);
+    return myStrings.size() - 1;
+}
+
+LexemeRecord AstWriter::ToRecord(const Lexeme& lexeme) {
+    LexemeRecord record{ lexeme.GetColumn(), lexeme.GetRow(), static_cast<int32_t>(lexeme.GetType()), lexeme.IsError(), AddString(lexeme.GetText()), -1 };
+
+    if (lexeme.IsError()) {
+        record.myValue = AddString(lexeme.GetValue<std::string>());
+        return record;
+    }
+
+    switch (Lexeme::GetNumberType(lexeme.GetType())) {
+        case Lexeme::NumberType::Integer:
+        case Lexeme::NumberType::UInteger:
+            record.myValue = AddString(std::to_string(lexeme.GetValue<uint64_t>()));
+            break;
+        case Lexeme::NumberType::Real: {
+            // Hexadecimal keeps every bit of the value and is still accepted by std::stod
+            std::ostringstream ss;
+            ss << std::hexfloat << lexeme.GetValue<double>();
+            record.myValue = AddString(ss.str());
+            break;
+        }
+        default:
+            record.myValue = AddString(lexeme.GetValue<std::string>());
+            break;
+    }
+    return record;
+}
+
+bool AstWriter::IsBuiltin(const ISymbol& symbol) {
+    if (dynamic_cast<const FundamentalType*>(&symbol)) {
+        return true;
+    }
+    auto funcSym = dynamic_cast<const FunctionSymbol*>(&symbol);
+    return funcSym != nullptr && funcSym->GetDeclaration() == nullptr;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AstFormat.h"
+#include "INodeVisitor.h"
+#include "../Lexer/Lexeme.h"
+
+class AbstractType;
+class FunctionSymbol;
+class ISymbol;
+class ISyntaxNode;
+class SymbolTable;
+
+// Stores a checked syntax tree together with the symbols it refers to in the binary format read by AstReader
+class AstWriter : public INodeVisitor {
+public:
+    explicit AstWriter(const SymbolTable* symbolTable);
+
+    // Throws std::invalid_argument if the tree refers to symbols that can't be stored
+    void Write(const DeclarationBlock& syntaxTree, std::ostream& output);
+
+    void EnterNode(const IVisitable& node) override;
+
+    void EnterNode(const IdentifierNode& node) override;
+    void EnterNode(const IntegerNode& node) override;
+    void EnterNode(const DoubleNode& node) override;
+    void EnterNode(const BooleanNode& node) override;
+    void EnterNode(const StringNode& node) override;
+    void EnterNode(const TypeNode& node) override;
+    void EnterNode(const BreakNode& node) override;
+    void EnterNode(const ContinueNode& node) override;
+    void EnterNode(const ReturnNode& node) override;
+
+    void EnterNode(const EmptyStatement& node) override;
+    void EnterNode(const Assignment& node) override;
+    void EnterNode(const WhileNode& node) override;
+    void EnterNode(const DoWhileNode& node) override;
+    void EnterNode(const ForNode& node) override;
+
+    void EnterNode(const BinOperationNode& node) override;
+    void EnterNode(const UnaryPrefixOperationNode& node) override;
+    void EnterNode(const UnaryPostfixOperationNode& node) override;
+    void EnterNode(const CallArgumentsNode& node) override;
+    void EnterNode(const TypeArgumentsNode& node) override;
+    void EnterNode(const IndexSuffixNode& node) override;
+    void EnterNode(const CallSuffixNode& node) override;
+    void EnterNode(const MemberAccessNode& node) override;
+    void EnterNode(const IfExpression& node) override;
+    void EnterNode(const BlockNode& node) override;
+
+    void EnterNode(const DeclarationBlock& node) override;
+    void EnterNode(const ClassDeclaration& node) override;
+    void EnterNode(const ParameterNode& node) override;
+    void EnterNode(const VariableNode& node) override;
+    void EnterNode(const ParameterList& node) override;
+    void EnterNode(const FunctionDeclaration& node) override;
+    void EnterNode(const PropertyDeclaration& node) override;
+
+private:
+    // Symbols and tables which are being visited while the symbol table is stored
+    struct Scope {
+        bool isTable;
+        int myIndex;
+    };
+
+    int AddNode(AstFormat::NodeKind kind, const ISyntaxNode& node, const ISymbol* symbol = nullptr);
+    void SetChildren(int node, const std::vector<int>& children);
+    int WriteNode(const ISyntaxNode* node);
+    template<typename T>
+    std::vector<int> WriteNodes(const std::vector<T>& nodes);
+
+    int GetSymbolIndex(const ISymbol* symbol);
+    AstFormat::SymbolRecord GetBuiltinRecord(const ISymbol& symbol);
+    int AddReferences(const FunctionSymbol& symbol);
+    void DefineSymbol(const ISymbol& symbol);
+    int AddString(const std::string& text);
+    AstFormat::LexemeRecord ToRecord(const Lexeme& lexeme);
+
+    static bool IsBuiltin(const ISymbol& symbol);
+
+    const SymbolTable* myTable;
+    const AbstractType* myReceiver = nullptr;
+    int myLastNode = -1;
+
+    std::vector<AstFormat::NodeRecord> myNodes;
+    std::vector<int32_t> myChildren;
+    std::vector<AstFormat::SymbolRecord> mySymbols;
+    std::vector<int32_t> myReferences;
+    std::vector<AstFormat::TableRecord> myTables;
+    std::vector<std::string> myStrings;
+
+    std::unordered_map<const ISyntaxNode*, int> myNodeIndices;
+    std::unordered_map<const ISymbol*, int> mySymbolIndices;
+    std::vector<bool> isDefined;
+    std::unordered_map<std::string, int> myStringIndices;
+    std::vector<Scope> myScopes;
+};
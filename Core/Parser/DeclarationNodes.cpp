@@ -1,8 +1,9 @@
 #include "DeclarationNodes.h"
+#include "INodeTransformer.h"
 #include "INodeVisitor.h"
 
 AbstractDeclaration::AbstractDeclaration(Pointer<IdentifierNode> identifier, const UnitTypeSymbol* type)
-    : AbstractNode(identifier->GetLexeme()), myUnitSym(type), myIdentifier(std::move(identifier)) {}
+    : IAnnotatedNode(identifier->GetLexeme()), myUnitSym(type), myIdentifier(std::move(identifier)) {}
 
 std::string AbstractDeclaration::GetIdentifierName() const {
     return myIdentifier->GetLexeme().GetValue<std::string>();
@@ -44,6 +45,19 @@ void DeclarationBlock::AddDeclaration(Pointer<AbstractDeclaration> declaration)
     myDeclarations.push_back(std::move(declaration));
 }
 
+int DeclarationBlock::GetDepth() const {
+    return myDepth;
+}
+
+int DeclarationBlock::GetFrameSize() const {
+    return myFrameSize;
+}
+
+void DeclarationBlock::SetFrame(int depth, int size) {
+    myDepth = depth;
+    myFrameSize = size;
+}
+
 void DeclarationBlock::RunVisitor(INodeVisitor& visitor) const {
     visitor.EnterNode(*this);
     IVisitable::RunVisitor(visitor);
@@ -60,6 +74,12 @@ void DeclarationBlock::PropagateVisitor(INodeVisitor& visitor) const {
     }
 }
 
+void DeclarationBlock::PropagateTransformer(INodeTransformer& transformer) {
+    for (auto& declaration : myDeclarations) {
+        transformer.Transform(*declaration);
+    }
+}
+
 ClassDeclaration::ClassDeclaration(Pointer<IdentifierNode> identifier, const UnitTypeSymbol* type) : AbstractDeclaration(std::move(identifier), type) {}
 
 const DeclarationBlock& ClassDeclaration::GetBody() const {
@@ -92,6 +112,12 @@ void ClassDeclaration::PropagateVisitor(INodeVisitor& visitor) const {
     }
 }
 
+void ClassDeclaration::PropagateTransformer(INodeTransformer& transformer) {
+    if (HasBody()) {
+        transformer.Transform(*myClassBody);
+    }
+}
+
 ParameterNode::ParameterNode(Pointer<IdentifierNode> identifier, const UnitTypeSymbol* type, Pointer<IAnnotatedNode> typeNode)
     : AbstractDeclaration(std::move(identifier), type), myType(std::move(typeNode)) {}
 
@@ -139,6 +165,12 @@ void ParameterNode::PropagateVisitor(INodeVisitor& visitor) const {
     }
 }
 
+void ParameterNode::PropagateTransformer(INodeTransformer& transformer) {
+    if (HasDefault()) {
+        myDefault = transformer.Transform(std::move(myDefault));
+    }
+}
+
 VariableNode::VariableNode(Pointer<IdentifierNode> identifier, const UnitTypeSymbol* type) : AbstractDeclaration(std::move(identifier), type) {}
 
 const IAnnotatedNode& VariableNode::GetTypeNode() const {
@@ -197,6 +229,12 @@ void ParameterList::PropagateVisitor(INodeVisitor& visitor) const {
     }
 }
 
+void ParameterList::PropagateTransformer(INodeTransformer& transformer) {
+    for (auto& param : myParameters) {
+        transformer.Transform(*param);
+    }
+}
+
 FunctionDeclaration::FunctionDeclaration(Pointer<IdentifierNode> identifier, const UnitTypeSymbol* type, Pointer<ParameterList> parameters)
     : AbstractDeclaration(std::move(identifier), type), myParams(std::move(parameters)) {}
 
@@ -224,6 +262,19 @@ bool FunctionDeclaration::HasReturnNode() const {
     return myReturn != nullptr;
 }
 
+int FunctionDeclaration::GetDepth() const {
+    return myDepth;
+}
+
+int FunctionDeclaration::GetFrameSize() const {
+    return myFrameSize;
+}
+
+void FunctionDeclaration::SetFrame(int depth, int size) {
+    myDepth = depth;
+    myFrameSize = size;
+}
+
 void FunctionDeclaration::RunVisitor(INodeVisitor& visitor) const {
     visitor.EnterNode(*this);
     IVisitable::RunVisitor(visitor);
@@ -245,11 +296,16 @@ void FunctionDeclaration::PropagateVisitor(INodeVisitor& visitor) const {
     myBody->RunVisitor(visitor);
 }
 
+void FunctionDeclaration::PropagateTransformer(INodeTransformer& transformer) {
+    transformer.Transform(*myParams);
+    myBody = transformer.Transform(std::move(myBody));
+}
+
 PropertyDeclaration::PropertyDeclaration(Pointer<IdentifierNode> identifier, const UnitTypeSymbol* type, const Lexeme& keyword)
     : AbstractDeclaration(std::move(identifier), type), myKeyword(keyword) {}
 
 bool PropertyDeclaration::IsMutable() const {
-    return GetKeyword() == "var";
+    return myKeyword.GetKeyword() == Keyword::Var;
 }
 
 std::string PropertyDeclaration::GetKeyword() const {
@@ -300,3 +356,9 @@ void PropertyDeclaration::PropagateVisitor(INodeVisitor& visitor) const {
         myInit->RunVisitor(visitor);
     }
 }
+
+void PropertyDeclaration::PropagateTransformer(INodeTransformer& transformer) {
+    if (HasInitialization()) {
+        myInit = transformer.Transform(std::move(myInit));
+    }
+}
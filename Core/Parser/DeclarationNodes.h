@@ -3,7 +3,7 @@
 #include "ParserUtils.h"
 #include "SimpleNodes.h"
 
-class AbstractDeclaration : public AbstractNode, public virtual IAnnotatedNode {
+class AbstractDeclaration : public IAnnotatedNode {
 public:
     explicit AbstractDeclaration(Pointer<IdentifierNode> identifier, const UnitTypeSymbol* type);
 
@@ -34,13 +34,20 @@ public:
 
     void AddDeclaration(Pointer<AbstractDeclaration> declaration);
 
+    int GetDepth() const;
+    int GetFrameSize() const;
+    void SetFrame(int depth, int size);
+
     void RunVisitor(INodeVisitor& visitor) const override;
 protected:
     std::string GetName() const override;
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     std::vector<Pointer<AbstractDeclaration>> myDeclarations;
+    int myDepth = 0;
+    int myFrameSize = 0;
 };
 
 class ClassDeclaration : public AbstractDeclaration {
@@ -55,6 +62,7 @@ public:
 protected:
     std::string GetName() const override;
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     Pointer<DeclarationBlock> myClassBody;
@@ -77,6 +85,7 @@ public:
 protected:
     std::string GetName() const override;
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     Pointer<IAnnotatedNode> myType;
@@ -111,6 +120,7 @@ public:
 protected:
     std::string GetName() const override;
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     std::vector<Pointer<ParameterNode>> myParameters;
@@ -129,16 +139,24 @@ public:
     void SetReturn(Pointer<IAnnotatedNode> returnNode);
     bool HasReturnNode() const;
 
+    int GetDepth() const;
+    int GetFrameSize() const;
+    void SetFrame(int depth, int size);
+
     void RunVisitor(INodeVisitor& visitor) const override;
 protected:
     std::string GetName() const override;
 
     void PropagateVisitor(INodeVisitor& visitor) const override;
 
+    void PropagateTransformer(INodeTransformer& transformer) override;
+
 private:
     Pointer<ParameterList> myParams;
     Pointer<IAnnotatedNode> myBody;
     Pointer<IAnnotatedNode> myReturn;
+    int myDepth = 0;
+    int myFrameSize = 0;
 };
 
 class PropertyDeclaration : public AbstractDeclaration {
@@ -160,6 +178,7 @@ public:
 protected:
     std::string GetName() const override;
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     Pointer<IAnnotatedNode> myType;
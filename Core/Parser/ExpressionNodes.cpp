@@ -2,12 +2,13 @@
 
 #include "ISyntaxNode.h"
 #include "StatementNodes.h"
+#include "INodeTransformer.h"
 #include "INodeVisitor.h"
 #include "Semantics/FunctionSymbol.h"
 
 BinOperationNode::BinOperationNode(const Lexeme& operation, Pointer<IAnnotatedNode> left,
                                    Pointer<IAnnotatedNode> right, const AbstractType* type)
-    : AbstractNode(operation), myLeftOperand(std::move(left)), myRightOperand(std::move(right)), myType(type) {}
+    : IAnnotatedNode(operation), myLeftOperand(std::move(left)), myRightOperand(std::move(right)), myType(type) {}
 
 const IAnnotatedNode& BinOperationNode::GetLeftOperand() const {
     return *myLeftOperand;
@@ -44,8 +45,13 @@ void BinOperationNode::PropagateVisitor(INodeVisitor& visitor) const {
     GetRightOperand().RunVisitor(visitor);
 }
 
+void BinOperationNode::PropagateTransformer(INodeTransformer& transformer) {
+    myLeftOperand = transformer.Transform(std::move(myLeftOperand));
+    myRightOperand = transformer.Transform(std::move(myRightOperand));
+}
+
 AbstractUnaryOperationNode::AbstractUnaryOperationNode(const Lexeme& operation, Pointer<IAnnotatedNode> operand, const AbstractType* type)
-    : AbstractNode(operation), myOperand(std::move(operand)), myType(type) {}
+    : IAnnotatedNode(operation), myOperand(std::move(operand)), myType(type) {}
 
 const IAnnotatedNode& AbstractUnaryOperationNode::GetOperand() const {
     return *myOperand;
@@ -67,6 +73,10 @@ void AbstractUnaryOperationNode::PropagateVisitor(INodeVisitor& visitor) const {
     myOperand->RunVisitor(visitor);
 }
 
+void AbstractUnaryOperationNode::PropagateTransformer(INodeTransformer& transformer) {
+    myOperand = transformer.Transform(std::move(myOperand));
+}
+
 UnaryPrefixOperationNode::UnaryPrefixOperationNode(const Lexeme& operation, Pointer<IAnnotatedNode> operand, const AbstractType* type)
     : AbstractUnaryOperationNode(operation, std::move(operand), type) {}
 
@@ -93,7 +103,7 @@ std::string UnaryPostfixOperationNode::GetName() const {
     return "Postfix Op :: " + GetOperation();
 }
 
-AbstractUnaryPostfixNode::AbstractUnaryPostfixNode(const Lexeme& lexeme) : AbstractNode(lexeme) {}
+AbstractUnaryPostfixNode::AbstractUnaryPostfixNode(const Lexeme& lexeme) : IAnnotatedNode(lexeme) {}
 
 CallArgumentsNode::CallArgumentsNode(const Lexeme& lexeme) : AbstractNode(lexeme.CopyEmptyOfType(LexemeType::Ignored)) {}
 
@@ -130,6 +140,12 @@ void CallArgumentsNode::PropagateVisitor(INodeVisitor& visitor) const {
     }
 }
 
+void CallArgumentsNode::PropagateTransformer(INodeTransformer& transformer) {
+    for (auto& arg : myArguments) {
+        arg = transformer.Transform(std::move(arg));
+    }
+}
+
 TypeArgumentsNode::TypeArgumentsNode(const Lexeme& lexeme) : AbstractNode(lexeme.CopyEmptyOfType(LexemeType::Ignored)) {}
 
 const std::vector<Pointer<TypeNode>>& TypeArgumentsNode::GetArguments() const {
@@ -190,6 +206,11 @@ void AbstractPostfixCallNode::PropagateVisitor(INodeVisitor& visitor) const {
     myArgumentsNode->RunVisitor(visitor);
 }
 
+void AbstractPostfixCallNode::PropagateTransformer(INodeTransformer& transformer) {
+    myExpression = transformer.Transform(std::move(myExpression));
+    transformer.Transform(*myArgumentsNode);
+}
+
 IndexSuffixNode::IndexSuffixNode(Pointer<IAnnotatedNode> expression, Pointer<CallArgumentsNode> arguments, const AbstractType* type)
     : AbstractPostfixCallNode(std::move(expression), std::move(arguments), type) {}
 
@@ -295,6 +316,10 @@ void MemberAccessNode::PropagateVisitor(INodeVisitor& visitor) const {
     myMemberNode->RunVisitor(visitor);
 }
 
+void MemberAccessNode::PropagateTransformer(INodeTransformer& transformer) {
+    myExpression = transformer.Transform(std::move(myExpression));
+}
+
 IfExpression::IfExpression(const Lexeme& lexeme, const UnitTypeSymbol* type, Pointer<IAnnotatedNode> expression, Pointer<IAnnotatedNode> ifBody, Pointer<IAnnotatedNode> elseBody)
     : UnitTypedNode(lexeme, type), myExpression(std::move(expression)), myIfBody(std::move(ifBody)), myElseBody(std::move(elseBody)) {}
 
@@ -338,7 +363,13 @@ void IfExpression::PropagateVisitor(INodeVisitor& visitor) const {
     myElseBody->RunVisitor(visitor);
 }
 
-BlockNode::BlockNode(const Lexeme& lexeme, const UnitTypeSymbol* type) : AbstractNode(lexeme), myReturn(type) {}
+void IfExpression::PropagateTransformer(INodeTransformer& transformer) {
+    myExpression = transformer.Transform(std::move(myExpression));
+    myIfBody = transformer.Transform(std::move(myIfBody));
+    myElseBody = transformer.Transform(std::move(myElseBody));
+}
+
+BlockNode::BlockNode(const Lexeme& lexeme, const UnitTypeSymbol* type) : IAnnotatedNode(lexeme), myReturn(type) {}
 
 const std::vector<Pointer<IAnnotatedNode>>& BlockNode::GetStatements() const {
     return myStatements;
@@ -376,3 +407,9 @@ void BlockNode::PropagateVisitor(INodeVisitor& visitor) const {
         statement->RunVisitor(visitor);
     }
 }
+
+void BlockNode::PropagateTransformer(INodeTransformer& transformer) {
+    for (auto& statement : myStatements) {
+        statement = transformer.Transform(std::move(statement));
+    }
+}
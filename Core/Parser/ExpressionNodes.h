@@ -6,7 +6,7 @@
 #include "SimpleNodes.h"
 #include "../Lexer/Lexeme.h"
 
-class BinOperationNode : public AbstractNode, public virtual IAnnotatedNode {
+class BinOperationNode : public IAnnotatedNode {
 public:
     BinOperationNode(const Lexeme& operation, Pointer<IAnnotatedNode> left, Pointer<IAnnotatedNode> right, const AbstractType* type);
 
@@ -23,13 +23,15 @@ protected:
     std::string GetName() const override;
 
     void PropagateVisitor(INodeVisitor& visitor) const override;
+
+    void PropagateTransformer(INodeTransformer& transformer) override;
 private:
     Pointer<IAnnotatedNode> myLeftOperand;
     Pointer<IAnnotatedNode> myRightOperand;
     const AbstractType* myType;
 };
 
-class AbstractUnaryOperationNode : public AbstractNode, public virtual IAnnotatedNode {
+class AbstractUnaryOperationNode : public IAnnotatedNode {
 public:
     AbstractUnaryOperationNode(const Lexeme& operation, Pointer<IAnnotatedNode> operand, const AbstractType* type);
 
@@ -41,6 +43,7 @@ public:
 
 protected:
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     Pointer<IAnnotatedNode> myOperand;
@@ -65,7 +68,7 @@ protected:
     std::string GetName() const override;
 };
 
-class AbstractUnaryPostfixNode : public AbstractNode, public virtual IAnnotatedNode {
+class AbstractUnaryPostfixNode : public IAnnotatedNode {
 public:
     explicit AbstractUnaryPostfixNode(const Lexeme& lexeme);
 };
@@ -83,6 +86,7 @@ public:
 protected:
     std::string GetName() const override;
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     std::vector<Pointer<IAnnotatedNode>> myArguments;
@@ -118,6 +122,7 @@ public:
     const AbstractType* GetType() const override;
 protected:
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     Pointer<IAnnotatedNode> myExpression;
@@ -173,6 +178,7 @@ public:
 protected:
     std::string GetName() const override;
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     Pointer<IAnnotatedNode> myExpression;
@@ -195,6 +201,7 @@ public:
 protected:
     std::string GetName() const override;
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     Pointer<IAnnotatedNode> myExpression;
@@ -202,7 +209,7 @@ private:
     Pointer<IAnnotatedNode> myElseBody;
 };
 
-class BlockNode : public AbstractNode, public virtual IAnnotatedNode {
+class BlockNode : public IAnnotatedNode {
 public:
     BlockNode(const Lexeme& lexeme, const UnitTypeSymbol* type);
 
@@ -217,6 +224,7 @@ public:
 protected:
     std::string GetName() const override;
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     std::vector<Pointer<IAnnotatedNode>> myStatements;
@@ -0,0 +1,182 @@
+#include "FlatTree.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "DeclarationNodes.h"
+#include "ExpressionNodes.h"
+#include "INodeVisitor.h"
+#include "StatementNodes.h"
+
+using AstFormat::NodeKind;
+
+class FlatTree::Builder : public INodeVisitor {
+public:
+    explicit Builder(FlatTree& tree) : myTree(tree) {}
+
+    // Typed overloads run first and name the node, the generic one appends it and visits the children
+    void EnterNode(const IVisitable& node) override {
+        int idx = myTree.myKinds.size();
+        int parent = myParents.empty() ? -1 : myParents.back();
+        auto annotatedNode = dynamic_cast<const IAnnotatedNode*>(myNode);
+
+        myTree.myKinds.push_back(myKind);
+        myTree.myParents.push_back(parent);
+        myTree.myFirstChildren.push_back(-1);
+        myTree.myNextSiblings.push_back(-1);
+        myTree.myDepths.push_back(myParents.size());
+        myTree.myLexemes.push_back(myNode->GetLexeme());
+        myTree.mySymbols.push_back(annotatedNode != nullptr ? annotatedNode->GetSymbol() : nullptr);
+        myTree.myTypes.push_back(annotatedNode != nullptr ? annotatedNode->GetType() : nullptr);
+        myTree.myNodes.push_back(myNode);
+
+        if (parent != -1) {
+            if (myLastChildren.back() == -1) {
+                myTree.myFirstChildren[parent] = idx;
+            } else {
+                myTree.myNextSiblings[myLastChildren.back()] = idx;
+            }
+            myLastChildren.back() = idx;
+        }
+
+        myParents.push_back(idx);
+        myLastChildren.push_back(-1);
+        INodeVisitor::EnterNode(node);
+        myParents.pop_back();
+        myLastChildren.pop_back();
+    }
+
+    void EnterNode(const IdentifierNode& node) override { Name(NodeKind::Identifier, node); }
+    void EnterNode(const IntegerNode& node) override { Name(NodeKind::Integer, node); }
+    void EnterNode(const DoubleNode& node) override { Name(NodeKind::Double, node); }
+    void EnterNode(const BooleanNode& node) override { Name(NodeKind::Boolean, node); }
+    void EnterNode(const StringNode& node) override { Name(NodeKind::String, node); }
+    void EnterNode(const TypeNode& node) override { Name(NodeKind::Type, node); }
+    void EnterNode(const BreakNode& node) override { Name(NodeKind::Break, node); }
+    void EnterNode(const ContinueNode& node) override { Name(NodeKind::Continue, node); }
+    void EnterNode(const ReturnNode& node) override { Name(NodeKind::Return, node); }
+    void EnterNode(const EmptyStatement& node) override { Name(NodeKind::EmptyStatement, node); }
+    void EnterNode(const Assignment& node) override { Name(NodeKind::Assignment, node); }
+    void EnterNode(const WhileNode& node) override { Name(NodeKind::While, node); }
+    void EnterNode(const DoWhileNode& node) override { Name(NodeKind::DoWhile, node); }
+    void EnterNode(const ForNode& node) override { Name(NodeKind::For, node); }
+    void EnterNode(const BinOperationNode& node) override { Name(NodeKind::BinOperation, node); }
+    void EnterNode(const UnaryPrefixOperationNode& node) override { Name(NodeKind::UnaryPrefixOperation, node); }
+    void EnterNode(const UnaryPostfixOperationNode& node) override { Name(NodeKind::UnaryPostfixOperation, node); }
+    void EnterNode(const CallArgumentsNode& node) override { Name(NodeKind::CallArguments, node); }
+    void EnterNode(const TypeArgumentsNode& node) override { Name(NodeKind::TypeArguments, node); }
+    void EnterNode(const IndexSuffixNode& node) override { Name(NodeKind::IndexSuffix, node); }
+    void EnterNode(const CallSuffixNode& node) override { Name(NodeKind::CallSuffix, node); }
+    void EnterNode(const MemberAccessNode& node) override { Name(NodeKind::MemberAccess, node); }
+    void EnterNode(const IfExpression& node) override { Name(NodeKind::If, node); }
+    void EnterNode(const BlockNode& node) override { Name(NodeKind::Block, node); }
+    void EnterNode(const DeclarationBlock& node) override { Name(NodeKind::DeclarationBlock, node); }
+    void EnterNode(const ClassDeclaration& node) override { Name(NodeKind::ClassDeclaration, node); }
+    void EnterNode(const ParameterNode& node) override { Name(NodeKind::Parameter, node); }
+    void EnterNode(const VariableNode& node) override { Name(NodeKind::Variable, node); }
+    void EnterNode(const ParameterList& node) override { Name(NodeKind::ParameterList, node); }
+    void EnterNode(const FunctionDeclaration& node) override { Name(NodeKind::FunctionDeclaration, node); }
+    void EnterNode(const PropertyDeclaration& node) override { Name(NodeKind::PropertyDeclaration, node); }
+
+private:
+    void Name(NodeKind kind, const ISyntaxNode& node) {
+        myKind = kind;
+        myNode = &node;
+    }
+
+    FlatTree& myTree;
+    NodeKind myKind = NodeKind::EmptyStatement;
+    const ISyntaxNode* myNode = nullptr;
+    std::vector<int> myParents;
+    std::vector<int> myLastChildren;
+};
+
+FlatTree::FlatTree(const ISyntaxNode& root) {
+    Builder builder(*this);
+    root.RunVisitor(builder);
+}
+
+int FlatTree::GetSize() const {
+    return myKinds.size();
+}
+
+NodeKind FlatTree::GetKind(int idx) const {
+    return myKinds[idx];
+}
+
+int FlatTree::GetParent(int idx) const {
+    return myParents[idx];
+}
+
+int FlatTree::GetFirstChild(int idx) const {
+    return myFirstChildren[idx];
+}
+
+int FlatTree::GetNextSibling(int idx) const {
+    return myNextSiblings[idx];
+}
+
+int FlatTree::GetDepth(int idx) const {
+    return myDepths[idx];
+}
+
+const Lexeme& FlatTree::GetLexeme(int idx) const {
+    return myLexemes[idx];
+}
+
+const ISymbol* FlatTree::GetSymbol(int idx) const {
+    return mySymbols[idx];
+}
+
+const AbstractType* FlatTree::GetType(int idx) const {
+    return myTypes[idx];
+}
+
+const ISyntaxNode& FlatTree::GetNode(int idx) const {
+    return *myNodes[idx];
+}
+
+std::vector<std::string> FlatTree::ToStrings(bool showSemantics) const {
+    const char LINK_CHAR = '|';
+    const char CHILD_CHAR = '|';
+
+    // Children follow their parent, so walking backwards finds every child's lines ready
+    std::vector<std::vector<std::string>> lines(myKinds.size());
+    for (int idx = static_cast<int>(myKinds.size()) - 1; idx >= 0; idx--) {
+        std::vector<std::string> childLines;
+        for (int child = myFirstChildren[idx]; child != -1; child = myNextSiblings[child]) {
+            std::move(lines[child].begin(), lines[child].end(), std::back_inserter(childLines));
+            lines[child] = std::vector<std::string>();
+        }
+
+        std::string res = myNodes[idx]->ToString();
+        if (showSemantics && mySymbols[idx] != nullptr) {
+            int spacingRequired = 60 - myDepths[idx] * 2 - res.size();
+            res.append(std::string(std::max(spacingRequired, 0), ' ') + ":: " + mySymbols[idx]->GetName());
+        }
+
+        std::vector<std::string>& nodeLines = lines[idx];
+        nodeLines.push_back(std::move(res));
+
+        size_t lastChild = 0;
+        for (size_t i = 0; i < childLines.size(); i++) {
+            char first = childLines[i][0];
+            if (first != LINK_CHAR && first != ' ' && first != CHILD_CHAR) {
+                lastChild = i;
+            }
+        }
+
+        for (size_t i = 0; i < childLines.size(); i++) {
+            char first = childLines[i][0];
+            if (i > lastChild) {
+                nodeLines.push_back("  " + childLines[i]);
+            } else if (first == LINK_CHAR || first == ' ' || first == CHILD_CHAR) {
+                nodeLines.push_back(std::string{ LINK_CHAR } + " " + childLines[i]);
+            } else {
+                nodeLines.push_back(std::string{ CHILD_CHAR } + "-" + childLines[i]);
+            }
+        }
+    }
+
+    return myKinds.empty() ? std::vector<std::string>() : std::move(lines[0]);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "AstFormat.h"
+#include "../Lexer/Lexeme.h"
+
+class AbstractType;
+class ISymbol;
+class ISyntaxNode;
+
+// Syntax tree laid out as parallel arrays in visiting order, a node's subtree directly follows it.
+// Passes that only need kinds, links, lexemes and annotations scan these arrays instead of chasing pointers
+class FlatTree {
+public:
+    explicit FlatTree(const ISyntaxNode& root);
+
+    int GetSize() const;
+
+    AstFormat::NodeKind GetKind(int idx) const;
+    int GetParent(int idx) const;
+    int GetFirstChild(int idx) const;
+    int GetNextSibling(int idx) const;
+    int GetDepth(int idx) const;
+    const Lexeme& GetLexeme(int idx) const;
+
+    // Semantics annotations of the node, nullptr for nodes without them
+    const ISymbol* GetSymbol(int idx) const;
+    const AbstractType* GetType(int idx) const;
+    const ISyntaxNode& GetNode(int idx) const;
+
+    // Same lines as CuteToStringVisitor run on the tree
+    std::vector<std::string> ToStrings(bool showSemantics) const;
+
+private:
+    class Builder;
+
+    std::vector<AstFormat::NodeKind> myKinds;
+    std::vector<int> myParents;
+    std::vector<int> myFirstChildren;
+    std::vector<int> myNextSiblings;
+    std::vector<int> myDepths;
+    std::vector<Lexeme> myLexemes;
+    std::vector<const ISymbol*> mySymbols;
+    std::vector<const AbstractType*> myTypes;
+    std::vector<const ISyntaxNode*> myNodes;
+};
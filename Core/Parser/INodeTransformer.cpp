@@ -0,0 +1,14 @@
+#include "INodeTransformer.h"
+
+INodeTransformer::~INodeTransformer() = default;
+
+Pointer<IAnnotatedNode> INodeTransformer::Transform(Pointer<IAnnotatedNode> node) {
+    if (node != nullptr) {
+        node->PropagateTransformer(*this);
+    }
+    return node;
+}
+
+void INodeTransformer::Transform(ISyntaxNode& node) {
+    node.PropagateTransformer(*this);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "ISyntaxNode.h"
+
+// Rewrites a syntax tree in place. Nodes hand every expression they own to Transform and keep
+// the node it returns, children that can't be replaced are transformed in place
+class INodeTransformer {
+public:
+    virtual ~INodeTransformer();
+
+    virtual Pointer<IAnnotatedNode> Transform(Pointer<IAnnotatedNode> node);
+    virtual void Transform(ISyntaxNode& node);
+};
@@ -4,6 +4,8 @@ std::string ISyntaxNode::ToString() const {
     return GetName();
 }
 
+void ISyntaxNode::PropagateTransformer(INodeTransformer& transformer) {}
+
 AbstractNode::AbstractNode(const Lexeme& lexeme) : myLexeme(lexeme) {}
 
 AbstractNode::AbstractNode(AbstractNode&& src) noexcept {}
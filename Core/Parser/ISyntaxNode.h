@@ -3,16 +3,21 @@
 #include "IVisitable.h"
 #include "Semantics/Symbols.h"
 
+class INodeTransformer;
+
 class ISyntaxNode : public IVisitable {
 public:
+    friend class INodeTransformer;
+
     std::string ToString() const override;
     virtual Lexeme GetLexeme() const = 0;
 
 protected:
     virtual std::string GetName() const = 0;
+    virtual void PropagateTransformer(INodeTransformer& transformer);
 };
 
-class AbstractNode : public virtual ISyntaxNode {
+class AbstractNode : public ISyntaxNode {
 public:
     AbstractNode(const Lexeme& lexeme);
     AbstractNode(const AbstractNode& src) = delete;
@@ -24,8 +29,10 @@ private:
     Lexeme myLexeme;
 };
 
-class IAnnotatedNode : public virtual ISyntaxNode {
+class IAnnotatedNode : public AbstractNode {
 public:
+    using AbstractNode::AbstractNode;
+
     virtual const ISymbol* GetSymbol() const = 0;
     virtual const AbstractType* GetType() const;
     virtual bool IsAssignable() const;
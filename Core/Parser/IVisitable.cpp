@@ -1,8 +1,17 @@
 #include "IVisitable.h"
 #include "INodeVisitor.h"
+#include "../Arena.h"
 
 IVisitable::~IVisitable() = default;
 
+void* IVisitable::operator new(std::size_t size) {
+    return Arena::AllocateObject(size);
+}
+
+void IVisitable::operator delete(void* object) {
+    Arena::DeallocateObject(object);
+}
+
 void IVisitable::RunVisitor(INodeVisitor & visitor) const {
     visitor.EnterNode(*this);
     visitor.ExitNode(*this);
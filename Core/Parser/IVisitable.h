@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <string>
 
 class INodeVisitor;
@@ -7,6 +8,9 @@ class IVisitable {
 public:
     virtual ~IVisitable();
 
+    static void* operator new(std::size_t size);
+    static void operator delete(void* object);
+
     friend class INodeVisitor;
 
     virtual std::string ToString() const = 0;
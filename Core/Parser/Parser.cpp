@@ -22,7 +22,11 @@ const SymbolTable& Parser::GetSymbolTable() const {
 }
 
 Pointer<DeclarationBlock> Parser::Parse() {
-    return ParseDeclarations(false);
+    EnterFrame();
+    Pointer<DeclarationBlock> declarations = ParseDeclarations(false);
+    int depth = GetDepth();
+    declarations->SetFrame(depth, LeaveFrame());
+    return declarations;
 }
 
 const std::vector<ParserError>& Parser::GetParsingErrors() const {
@@ -43,17 +47,17 @@ Pointer<DeclarationBlock> Parser::ParseDeclarations(bool isClass) {
         if (RequireLexeme(LexemeType::Keyword,
                           (isClass ? "Expecting member declaration" : "Expecting a top level declaration"))
         ) {
-            std::string keyword = curLexeme.GetValue<std::string>();
+            Keyword keyword = curLexeme.GetKeyword();
 
-            if (keyword == "class") {
+            if (keyword == Keyword::Class) {
                 if (isClass) {
                     AddParsingError(myLexer.GetLexeme(), "Class is not allowed here");
                 } else {
                     declarations->AddDeclaration(ParseClass());
                 }
-            } else if (keyword == "fun") {
+            } else if (keyword == Keyword::Fun) {
                 declarations->AddDeclaration(ParseFunction());
-            } else if (keyword == "var" || keyword == "val") {
+            } else if (keyword == Keyword::Var || keyword == Keyword::Val) {
                 declarations->AddDeclaration(ParseProperty(curLexeme));
             } else {
                 AddParsingError(curLexeme, "Unsupported keyword");
@@ -76,13 +80,17 @@ Pointer<ClassDeclaration> Parser::ParseClass() {
     SymbolsFrame frame(&myTable);
 
     if (AcceptLexeme(LexemeType::LCurl)) {
-        classDecl->SetBody(ParseDeclarations(true));
+        EnterFrame();
+        Pointer<DeclarationBlock> body = ParseDeclarations(true);
+        int depth = GetDepth();
+        body->SetFrame(depth, LeaveFrame());
+        classDecl->SetBody(std::move(body));
         RequireLexeme(LexemeType::RCurl, "Expecting '}'");
     }
 
     Pointer<ClassSymbol> classSym = std::make_unique<ClassSymbol>(classDecl->GetIdentifierName(), frame.Dispose());
     const ISymbol* sym = myTable->Add(std::move(classSym));
-    if (*sym == UnresolvedSymbol(myRootTable)) {
+    if (dynamic_cast<const UnresolvedSymbol*>(sym) != nullptr) {
         AddSemanticsError(classDecl->GetIdentifier().GetLexeme(), "Conflicting declarations: " + classDecl->GetIdentifierName());
     } else {
         Pointer<FunctionSymbol> constructor = std::make_unique<FunctionSymbol>(classDecl->GetIdentifierName(),
@@ -98,6 +106,7 @@ Pointer<ClassDeclaration> Parser::ParseClass() {
 Pointer<FunctionDeclaration> Parser::ParseFunction() {
     Pointer<IdentifierNode> identifier = ParseIdentifier("Function declaration must have a name");
     SymbolsFrame tableFrame(&myTable);
+    EnterFrame();
 
     Pointer<ParameterList> paramsNode = ParseParameters();
     Pointer<TypeNode> returnNode;
@@ -140,10 +149,14 @@ Pointer<FunctionDeclaration> Parser::ParseFunction() {
         AddSemanticsError(functionDecl->GetBody().GetLexeme(), myReturns.top()->GetName() + " does not conform to the expected type " + returnType->GetName());
     }
 
+    int depth = GetDepth();
+    functionDecl->SetFrame(depth, LeaveFrame());
+
     if (dynamic_cast<FunctionSymbol*>(sym)) {
         dynamic_cast<FunctionSymbol*>(sym)->SetTable(tableFrame.Dispose());
     } else {
-        tableFrame.Dispose();
+        Pointer<SymbolTable> table = tableFrame.Dispose();
+        myTable->Discard(std::move(table));
     }
 
     myReturns.pop();
@@ -189,8 +202,9 @@ Pointer<ParameterNode> Parser::ParseParameter() {
     }
 
     Pointer<VariableSymbol> paramSymbol = std::make_unique<VariableSymbol>(identifier->GetIdentifier(), typeNode->GetType(), false);
-    const ISymbol* resSym = myTable->Add(std::move(paramSymbol));
+    ISymbol* resSym = myTable->Add(std::move(paramSymbol));
     CheckUnresolvedType(resSym, "Conflicting declarations: " + identifier->GetIdentifier(), curLexeme);
+    AllocateSlot(resSym);
 
     Pointer<ParameterNode> param = std::make_unique<ParameterNode>(std::move(identifier), myRootTable->GetUnitSymbol(), std::move(typeNode));
     param->SetSymbol(resSym);
@@ -238,40 +252,40 @@ Pointer<IAnnotatedNode> Parser::ParseStatement() {
     Lexeme curLexeme = myLexer.GetLexeme();
     wasError = false;
 
-    if (AcceptLexeme(LexemeType::Keyword, "val") || AcceptLexeme(LexemeType::Keyword, "var")) {
+    if (AcceptKeyword(Keyword::Val) || AcceptKeyword(Keyword::Var)) {
         return ParseProperty(curLexeme);
     }
-    if (AcceptLexeme(LexemeType::Keyword, "fun")) {
+    if (AcceptKeyword(Keyword::Fun)) {
         return ParseFunction();
     }
-    if (AcceptLexeme(LexemeType::Keyword, "class")) {
+    if (AcceptKeyword(Keyword::Class)) {
         return ParseClass();
     }
-    if (AcceptLexeme(LexemeType::Keyword, "for")) {
+    if (AcceptKeyword(Keyword::For)) {
         return ParseForLoop(curLexeme);
     } 
-    if (AcceptLexeme(LexemeType::Keyword, "while")) {
+    if (AcceptKeyword(Keyword::While)) {
         return ParseWhileLoop(curLexeme);
     } 
-    if (AcceptLexeme(LexemeType::Keyword, "do")) {
+    if (AcceptKeyword(Keyword::Do)) {
         return ParseDoWhileLoop(curLexeme);
     }
-    if (AcceptLexeme(LexemeType::Keyword, "if")) {
+    if (AcceptKeyword(Keyword::If)) {
         return ParseIfExpression(curLexeme);
     }
-    if (AcceptLexeme(LexemeType::Keyword, "break")) {
+    if (AcceptKeyword(Keyword::Break)) {
         if (inLoop == 0) {
             AddParsingError(curLexeme, "'break' and 'continue' are only allowed inside loop");
         }
         return CreateLexemeNode<BreakNode, UnitTypeSymbol>(curLexeme, myRootTable->GetUnitSymbol());
     }
-    if (AcceptLexeme(LexemeType::Keyword, "continue")) {
+    if (AcceptKeyword(Keyword::Continue)) {
         if (inLoop == 0) {
             AddParsingError(curLexeme, "'break' and 'continue' are only allowed inside loop");
         }
         return CreateLexemeNode<ContinueNode, UnitTypeSymbol>(curLexeme, myRootTable->GetUnitSymbol());
     }
-    if (AcceptLexeme(LexemeType::Keyword, "return")) {
+    if (AcceptKeyword(Keyword::Return)) {
         Pointer<ReturnNode> returnNode = CreateLexemeNode<ReturnNode, UnitTypeSymbol>(curLexeme, myRootTable->GetUnitSymbol());
         Lexeme nextLexeme = myLexer.GetLexeme();
         if (nextLexeme.GetRow() == curLexeme.GetRow() && nextLexeme.GetType() != LexemeType::RCurl
@@ -332,6 +346,7 @@ Pointer<IAnnotatedNode> Parser::ParseControlStructureBody(bool acceptSemicolons
 Pointer<ForNode> Parser::ParseForLoop(const Lexeme& lexeme) {
     inLoop++;
     SymbolsFrame forFrame(&myTable);
+    int scope = EnterScope();
 
     RequireLexeme(LexemeType::LParen, "Expecting '(' to open a loop range");
     Pointer<VariableNode> variable = ParseVariable();
@@ -346,7 +361,9 @@ Pointer<ForNode> Parser::ParseForLoop(const Lexeme& lexeme) {
     }
 
     const AbstractType* underlyingType = (iterable == nullptr ? myRootTable->GetUnresolvedSymbol() : iterable->GetType());
-    variable->SetSymbol(myTable->Add(std::make_unique<VariableSymbol>(variable->GetIdentifierName(), underlyingType, false)));
+    ISymbol* variableSym = myTable->Add(std::make_unique<VariableSymbol>(variable->GetIdentifierName(), underlyingType, false));
+    AllocateSlot(variableSym);
+    variable->SetSymbol(variableSym);
 
     {
         SymbolsFrame tableFrame(&myTable);
@@ -355,6 +372,7 @@ Pointer<ForNode> Parser::ParseForLoop(const Lexeme& lexeme) {
         body = ParseControlStructureBody();
     }
 
+    LeaveScope(scope);
     inLoop--;
     return std::make_unique<ForNode>(lexeme, std::move(expr), std::move(body), std::move(variable), myRootTable->GetUnitSymbol());
 }
@@ -363,6 +381,7 @@ Pointer<ForNode> Parser::ParseForLoop(const Lexeme& lexeme) {
 Pointer<WhileNode> Parser::ParseWhileLoop(const Lexeme& lexeme) {
     inLoop++;
     SymbolsFrame tableFrame(&myTable);
+    int scope = EnterScope();
 
     RequireLexeme(LexemeType::LParen, "Expecting '('");
     Pointer<IAnnotatedNode> expr = ParseExpression();
@@ -370,6 +389,7 @@ Pointer<WhileNode> Parser::ParseWhileLoop(const Lexeme& lexeme) {
     RequireLexeme(LexemeType::RParen, "Expecting ')'");
     Pointer<ISyntaxNode> body = ParseControlStructureBody(true);
 
+    LeaveScope(scope);
     inLoop--;
     return std::make_unique<WhileNode>(lexeme, std::move(expr), std::move(body), myRootTable->GetUnitSymbol());
 }
@@ -378,15 +398,17 @@ Pointer<WhileNode> Parser::ParseWhileLoop(const Lexeme& lexeme) {
 Pointer<DoWhileNode> Parser::ParseDoWhileLoop(const Lexeme& lexeme) {
     inLoop++;
     SymbolsFrame tableFrame(&myTable);
+    int scope = EnterScope();
 
     Pointer<ISyntaxNode> body = ParseControlStructureBody();
-    RequireLexeme(LexemeType::Keyword, "while", "Expecting 'while' followed by a post-condition");
+    RequireKeyword(Keyword::While, "Expecting 'while' followed by a post-condition");
     RequireLexeme(LexemeType::LParen, "Expecting '('");
 
     Pointer<IAnnotatedNode> expr = ParseExpression();
     CheckType<BooleanSymbol>(expr->GetType(), expr->GetLexeme());
     RequireLexeme(LexemeType::RParen, "Expecting ')'");
 
+    LeaveScope(scope);
     inLoop--;
     return std::make_unique<DoWhileNode>(lexeme, std::move(expr), std::move(body), myRootTable->GetUnitSymbol());
 }
@@ -449,8 +471,9 @@ Pointer<PropertyDeclaration> Parser::ParseProperty(const Lexeme& keyword) {
     auto propertySym = std::make_unique<VariableSymbol>(propertyDecl->GetIdentifierName(),
         myTable->GetType(propertyDecl->GetInitialization().GetType()->GetName()), propertyDecl->IsMutable());
 
-    const ISymbol* sym = myTable->Add(std::move(propertySym));
+    ISymbol* sym = myTable->Add(std::move(propertySym));
     CheckUnresolvedType(sym, "Conflicting declarations: " + propertyDecl->GetIdentifierName(), propertyDecl->GetIdentifier().GetLexeme());
+    AllocateSlot(sym);
 
     propertyDecl->SetSymbol(sym);
     return propertyDecl;
@@ -461,7 +484,7 @@ Pointer<VariableNode> Parser::ParseVariable() {
     Pointer<VariableNode> variable = std::make_unique<VariableNode>(ParseIdentifier("Expecting a variable name"), myRootTable->GetUnitSymbol());
     if (AcceptLexeme(LexemeType::OpColon)) {;
         variable->SetTypeNode(ParseType());
-        if (*variable->GetTypeNode().GetType() != IntegerSymbol(myRootTable)) {
+        if (variable->GetTypeNode().GetType() != myRootTable->GetIntegerSymbol()) {
             AddParsingError(myLexer.GetLexeme(), "The loop iterates over values of type Int but the parameter is declared to be " + variable->GetTypeNode().GetType()->GetName());
         }
     }
@@ -475,7 +498,7 @@ Pointer<IdentifierNode> Parser::ParseIdentifier(const std::string& errorMessage)
         curLexeme = curLexeme.CopyEmptyOfType(LexemeType::Identifier);
     }
 
-    Pointer<IdentifierNode> identifier = CreateLexemeNode(curLexeme, myRootTable->GetUnresolvedSymbol(), myTable->GetSymbols(curLexeme.GetText()));
+    Pointer<IdentifierNode> identifier = CreateLexemeNode(curLexeme, myRootTable->GetUnresolvedSymbol(), myTable->Lookup(curLexeme.GetId()));
     RequireLexeme(LexemeType::Identifier, errorMessage);
     return identifier;
 }
@@ -507,20 +530,13 @@ Pointer<IAnnotatedNode> Parser::ParseLeftAssociative(size_t priority) {
 
         const AbstractType* leftType = leftOperand->GetType();
         const AbstractType* rightType = rightOperand->GetType();
-        Pointer<AbstractType> resultType = std::make_unique<UnresolvedSymbol>(myRootTable);
+        const AbstractType* resultType = myRootTable->GetUnresolvedSymbol();
 
         if (leftType != nullptr && rightType != nullptr) {
             resultType = IsApplicable(operation.GetType(), leftType, rightType);
         }
 
-        std::string typeName = resultType->GetName();
-
-        if (dynamic_cast<ArraySymbol*>(resultType.get()) != nullptr || dynamic_cast<RangeSymbol*>(resultType.get()) != nullptr) {
-            myRootTable->Add(std::move(resultType));    
-        }
-
-        leftOperand = std::make_unique<BinOperationNode>(
-            operation, std::move(leftOperand), std::move(rightOperand), myTable->GetType(typeName));
+        leftOperand = std::make_unique<BinOperationNode>(operation, std::move(leftOperand), std::move(rightOperand), resultType);
         operation = myLexer.GetLexeme();
     }
 
@@ -533,12 +549,12 @@ Pointer<IAnnotatedNode> Parser::ParsePrefix() {
 
     if (AcceptLexeme({ LexemeType::OpSub, LexemeType::OpAdd, LexemeType::OpInc, LexemeType::OpDec, LexemeType::OpExclMark })) {
         Pointer<IAnnotatedNode> prefix = ParsePrefix();
-        Pointer<AbstractType> resultType = IsApplicable(curLexeme.GetType(), prefix->GetType());
+        const AbstractType* resultType = IsApplicable(curLexeme.GetType(), prefix->GetType());
         if ((curLexeme.GetType() == LexemeType::OpInc || curLexeme.GetType() == LexemeType::OpDec) && !prefix->IsAssignable()) {
             AddSemanticsError(curLexeme, "Val cannot be reassigned");
         }
 
-        return std::make_unique<UnaryPrefixOperationNode>(curLexeme, std::move(prefix), myTable->GetType(resultType->GetName()));
+        return std::make_unique<UnaryPrefixOperationNode>(curLexeme, std::move(prefix), resultType);
     }
 
     return ParsePostfix();
@@ -553,12 +569,12 @@ Pointer<IAnnotatedNode> Parser::ParsePostfix() {
     while (ParserUtils::PostfixOperations.count(curLexeme.GetType()) || curLexeme.GetType() == LexemeType::OpLess && ParserUtils::IsGenericIdentifier(operand.get())) {
         // Postfix operation
         if (AcceptLexeme(LexemeType::OpInc) || AcceptLexeme(LexemeType::OpDec)) {
-            Pointer<AbstractType> resultType = IsApplicable(curLexeme.GetType(), operand->GetType());
+            const AbstractType* resultType = IsApplicable(curLexeme.GetType(), operand->GetType());
             if (!operand->IsAssignable()) {
                 AddSemanticsError(curLexeme, "Val cannot be reassigned");
             }
 
-            operand = std::make_unique<UnaryPostfixOperationNode>(curLexeme, std::move(operand), myTable->GetType(resultType->GetName()));
+            operand = std::make_unique<UnaryPostfixOperationNode>(curLexeme, std::move(operand), resultType);
         } else if (AcceptLexeme(LexemeType::OpDot)) {
             operand = ParseMemberAccess(curLexeme, std::move(operand));
 
@@ -643,9 +659,8 @@ Pointer<MemberAccessNode> Parser::ParseMemberAccess(const Lexeme& operationLexem
         if (identifier != nullptr) {
             identifier->TryResolveVariable();
         }
-        std::vector<const ISymbol*> candidates = operand->GetType()->GetTable()->GetSymbols(curLexeme.GetValue<std::string>());
-
-        Pointer<IdentifierNode> memberIdentifier = CreateLexemeNode(curLexeme, myRootTable->GetUnresolvedSymbol(), candidates);
+        Pointer<IdentifierNode> memberIdentifier = CreateLexemeNode(curLexeme, myRootTable->GetUnresolvedSymbol(),
+                                                                    operand->GetType()->GetTable()->Lookup(curLexeme.GetId()));
         memberIdentifier->TryResolveVariable();
         member = std::move(memberIdentifier);
     }
@@ -692,11 +707,11 @@ Pointer<CallArgumentsNode> Parser::ParseArguments(LexemeType rParen) {
 Pointer<IAnnotatedNode> Parser::ParsePrimary() {
     const Lexeme curLexeme = myLexer.GetLexeme();
 
-    if (AcceptLexeme(LexemeType::Keyword, "true") || AcceptLexeme(LexemeType::Keyword, "false")) {
-        Pointer<BooleanNode> node = CreateLexemeNode<BooleanNode>(curLexeme, myTable->GetType(BooleanSymbol(myRootTable).GetName()));
+    if (AcceptKeyword(Keyword::True) || AcceptKeyword(Keyword::False)) {
+        Pointer<BooleanNode> node = CreateLexemeNode<BooleanNode>(curLexeme, myRootTable->GetBooleanSymbol());
         return node;
     }
-    if (AcceptLexeme(LexemeType::Keyword, "if")) {
+    if (AcceptKeyword(Keyword::If)) {
         Pointer<IfExpression> ifExpr = ParseIfExpression(curLexeme);
 
         if (*ifExpr->GetType() == *myRootTable->GetUnitSymbol()) {
@@ -712,20 +727,20 @@ Pointer<IAnnotatedNode> Parser::ParsePrimary() {
     }
     if (AcceptLexeme(LexemeType::Identifier)) {
         Pointer<IdentifierNode> node = CreateLexemeNode(curLexeme,
-            myRootTable->GetUnresolvedSymbol(), myTable->GetSymbols(curLexeme.GetValue<std::string>()));
+            myRootTable->GetUnresolvedSymbol(), myTable->Lookup(curLexeme.GetId()));
         node->TryResolveVariable();
         return node;
     }
 
     myLexer.NextLexeme();
     if (LexerUtils::IsIntegerType(curLexeme.GetType())) {
-        return CreateLexemeNode<IntegerNode>(curLexeme, myTable->GetType(IntegerSymbol(myRootTable).GetName()));;
+        return CreateLexemeNode<IntegerNode>(curLexeme, myRootTable->GetIntegerSymbol());;
     }
     if (LexerUtils::IsRealType(curLexeme.GetType())) {
-        return CreateLexemeNode<DoubleNode>(curLexeme, myTable->GetType(DoubleSymbol(myRootTable).GetName()));;
+        return CreateLexemeNode<DoubleNode>(curLexeme, myRootTable->GetDoubleSymbol());;
     }
     if (curLexeme.GetType() == LexemeType::String || curLexeme.GetType() == LexemeType::RawString) {
-        return CreateLexemeNode<StringNode>(curLexeme, myTable->GetType(StringSymbol(myRootTable).GetName()));;
+        return CreateLexemeNode<StringNode>(curLexeme, myRootTable->GetStringSymbol());;
     }
 
     AddParsingError(curLexeme, "Unexpected lexeme");
@@ -739,30 +754,62 @@ Pointer<IfExpression> Parser::ParseIfExpression(const Lexeme& lexeme) {
     CheckType<BooleanSymbol>(expression->GetType(), expression->GetLexeme());
     RequireLexeme(LexemeType::RParen, "Expecting ')'");
 
-    Pointer<SymbolTable> currentTable = std::make_unique<SymbolTable>(myTable);
-    myTable = currentTable.get();
+    SymbolsFrame tableFrame(&myTable);
+    int scope = EnterScope();
 
     Pointer<IAnnotatedNode> ifBody = CreateEmptyStatement(myLexer.GetLexeme());
     Pointer<IAnnotatedNode> elseBody = CreateEmptyStatement(myLexer.GetLexeme());
 
-    if (AcceptLexeme(LexemeType::Keyword, "else")) {
+    if (AcceptKeyword(Keyword::Else)) {
         elseBody = ParseControlStructureBody(true);
     } else {
         ifBody = ParseControlStructureBody(true);
 
-        if (AcceptLexeme(LexemeType::Keyword, "else")) {
+        if (AcceptKeyword(Keyword::Else)) {
             elseBody = ParseControlStructureBody(true);
         }
     }
 
-    myTable = myTable->GetParent();
-    myTable->Add(std::move(currentTable));
+    LeaveScope(scope);
 
     return std::make_unique<IfExpression>(lexeme, myRootTable->GetUnitSymbol(), std::move(expression), std::move(ifBody), std::move(elseBody));
 }
 
+void Parser::EnterFrame() {
+    myFrames.emplace_back();
+}
+
+int Parser::LeaveFrame() {
+    int size = myFrames.back().mySize;
+    myFrames.pop_back();
+    return size;
+}
+
+int Parser::GetDepth() const {
+    return myFrames.size() - 1;
+}
+
+int Parser::EnterScope() {
+    return myFrames.back().myNextSlot;
+}
+
+void Parser::LeaveScope(int scope) {
+    myFrames.back().myNextSlot = scope;
+}
+
+void Parser::AllocateSlot(ISymbol* symbol) {
+    auto varSym = dynamic_cast<VariableSymbol*>(symbol);
+    if (varSym == nullptr) {
+        return;
+    }
+
+    FrameLayout& frame = myFrames.back();
+    varSym->SetSlot(GetDepth(), frame.myNextSlot++);
+    frame.mySize = std::max(frame.mySize, frame.myNextSlot);
+}
+
 Pointer<IdentifierNode> Parser::CreateEmptyIdentifier(const Lexeme& lexeme) const {
-    return std::make_unique<IdentifierNode>(lexeme.CopyEmptyOfType(LexemeType::Error), myRootTable->GetUnresolvedSymbol(), std::vector<const ISymbol*>());
+    return std::make_unique<IdentifierNode>(lexeme.CopyEmptyOfType(LexemeType::Error), myRootTable->GetUnresolvedSymbol(), SymbolLookup());
 }
 
 void Parser::AddParsingError(const Lexeme& location, const std::string& error) {
@@ -787,13 +834,14 @@ bool Parser::RequireLexeme(LexemeType lexemeType, const std::string& error) {
     return true;
 }
 
-bool Parser::RequireLexeme(LexemeType lexemeType, const std::string& text, const std::string& error) {
-    if (myLexer.GetLexeme().GetText() != text) {
+bool Parser::RequireKeyword(Keyword keyword, const std::string& error) {
+    if (myLexer.GetLexeme().GetKeyword() != keyword) {
         AddParsingError(myLexer.GetLexeme(), error);
         return false;
     }
 
-    return RequireLexeme(lexemeType, error);
+    myLexer.NextLexeme();
+    return true;
 }
 
 void Parser::ConsumeSemicolons() {
@@ -806,20 +854,20 @@ Pointer<EmptyStatement> Parser::CreateEmptyStatement(const Lexeme& lexeme) {
     return std::make_unique<EmptyStatement>(lexeme, myRootTable->GetUnitSymbol());
 }
 
-Pointer<AbstractType> Parser::IsApplicable(LexemeType operation, const AbstractType* left, const AbstractType* right) {
-    Pointer<AbstractType> res = left->IsApplicable(operation, right);
-    CheckUnresolvedType(res.get(), "Operation is not applicable to types " + left->GetName() + " and " + right->GetName(), myLexer.GetLexeme());
+const AbstractType* Parser::IsApplicable(LexemeType operation, const AbstractType* left, const AbstractType* right) {
+    const AbstractType* res = left->IsApplicable(operation, right);
+    CheckUnresolvedType(res, "Operation is not applicable to types " + left->GetName() + " and " + right->GetName(), myLexer.GetLexeme());
     return res;
 }
 
-Pointer<AbstractType> Parser::IsApplicable(LexemeType operation, const AbstractType* left) {
-    Pointer<AbstractType> res = left->IsApplicable(operation);
-    CheckUnresolvedType(res.get(), "Operation is not applicable to type " + left->GetName(), myLexer.GetLexeme());
+const AbstractType* Parser::IsApplicable(LexemeType operation, const AbstractType* left) {
+    const AbstractType* res = left->IsApplicable(operation);
+    CheckUnresolvedType(res, "Operation is not applicable to type " + left->GetName(), myLexer.GetLexeme());
     return res;
 }
 
 const ISymbol* Parser::CheckUnresolvedType(const ISymbol* symbol, const std::string& error, const Lexeme& lexeme) {
-    if (*symbol == UnresolvedSymbol(myRootTable)) {
+    if (dynamic_cast<const UnresolvedSymbol*>(symbol) != nullptr) {
         AddSemanticsError(lexeme, error);
     }
     return symbol;
@@ -833,8 +881,8 @@ bool Parser::AcceptLexeme(LexemeType lexType) {
     return false;
 }
 
-bool Parser::AcceptLexeme(LexemeType lexType, const std::string& text) {
-    if (myLexer.GetLexeme().GetType() == lexType && myLexer.GetLexeme().GetText() == text) {
+bool Parser::AcceptKeyword(Keyword keyword) {
+    if (myLexer.GetLexeme().GetKeyword() == keyword) {
         myLexer.NextLexeme();
         return true;
     }
@@ -61,17 +61,24 @@ private:
 
     Pointer<IfExpression> ParseIfExpression(const Lexeme& lexeme);
 
+    void EnterFrame();
+    int LeaveFrame();
+    int GetDepth() const;
+    int EnterScope();
+    void LeaveScope(int scope);
+    void AllocateSlot(ISymbol* symbol);
+
     Pointer<IdentifierNode> CreateEmptyIdentifier(const Lexeme& lexeme) const;
     void AddParsingError(const Lexeme& location, const std::string& error);
     void AddSemanticsError(const Lexeme& location, const std::string& error);
 
     bool RequireLexeme(LexemeType lexemeType, const std::string& error);
-    bool RequireLexeme(LexemeType lexemeType, const std::string& text, const std::string& error);
+    bool RequireKeyword(Keyword keyword, const std::string& error);
     void ConsumeSemicolons();
 
     Pointer<EmptyStatement> CreateEmptyStatement(const Lexeme& lexeme);
-    Pointer<AbstractType> IsApplicable(LexemeType operation, const AbstractType* left, const AbstractType* right);
-    Pointer<AbstractType> IsApplicable(LexemeType operation, const AbstractType* left);
+    const AbstractType* IsApplicable(LexemeType operation, const AbstractType* left, const AbstractType* right);
+    const AbstractType* IsApplicable(LexemeType operation, const AbstractType* left);
 
     const ISymbol* CheckUnresolvedType(const ISymbol* symbol, const std::string& error, const Lexeme& lexeme);
 
@@ -86,8 +93,8 @@ private:
     }
 
     bool AcceptLexeme(LexemeType lexType);
-    bool AcceptLexeme(LexemeType lexType, const std::string& text);
     bool AcceptLexeme(std::initializer_list<LexemeType> lexTypes);
+    bool AcceptKeyword(Keyword keyword);
     
 
     template<typename T>
@@ -108,8 +115,8 @@ private:
         return node;
     }
 
-    Pointer<IdentifierNode> CreateLexemeNode(const Lexeme& lexeme, const AbstractType* type, const std::vector<const ISymbol*>& candidates) {
-        Pointer<IdentifierNode> node = std::make_unique<IdentifierNode>(lexeme, type, candidates);
+    Pointer<IdentifierNode> CreateLexemeNode(const Lexeme& lexeme, const AbstractType* type, SymbolLookup candidates) {
+        Pointer<IdentifierNode> node = std::make_unique<IdentifierNode>(lexeme, type, std::move(candidates));
         if (lexeme.IsError()) {
             AddParsingError(lexeme, lexeme.GetValue<std::string>());
         }
@@ -123,6 +130,12 @@ private:
     std::vector<ParserError> mySemanticsErrors;
     bool wasError = false;
 
+    struct FrameLayout {
+        int myNextSlot = 0;
+        int mySize = 0;
+    };
+
     std::stack<const AbstractType*> myReturns;
+    std::vector<FrameLayout> myFrames;
     int inLoop = 0;
 };
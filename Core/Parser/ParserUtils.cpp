@@ -56,17 +56,11 @@ const ISymbol* ParserUtils::GetArrayBuilder(const AbstractType* innerType, std::
         }
     }
 
-    Pointer<FunctionSymbol> arrayInitFunc = std::make_unique<FunctionSymbol>("arrayOf", arr, argsTypes,
-        std::make_unique<SymbolTable>(symTable), nullptr);
-    symTable->Add(std::move(arrayInitFunc));
-    return symTable->GetFunction("arrayOf", argsTypes);
+    return symTable->GetArrayBuilder(arr, argsTypes.size());
 }
 
 const ArraySymbol* ParserUtils::GetGenericArray(const AbstractType* innerType, SymbolTable* symTable) {
-    Pointer<ArraySymbol> arrayType = std::make_unique<ArraySymbol>(symTable, innerType);
-    std::string arrayTypeName = arrayType->GetName();
-    symTable->Add(std::move(arrayType));
-    return dynamic_cast<const ArraySymbol*>(symTable->GetType(arrayTypeName));
+    return symTable->GetArraySymbol(innerType);
 }
 
 bool ParserUtils::IsGenericIdentifier(const IAnnotatedNode* node) {
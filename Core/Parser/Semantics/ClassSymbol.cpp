@@ -4,16 +4,16 @@
 
 ClassSymbol::ClassSymbol(const std::string& name, Pointer<SymbolTable> table) : AbstractType(name, std::move(table)) {}
 
-Pointer<AbstractType> ClassSymbol::IsApplicable(LexemeType operation) const {
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+const AbstractType* ClassSymbol::IsApplicable(LexemeType operation) const {
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
-Pointer<AbstractType> ClassSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
+const AbstractType* ClassSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
     if (*this == *rightOperand && LexerUtils::IsEqualityOperation(binaryOperation)) {
-        return std::make_unique<BooleanSymbol>(GetParentTable());
+        return GetParentTable()->GetBooleanSymbol();
     }
 
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
 std::string ClassSymbol::ToString() const {
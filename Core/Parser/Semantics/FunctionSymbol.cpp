@@ -37,6 +37,10 @@ const AbstractDeclaration* FunctionSymbol::GetDeclaration() const {
     return myDeclaration;
 }
 
+void FunctionSymbol::SetDeclaration(const AbstractDeclaration* decl) {
+    myDeclaration = decl;
+}
+
 void FunctionSymbol::SetTable(Pointer<SymbolTable> table) {
     myTable = std::move(table);
 }
@@ -22,6 +22,7 @@ public:
     bool CheckArgument(const AbstractType& type, int idx);
 
     const AbstractDeclaration* GetDeclaration() const;
+    void SetDeclaration(const AbstractDeclaration* decl);
 
     void SetTable(Pointer<SymbolTable> table);
 
@@ -15,28 +15,28 @@ void FundamentalType::CreateCast(const std::string& castName, const AbstractType
 
 UnresolvedSymbol::UnresolvedSymbol(SymbolTable* parentTable) : FundamentalType("Unresolved type", parentTable) {}
 
-Pointer<AbstractType> UnresolvedSymbol::IsApplicable(LexemeType operation) const {
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+const AbstractType* UnresolvedSymbol::IsApplicable(LexemeType operation) const {
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
-Pointer<AbstractType> UnresolvedSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+const AbstractType* UnresolvedSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
 UnitTypeSymbol::UnitTypeSymbol(SymbolTable* parentTable) : FundamentalType("Unit", parentTable) {}
 
-Pointer<AbstractType> UnitTypeSymbol::IsApplicable(LexemeType operation) const {
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+const AbstractType* UnitTypeSymbol::IsApplicable(LexemeType operation) const {
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
-Pointer<AbstractType> UnitTypeSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
+const AbstractType* UnitTypeSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
     if (*rightOperand == *this) {
         if (LexerUtils::IsEqualityOperation(binaryOperation)) {
-            return std::make_unique<BooleanSymbol>(GetParentTable());
+            return GetParentTable()->GetBooleanSymbol();
         }
     }
 
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
 BooleanSymbol::BooleanSymbol(SymbolTable* parentTable) : FundamentalType("Boolean", parentTable) {}
@@ -45,28 +45,28 @@ void BooleanSymbol::Init() {
     CreateCast("toString", GetParentTable()->GetType("String"));
 }
 
-Pointer<AbstractType> BooleanSymbol::IsApplicable(LexemeType operation) const {
+const AbstractType* BooleanSymbol::IsApplicable(LexemeType operation) const {
     if (operation == LexemeType::OpExclMark) {
-        return std::make_unique<BooleanSymbol>(GetParentTable());
+        return GetParentTable()->GetBooleanSymbol();
     }
 
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
-Pointer<AbstractType> BooleanSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
+const AbstractType* BooleanSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
     if (*rightOperand == *this) {
         if (LexerUtils::IsBoolOperation(binaryOperation)) {
-            return std::make_unique<BooleanSymbol>(GetParentTable());
+            return GetParentTable()->GetBooleanSymbol();
         }
     }
 
     auto arr = dynamic_cast<const ArraySymbol*>(rightOperand);
     if ((binaryOperation == LexemeType::OpIn || binaryOperation == LexemeType::OpNotIn)
         && arr != nullptr) {
-        return std::make_unique<BooleanSymbol>(GetParentTable());
+        return GetParentTable()->GetBooleanSymbol();
     }
 
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
 IntegerSymbol::IntegerSymbol(SymbolTable* parentTable) : FundamentalType("Int", parentTable) {}
@@ -76,32 +76,32 @@ void IntegerSymbol::Init() {
     CreateCast("toDouble", GetParentTable()->GetType("Double"));
 }
 
-Pointer<AbstractType> IntegerSymbol::IsApplicable(LexemeType operation) const {
+const AbstractType* IntegerSymbol::IsApplicable(LexemeType operation) const {
     if (operation == LexemeType::OpAdd || operation == LexemeType::OpSub || operation == LexemeType::OpInc || operation == LexemeType::OpDec) {
-        return std::make_unique<IntegerSymbol>(GetParentTable());
+        return GetParentTable()->GetIntegerSymbol();
     }
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
-Pointer<AbstractType> IntegerSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
+const AbstractType* IntegerSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
     if (*this == *rightOperand) {
         if (LexerUtils::IsComparisonOperation(binaryOperation)) {
-            return std::make_unique<BooleanSymbol>(GetParentTable());
+            return GetParentTable()->GetBooleanSymbol();
         }
         if (LexerUtils::IsArithmeticOperation(binaryOperation)) {
-            return std::make_unique<IntegerSymbol>(GetParentTable());
+            return GetParentTable()->GetIntegerSymbol();
         }
         if (binaryOperation == LexemeType::OpDDot) {
-            return std::make_unique<RangeSymbol>(GetParentTable(), this);
+            return GetParentTable()->GetRangeSymbol(this);
         }
     }
 
     if (dynamic_cast<const DoubleSymbol*>(rightOperand) != nullptr) {
         if (LexerUtils::IsArithmeticOperation(binaryOperation)) {
-            return std::make_unique<DoubleSymbol>(GetParentTable());
+            return GetParentTable()->GetDoubleSymbol();
         }
         if (LexerUtils::IsComparisonOperation(binaryOperation) && !LexerUtils::IsEqualityOperation(binaryOperation)) {
-            return std::make_unique<BooleanSymbol>(GetParentTable());
+            return GetParentTable()->GetBooleanSymbol();
         }
     }
 
@@ -109,10 +109,10 @@ Pointer<AbstractType> IntegerSymbol::IsApplicable(LexemeType binaryOperation, co
     auto arr = dynamic_cast<const ArraySymbol*>(rightOperand);
     if ((binaryOperation == LexemeType::OpIn || binaryOperation == LexemeType::OpNotIn)
         && (range != nullptr && range->GetType() == this || arr != nullptr)) {
-        return std::make_unique<BooleanSymbol>(GetParentTable());
+        return GetParentTable()->GetBooleanSymbol();
     }
 
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
 bool IntegerSymbol::IsAssignable(LexemeType assignOperation, const AbstractType* rightOperand) const {
@@ -130,32 +130,32 @@ void DoubleSymbol::Init() {
     CreateCast("toInt", GetParentTable()->GetType("Int"));
 }
 
-Pointer<AbstractType> DoubleSymbol::IsApplicable(LexemeType operation) const {
+const AbstractType* DoubleSymbol::IsApplicable(LexemeType operation) const {
     if (operation == LexemeType::OpAdd || operation == LexemeType::OpSub || operation == LexemeType::OpInc || operation == LexemeType::OpDec) {
-        return std::make_unique<DoubleSymbol>(GetParentTable());
+        return GetParentTable()->GetDoubleSymbol();
     }
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
-Pointer<AbstractType> DoubleSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
+const AbstractType* DoubleSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
     if (*this == *rightOperand) {
         if (LexerUtils::IsComparisonOperation(binaryOperation)) {
-            return std::make_unique<BooleanSymbol>(GetParentTable());
+            return GetParentTable()->GetBooleanSymbol();
         }
         if (LexerUtils::IsArithmeticOperation(binaryOperation)) {
-            return std::make_unique<DoubleSymbol>(GetParentTable());
+            return GetParentTable()->GetDoubleSymbol();
         }
         if (binaryOperation == LexemeType::OpDDot) {
-            return std::make_unique<RangeSymbol>(GetParentTable(), this);
+            return GetParentTable()->GetRangeSymbol(this);
         }
     }
 
     if (dynamic_cast<const IntegerSymbol*>(rightOperand) != nullptr) {
         if (LexerUtils::IsArithmeticOperation(binaryOperation)) {
-            return std::make_unique<DoubleSymbol>(GetParentTable());
+            return GetParentTable()->GetDoubleSymbol();
         }
         if (LexerUtils::IsComparisonOperation(binaryOperation) && !LexerUtils::IsEqualityOperation(binaryOperation)) {
-            return std::make_unique<BooleanSymbol>(GetParentTable());
+            return GetParentTable()->GetBooleanSymbol();
         }
     }
 
@@ -163,10 +163,10 @@ Pointer<AbstractType> DoubleSymbol::IsApplicable(LexemeType binaryOperation, con
     auto arr = dynamic_cast<const ArraySymbol*>(rightOperand);
     if ((binaryOperation == LexemeType::OpIn || binaryOperation == LexemeType::OpNotIn)
         && (range != nullptr && range->GetType() == this || arr != nullptr)) {
-        return std::make_unique<BooleanSymbol>(GetParentTable());
+        return GetParentTable()->GetBooleanSymbol();
     }
 
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
 bool DoubleSymbol::IsAssignable(LexemeType assignOperation, const AbstractType* rightOperand) const {
@@ -179,26 +179,26 @@ bool DoubleSymbol::IsAssignable(LexemeType assignOperation, const AbstractType*
 
 StringSymbol::StringSymbol(SymbolTable* parentTable) : FundamentalType("String", parentTable) {}
 
-Pointer<AbstractType> StringSymbol::IsApplicable(LexemeType operation) const {
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+const AbstractType* StringSymbol::IsApplicable(LexemeType operation) const {
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
-Pointer<AbstractType> StringSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
+const AbstractType* StringSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
     if (*this == *rightOperand) {
         if (LexerUtils::IsEqualityOperation(binaryOperation)) {
-            return std::make_unique<BooleanSymbol>(GetParentTable());
+            return GetParentTable()->GetBooleanSymbol();
         }
         if (binaryOperation == LexemeType::OpAdd) {
-            return std::make_unique<StringSymbol>(GetParentTable());
+            return GetParentTable()->GetStringSymbol();
         }
     }
 
     auto arr = dynamic_cast<const ArraySymbol*>(rightOperand);
     if ((binaryOperation == LexemeType::OpIn || binaryOperation == LexemeType::OpNotIn) && (arr != nullptr)) {
-        return std::make_unique<BooleanSymbol>(GetParentTable());
+        return GetParentTable()->GetBooleanSymbol();
     }
 
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
 bool StringSymbol::IsAssignable(LexemeType assignOperation, const AbstractType* rightOperand) const {
@@ -225,16 +225,16 @@ void ArraySymbol::SetSize(int size) {
     mySize = size;
 }
 
-Pointer<AbstractType> ArraySymbol::IsApplicable(LexemeType operation) const {
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+const AbstractType* ArraySymbol::IsApplicable(LexemeType operation) const {
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
-Pointer<AbstractType> ArraySymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
+const AbstractType* ArraySymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
     if (*this == *rightOperand && LexerUtils::IsEqualityOperation(binaryOperation)) {
-        return std::make_unique<BooleanSymbol>(GetParentTable());
+        return GetParentTable()->GetBooleanSymbol();
     }
 
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
 RangeSymbol::RangeSymbol(SymbolTable* parentTable, const AbstractType* type) : IterableSymbol("ClosedRange", parentTable, type) {}
@@ -243,14 +243,14 @@ std::string RangeSymbol::GetName() const {
     return AbstractType::GetName() + "<" + GetType()->GetName() + ">";
 }
 
-Pointer<AbstractType> RangeSymbol::IsApplicable(LexemeType operation) const {
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+const AbstractType* RangeSymbol::IsApplicable(LexemeType operation) const {
+    return GetParentTable()->GetUnresolvedSymbol();
 }
 
-Pointer<AbstractType> RangeSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
+const AbstractType* RangeSymbol::IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const {
     if (*this == *rightOperand && LexerUtils::IsEqualityOperation(binaryOperation)) {
-        return std::make_unique<BooleanSymbol>(GetParentTable());
+        return GetParentTable()->GetBooleanSymbol();
     }
 
-    return std::make_unique<UnresolvedSymbol>(GetParentTable());
+    return GetParentTable()->GetUnresolvedSymbol();
 }
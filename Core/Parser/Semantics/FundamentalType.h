@@ -15,16 +15,16 @@ class UnresolvedSymbol : public FundamentalType {
 public:
     explicit UnresolvedSymbol(SymbolTable* parentTable);
 
-    Pointer<AbstractType> IsApplicable(LexemeType operation) const override;
-    Pointer<AbstractType> IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
+    const AbstractType* IsApplicable(LexemeType operation) const override;
+    const AbstractType* IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
 };
 
 class UnitTypeSymbol : public FundamentalType {
 public:
     explicit UnitTypeSymbol(SymbolTable* parentTable);
 
-    Pointer<AbstractType> IsApplicable(LexemeType operation) const override;
-    Pointer<AbstractType> IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
+    const AbstractType* IsApplicable(LexemeType operation) const override;
+    const AbstractType* IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
 };
 
 class BooleanSymbol : public FundamentalType {
@@ -33,8 +33,8 @@ public:
 
     void Init() override;
 
-    Pointer<AbstractType> IsApplicable(LexemeType operation) const override;
-    Pointer<AbstractType> IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
+    const AbstractType* IsApplicable(LexemeType operation) const override;
+    const AbstractType* IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
 };
 
 class IntegerSymbol : public FundamentalType {
@@ -43,8 +43,8 @@ public:
 
     void Init() override;
 
-    Pointer<AbstractType> IsApplicable(LexemeType operation) const override;
-    Pointer<AbstractType> IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
+    const AbstractType* IsApplicable(LexemeType operation) const override;
+    const AbstractType* IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
     bool IsAssignable(LexemeType assignOperation, const AbstractType* rightOperand) const override;
 };
 
@@ -54,8 +54,8 @@ public:
 
     void Init() override;
 
-    Pointer<AbstractType> IsApplicable(LexemeType operation) const override;
-    Pointer<AbstractType> IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
+    const AbstractType* IsApplicable(LexemeType operation) const override;
+    const AbstractType* IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
     bool IsAssignable(LexemeType assignOperation, const AbstractType* rightOperand) const override;
 };
 
@@ -63,8 +63,8 @@ class StringSymbol : public FundamentalType {
 public:
     explicit StringSymbol(SymbolTable* parentTable);
 
-    Pointer<AbstractType> IsApplicable(LexemeType operation) const override;
-    Pointer<AbstractType> IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
+    const AbstractType* IsApplicable(LexemeType operation) const override;
+    const AbstractType* IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
 
     bool IsAssignable(LexemeType assignOperation, const AbstractType* rightOperand) const override;
 };
@@ -88,8 +88,8 @@ public:
     int GetSize() const;
     void SetSize(int size);
 
-    Pointer<AbstractType> IsApplicable(LexemeType operation) const override;
-    Pointer<AbstractType> IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
+    const AbstractType* IsApplicable(LexemeType operation) const override;
+    const AbstractType* IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
 
 private:
     int mySize;
@@ -101,6 +101,6 @@ public:
 
     std::string GetName() const override;
 
-    Pointer<AbstractType> IsApplicable(LexemeType operation) const override;
-    Pointer<AbstractType> IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
+    const AbstractType* IsApplicable(LexemeType operation) const override;
+    const AbstractType* IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const override;
 };
\ No newline at end of file
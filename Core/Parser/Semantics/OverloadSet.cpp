@@ -0,0 +1,66 @@
+#include "OverloadSet.h"
+
+#include "FunctionSymbol.h"
+
+void OverloadSet::Add(const FunctionSymbol* function) {
+    size_t arity = function->GetParametersCount();
+    if (myArities.size() <= arity) {
+        myArities.resize(arity + 1);
+    }
+
+    myFunctions.push_back(function);
+    myArities[arity].push_back(function);
+    myResolved.clear();
+}
+
+const FunctionSymbol* OverloadSet::Resolve(const std::vector<const AbstractType*>& arguments) const {
+    if (arguments.size() >= myArities.size()) {
+        return nullptr;
+    }
+
+    if (!isFrozen) {
+        auto cached = myResolved.find(arguments);
+        if (cached != myResolved.end()) {
+            return cached->second;
+        }
+    }
+
+    const FunctionSymbol* res = nullptr;
+    const std::vector<const FunctionSymbol*>& candidates = myArities[arguments.size()];
+    for (auto it = candidates.rbegin(); res == nullptr && it != candidates.rend(); ++it) {
+        bool isResolved = true;
+        for (size_t i = 0; isResolved && i < arguments.size(); i++) {
+            isResolved = *(*it)->GetParameter(static_cast<int>(i)) == *arguments[i];
+        }
+
+        if (isResolved) {
+            res = *it;
+        }
+    }
+
+    if (!isFrozen) {
+        myResolved.emplace(arguments, res);
+    }
+    return res;
+}
+
+void OverloadSet::Freeze() {
+    isFrozen = true;
+    myResolved.clear();
+}
+
+bool OverloadSet::IsEmpty() const {
+    return myFunctions.empty();
+}
+
+const std::vector<const FunctionSymbol*>& OverloadSet::GetFunctions() const {
+    return myFunctions;
+}
+
+size_t OverloadSet::SignatureHash::operator()(const std::vector<const AbstractType*>& signature) const {
+    size_t res = signature.size();
+    for (auto type : signature) {
+        res = res * 31 + std::hash<const AbstractType*>()(type);
+    }
+    return res;
+}
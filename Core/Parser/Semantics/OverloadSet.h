@@ -0,0 +1,30 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+
+#include "Symbols.h"
+
+class FunctionSymbol;
+
+// Same-named functions of a single table, bucketed by arity, with resolution memoized by argument types
+class OverloadSet {
+public:
+    void Add(const FunctionSymbol* function);
+    const FunctionSymbol* Resolve(const std::vector<const AbstractType*>& arguments) const;
+
+    // Frozen sets may be shared between threads, so they stop memoizing
+    void Freeze();
+
+    bool IsEmpty() const;
+    const std::vector<const FunctionSymbol*>& GetFunctions() const;
+
+private:
+    struct SignatureHash {
+        size_t operator()(const std::vector<const AbstractType*>& signature) const;
+    };
+
+    std::vector<const FunctionSymbol*> myFunctions;
+    std::vector<std::vector<const FunctionSymbol*>> myArities;
+    mutable std::unordered_map<std::vector<const AbstractType*>, const FunctionSymbol*, SignatureHash> myResolved;
+    bool isFrozen = false;
+};
@@ -0,0 +1,78 @@
+#include "ScopedSymbolTable.h"
+
+int ScopedSymbolTable::EnterScope() {
+    myScopes.emplace_back();
+    return myScopes.size() - 1;
+}
+
+void ScopedSymbolTable::LeaveScope() {
+    int depth = myScopes.size() - 1;
+    for (SymbolId id : myScopes.back()) {
+        Bindings& bindings = myBindings[id];
+        Unbind(bindings.myTypes, depth);
+        Unbind(bindings.myVariables, depth);
+        Unbind(bindings.myOverloads, depth);
+    }
+    myScopes.pop_back();
+}
+
+void ScopedSymbolTable::Add(SymbolId id, const AbstractType* type, int depth) {
+    Bind(myBindings[id].myTypes, id, type, depth);
+}
+
+void ScopedSymbolTable::Add(SymbolId id, const VariableSymbol* variable, int depth) {
+    Bind(myBindings[id].myVariables, id, variable, depth);
+}
+
+void ScopedSymbolTable::Add(SymbolId id, const OverloadSet* overloads, int depth) {
+    Bind(myBindings[id].myOverloads, id, overloads, depth);
+}
+
+void ScopedSymbolTable::Lookup(SymbolId id, int depth, SymbolLookup& res) const {
+    auto bindings = myBindings.find(id);
+    if (bindings == myBindings.end()) {
+        return;
+    }
+
+    if (res.myType == nullptr) {
+        for (auto it = bindings->second.myTypes.rbegin(); it != bindings->second.myTypes.rend(); ++it) {
+            if (it->myDepth <= depth) {
+                res.myType = it->mySymbol;
+                break;
+            }
+        }
+    }
+
+    if (res.myVariable == nullptr) {
+        for (auto it = bindings->second.myVariables.rbegin(); it != bindings->second.myVariables.rend(); ++it) {
+            if (it->myDepth <= depth) {
+                res.myVariable = it->mySymbol;
+                break;
+            }
+        }
+    }
+
+    for (auto it = bindings->second.myOverloads.rbegin(); it != bindings->second.myOverloads.rend(); ++it) {
+        if (it->myDepth <= depth) {
+            res.myOverloads.push_back(it->mySymbol);
+        }
+    }
+}
+
+template<typename T>
+void ScopedSymbolTable::Bind(std::vector<Binding<T>>& chain, SymbolId id, const T* symbol, int depth) {
+    // Symbols may be declared in an enclosing scope (e.g. a function in its parent), keep the chain ordered by depth
+    auto pos = chain.end();
+    while (pos != chain.begin() && (pos - 1)->myDepth > depth) {
+        --pos;
+    }
+    chain.insert(pos, Binding<T>{ symbol, depth });
+    myScopes[depth].push_back(id);
+}
+
+template<typename T>
+void ScopedSymbolTable::Unbind(std::vector<Binding<T>>& chain, int depth) {
+    while (!chain.empty() && chain.back().myDepth == depth) {
+        chain.pop_back();
+    }
+}
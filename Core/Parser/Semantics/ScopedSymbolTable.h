@@ -0,0 +1,45 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+
+#include "OverloadSet.h"
+
+struct SymbolLookup {
+    const AbstractType* myType = nullptr;
+    const VariableSymbol* myVariable = nullptr;
+    std::vector<const OverloadSet*> myOverloads;
+};
+
+// Name index over all currently open scopes: every name maps to shadowing chains ordered by scope depth
+class ScopedSymbolTable {
+public:
+    int EnterScope();
+    void LeaveScope();
+
+    void Add(SymbolId id, const AbstractType* type, int depth);
+    void Add(SymbolId id, const VariableSymbol* variable, int depth);
+    void Add(SymbolId id, const OverloadSet* overloads, int depth);
+
+    void Lookup(SymbolId id, int depth, SymbolLookup& res) const;
+
+private:
+    template<typename T>
+    struct Binding {
+        const T* mySymbol;
+        int myDepth;
+    };
+
+    struct Bindings {
+        std::vector<Binding<AbstractType>> myTypes;
+        std::vector<Binding<VariableSymbol>> myVariables;
+        std::vector<Binding<OverloadSet>> myOverloads;
+    };
+
+    template<typename T>
+    void Bind(std::vector<Binding<T>>& chain, SymbolId id, const T* symbol, int depth);
+    template<typename T>
+    static void Unbind(std::vector<Binding<T>>& chain, int depth);
+
+    std::unordered_map<SymbolId, Bindings> myBindings;
+    std::vector<std::vector<SymbolId>> myScopes;
+};
@@ -5,7 +5,20 @@
 #include "FunctionSymbol.h"
 #include "../INodeVisitor.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 SymbolTable::SymbolTable(SymbolTable* parent) : myParentTable(parent) {
+    if (parent != nullptr && !parent->isFrozen) {
+        myScopes = parent->myScopes;
+        myPrelude = parent->myPrelude;
+    } else {
+        myOwnedScopes = std::make_unique<ScopedSymbolTable>();
+        myScopes = myOwnedScopes.get();
+        myPrelude = parent;
+        OpenScope();
+    }
+
     if (parent == nullptr) {
         myUnresolved = std::make_unique<UnresolvedSymbol>(this);
         myUnitSymbol = std::make_unique<UnitTypeSymbol>(this);
@@ -15,6 +28,11 @@ SymbolTable::SymbolTable(SymbolTable* parent) : myParentTable(parent) {
         auto boolSym = dynamic_cast<FundamentalType*>(InnerAdd(std::make_unique<BooleanSymbol>(this)));
         auto doubleSym = dynamic_cast<FundamentalType*>(InnerAdd(std::make_unique<DoubleSymbol>(this)));
 
+        myStringSymbol = static_cast<const StringSymbol*>(stringSym);
+        myIntegerSymbol = static_cast<const IntegerSymbol*>(intSym);
+        myBooleanSymbol = static_cast<const BooleanSymbol*>(boolSym);
+        myDoubleSymbol = static_cast<const DoubleSymbol*>(doubleSym);
+
         stringSym->Init();
         intSym->Init();
         boolSym->Init();
@@ -36,87 +54,55 @@ SymbolTable* SymbolTable::GetParent() const {
     return myParentTable;
 }
 
-std::vector<const ISymbol*> SymbolTable::GetSymbols(const std::string& name) const {
-    std::vector<const ISymbol*> res;
-    if (myParentTable != nullptr) {
-        res = myParentTable->GetSymbols(name);
+SymbolLookup SymbolTable::Lookup(SymbolId id) const {
+    SymbolLookup res;
+    const SymbolTable* table = this;
+    while (table != nullptr && table->myScopeDepth < 0) {
+        table->LocalLookup(id, res);
+        table = table->myParentTable;
     }
 
-    if (mySymbols.count(name)) {
-        for (auto& it : mySymbols.at(name)) {
-            res.push_back(it.get());
+    if (table != nullptr) {
+        myScopes->Lookup(id, table->myScopeDepth, res);
+        for (table = myPrelude; table != nullptr; table = table->myParentTable) {
+            table->LocalLookup(id, res);
         }
     }
-
-    std::reverse(res.begin(), res.end());
     return res;
 }
 
 const AbstractType* SymbolTable::GetType(const std::string& name) const {
-    std::vector<const ISymbol*> res = GetSymbols(name);
-    for (auto it : res) {
-        auto typeSym = dynamic_cast<const AbstractType*>(it);
-        if (typeSym != nullptr) {
-            return typeSym;
-        }
+    const AbstractType* typeSym = Lookup(StringInterner::Intern(name)).myType;
+    if (typeSym != nullptr) {
+        return typeSym;
     }
 
     return GetUnresolvedSymbol();
 }
 
 const ISymbol* SymbolTable::GetVariable(const std::string& name) const {
-    std::vector<const ISymbol*> res = GetSymbols(name);
-    for (auto it : res) {
-        auto varSym = dynamic_cast<const VariableSymbol*>(it);
-        if (varSym != nullptr) {
-            return varSym;
-        }
-    }
-
-    return GetUnresolvedSymbol();
-}
-
-const AbstractType* SymbolTable::GetClass(const std::string& name) const {
-    std::vector<const ISymbol*> res = GetSymbols(name);
-    for (auto it : res) {
-        auto classSym = dynamic_cast<const ClassSymbol*>(it);
-        if (classSym != nullptr) {
-            return classSym;
-        }
+    const VariableSymbol* varSym = Lookup(StringInterner::Intern(name)).myVariable;
+    if (varSym != nullptr) {
+        return varSym;
     }
 
     return GetUnresolvedSymbol();
 }
 
 std::vector<const FunctionSymbol*> SymbolTable::GetFunctions(const std::string& name) const {
-    std::vector<const ISymbol*> res = GetSymbols(name);
     std::vector<const FunctionSymbol*> funcs;
-    for (auto it : res) {
-        auto funcSym = dynamic_cast<const FunctionSymbol*>(it);
-        if (funcSym != nullptr) {
-            funcs.push_back(funcSym);
-        }
+    for (auto overloads : Lookup(StringInterner::Intern(name)).myOverloads) {
+        funcs.insert(funcs.end(), overloads->GetFunctions().rbegin(), overloads->GetFunctions().rend());
     }
 
     return funcs;
 }
 
 const ISymbol* SymbolTable::GetFunction(const std::string& name, const std::vector<const AbstractType*>& params) const {
-    std::vector<const FunctionSymbol*> funcs = GetFunctions(name);
-    for (auto it : funcs) {
-        if (it->GetParametersCount() == params.size()) {
-            bool isResolved = true;
-
-            for (int i = 0; i < params.size(); i++) {
-                if (*params[i] != *it->GetParameter(i)) {
-                    isResolved = false;
-                    break;
-                }
-            }
-
-            if (isResolved) {
-                return it;
-            }
+    for (auto overloads : Lookup(StringInterner::Intern(name)).myOverloads) {
+        const FunctionSymbol* funcSym = overloads->Resolve(params);
+        if (funcSym != nullptr) {
+            return funcSym;
         }
     }
 
@@ -128,9 +114,8 @@ bool SymbolTable::IsEmpty() const {
 }
 
 bool SymbolTable::Contains(const ISymbol& symbol) const {
-    std::vector<const ISymbol*> res = GetSymbols(symbol.GetName());
-    for (auto it : res) {
-        if (*it == symbol) {
+    for (const SymbolTable* table = this; table != nullptr; table = table->myParentTable) {
+        if (table->LocalContains(symbol)) {
             return true;
         }
     }
@@ -140,6 +125,7 @@ bool SymbolTable::Contains(const ISymbol& symbol) const {
 
 ISymbol* SymbolTable::Add(Pointer<ISymbol> symbol) {
     if (LocalContains(*symbol)) {
+        Discard(std::move(symbol));
         return GetUnresolvedSymbol();
     }
     return InnerAdd(std::move(symbol));
@@ -149,6 +135,67 @@ void SymbolTable::Add(Pointer<SymbolTable> table) {
     myBlockTables.push_back(std::move(table));
 }
 
+void SymbolTable::Discard(Pointer<IVisitable> object) {
+    myDiscarded.push_back(std::move(object));
+}
+
+void SymbolTable::OpenScope() {
+    myScopeDepth = myScopes->EnterScope();
+    for (auto& it : myDeclarations) {
+        if (it.second.myType != nullptr) {
+            myScopes->Add(it.first, it.second.myType, myScopeDepth);
+        }
+        if (it.second.myVariable != nullptr) {
+            myScopes->Add(it.first, it.second.myVariable, myScopeDepth);
+        }
+        if (!it.second.myOverloads.IsEmpty()) {
+            myScopes->Add(it.first, &it.second.myOverloads, myScopeDepth);
+        }
+    }
+}
+
+void SymbolTable::CloseScope() {
+    myScopes->LeaveScope();
+    myScopeDepth = -1;
+}
+
+void SymbolTable::Freeze() {
+    if (myParentTable != nullptr || isFrozen) {
+        throw std::invalid_argument("Only the root symbol table can be frozen");
+    }
+
+    // Fundamental operators may produce these ranges, they have to exist before the table becomes shared
+    GetRangeSymbol(myIntegerSymbol);
+    GetRangeSymbol(myDoubleSymbol);
+
+    CloseScope();
+    FreezeOverloads();
+    isFrozen = true;
+}
+
+void SymbolTable::FreezeOverloads() {
+    for (auto& it : myDeclarations) {
+        it.second.myOverloads.Freeze();
+    }
+
+    for (auto& it : mySymbols) {
+        for (auto& sym : it.second) {
+            auto typeSym = dynamic_cast<const AbstractType*>(sym.get());
+            if (typeSym != nullptr) {
+                typeSym->GetTable()->FreezeOverloads();
+            }
+        }
+    }
+
+    for (auto& table : myBlockTables) {
+        table->FreezeOverloads();
+    }
+}
+
+bool SymbolTable::IsFrozen() const {
+    return isFrozen;
+}
+
 UnresolvedSymbol* SymbolTable::GetUnresolvedSymbol() const {
     if (myParentTable != nullptr) {
         return myParentTable->GetUnresolvedSymbol();
@@ -163,13 +210,77 @@ const UnitTypeSymbol* SymbolTable::GetUnitSymbol() const {
     return myUnitSymbol.get();
 }
 
+const BooleanSymbol* SymbolTable::GetBooleanSymbol() const {
+    return GetRoot()->myBooleanSymbol;
+}
+
+const IntegerSymbol* SymbolTable::GetIntegerSymbol() const {
+    return GetRoot()->myIntegerSymbol;
+}
+
+const DoubleSymbol* SymbolTable::GetDoubleSymbol() const {
+    return GetRoot()->myDoubleSymbol;
+}
+
+const StringSymbol* SymbolTable::GetStringSymbol() const {
+    return GetRoot()->myStringSymbol;
+}
+
+const ArraySymbol* SymbolTable::GetArraySymbol(const AbstractType* elementType) {
+    SymbolTable* root = GetUnitRoot();
+    auto it = root->myArraySymbols.find(elementType);
+    if (it != root->myArraySymbols.end()) {
+        return it->second;
+    }
+
+    auto arraySym = static_cast<const ArraySymbol*>(root->InnerAdd(std::make_unique<ArraySymbol>(root, elementType)));
+    root->myArraySymbols.emplace(elementType, arraySym);
+    return arraySym;
+}
+
+const RangeSymbol* SymbolTable::GetRangeSymbol(const AbstractType* elementType) {
+    SymbolTable* root = GetUnitRoot();
+    for (SymbolTable* table = root; table != nullptr; table = table->myParentTable) {
+        auto it = table->myRangeSymbols.find(elementType);
+        if (it != table->myRangeSymbols.end()) {
+            return it->second;
+        }
+    }
+
+    auto rangeSym = static_cast<const RangeSymbol*>(root->InnerAdd(std::make_unique<RangeSymbol>(root, elementType)));
+    root->myRangeSymbols.emplace(elementType, rangeSym);
+    return rangeSym;
+}
+
+const ISymbol* SymbolTable::GetArrayBuilder(const ArraySymbol* arrayType, size_t arity) {
+    SymbolTable* root = GetUnitRoot();
+    std::vector<const ISymbol*>& builders = root->myArrayBuilders[arrayType];
+    if (builders.size() <= arity) {
+        builders.resize(arity + 1, nullptr);
+    }
+
+    if (builders[arity] == nullptr) {
+        std::vector<const AbstractType*> params(arity, arrayType->GetType());
+        root->Add(std::make_unique<FunctionSymbol>("arrayOf", arrayType, params, std::make_unique<SymbolTable>(root), nullptr));
+        builders[arity] = root->GetFunction("arrayOf", params);
+    }
+
+    return builders[arity];
+}
+
 std::string SymbolTable::ToString() const {
     return "SymbolTable";
 }
 
 void SymbolTable::PropagateVisitor(INodeVisitor& visitor) const {
+    std::vector<std::pair<const std::string*, const std::vector<Pointer<ISymbol>>*>> symbols;
     for (auto& it : mySymbols) {
-        for (auto& sym : it.second) {
+        symbols.emplace_back(&StringInterner::GetString(it.first), &it.second);
+    }
+    std::sort(symbols.begin(), symbols.end(), [](auto& lhs, auto& rhs) { return *lhs.first < *rhs.first; });
+
+    for (auto& it : symbols) {
+        for (auto& sym : *it.second) {
             sym->RunVisitor(visitor);
         }
     }
@@ -179,8 +290,9 @@ void SymbolTable::PropagateVisitor(INodeVisitor& visitor) const {
 }
 
 bool SymbolTable::LocalContains(const ISymbol& symbol) const {
-    if (mySymbols.count(symbol.GetName())) {
-        for (auto& it : mySymbols.at(symbol.GetName())) {
+    auto symbols = mySymbols.find(StringInterner::Intern(symbol.GetName()));
+    if (symbols != mySymbols.end()) {
+        for (auto& it : symbols->second) {
             if (*it == symbol) {
                 return true;
             }
@@ -190,7 +302,71 @@ bool SymbolTable::LocalContains(const ISymbol& symbol) const {
 }
 
 ISymbol* SymbolTable::InnerAdd(Pointer<ISymbol> symbol) {
-    std::string name = symbol->GetName();
-    mySymbols[name].push_back(std::move(symbol));
-    return mySymbols[name].rbegin()->get();
+    SymbolId id = StringInterner::Intern(symbol->GetName());
+    std::vector<Pointer<ISymbol>>& symbols = mySymbols[id];
+    symbols.push_back(std::move(symbol));
+    ISymbol* res = symbols.rbegin()->get();
+
+    // Symbols are classified once here so that lookups never have to cast
+    Declarations& declarations = myDeclarations[id];
+    if (auto typeSym = dynamic_cast<const AbstractType*>(res)) {
+        declarations.myType = typeSym;
+        if (myScopeDepth >= 0) {
+            myScopes->Add(id, typeSym, myScopeDepth);
+        }
+    } else if (auto varSym = dynamic_cast<const VariableSymbol*>(res)) {
+        declarations.myVariable = varSym;
+        if (myScopeDepth >= 0) {
+            myScopes->Add(id, varSym, myScopeDepth);
+        }
+    } else if (auto funcSym = dynamic_cast<const FunctionSymbol*>(res)) {
+        bool isNewName = declarations.myOverloads.IsEmpty();
+        declarations.myOverloads.Add(funcSym);
+        if (isNewName && myScopeDepth >= 0) {
+            myScopes->Add(id, &declarations.myOverloads, myScopeDepth);
+        }
+    }
+
+    return res;
+}
+
+void SymbolTable::LocalLookup(SymbolId id, SymbolLookup& res) const {
+    auto declarations = myDeclarations.find(id);
+    if (declarations == myDeclarations.end()) {
+        return;
+    }
+
+    if (res.myType == nullptr) {
+        res.myType = declarations->second.myType;
+    }
+    if (res.myVariable == nullptr) {
+        res.myVariable = declarations->second.myVariable;
+    }
+    if (!declarations->second.myOverloads.IsEmpty()) {
+        res.myOverloads.push_back(&declarations->second.myOverloads);
+    }
+}
+
+SymbolTable* SymbolTable::GetRoot() {
+    SymbolTable* table = this;
+    while (table->myParentTable != nullptr) {
+        table = table->myParentTable;
+    }
+    return table;
+}
+
+const SymbolTable* SymbolTable::GetRoot() const {
+    const SymbolTable* table = this;
+    while (table->myParentTable != nullptr) {
+        table = table->myParentTable;
+    }
+    return table;
+}
+
+SymbolTable* SymbolTable::GetUnitRoot() {
+    SymbolTable* table = this;
+    while (table->myParentTable != nullptr && !table->myParentTable->isFrozen) {
+        table = table->myParentTable;
+    }
+    return table;
 }
@@ -1,13 +1,20 @@
 #pragma once
-#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Symbols.h"
+#include "ScopedSymbolTable.h"
 
 class UnitTypeSymbol;
 class UnresolvedSymbol;
 class FunctionSymbol;
+class BooleanSymbol;
+class IntegerSymbol;
+class DoubleSymbol;
+class StringSymbol;
+class ArraySymbol;
+class RangeSymbol;
 
 class SymbolTable : public IVisitable {
 public:
@@ -15,11 +22,10 @@ public:
     SymbolTable(SymbolTable& src) = delete;
 
     SymbolTable* GetParent() const;
-    std::vector<const ISymbol*> GetSymbols(const std::string& name) const;
+    SymbolLookup Lookup(SymbolId id) const;
 
     const AbstractType* GetType(const std::string& name) const;
     const ISymbol* GetVariable(const std::string& name) const;
-    const AbstractType* GetClass(const std::string& name) const;
     std::vector<const FunctionSymbol*> GetFunctions(const std::string& name) const;
 
     const ISymbol* GetFunction(const std::string& name, const std::vector<const AbstractType*>& params) const;
@@ -28,9 +34,27 @@ public:
     bool Contains(const ISymbol& symbol) const;
     ISymbol* Add(Pointer<ISymbol> symbol);
     void Add(Pointer<SymbolTable> table);
+    // Keeps a symbol or table that lost to a conflicting declaration alive for the nodes parsed against it,
+    // without making it visible to lookups or visitors
+    void Discard(Pointer<IVisitable> object);
+
+    void OpenScope();
+    void CloseScope();
+
+    // Makes the root table an immutable prelude that threads may share; tables created under it become separate compilation units
+    void Freeze();
+    bool IsFrozen() const;
 
     UnresolvedSymbol* GetUnresolvedSymbol() const;
     const UnitTypeSymbol* GetUnitSymbol() const;
+    const BooleanSymbol* GetBooleanSymbol() const;
+    const IntegerSymbol* GetIntegerSymbol() const;
+    const DoubleSymbol* GetDoubleSymbol() const;
+    const StringSymbol* GetStringSymbol() const;
+
+    const ArraySymbol* GetArraySymbol(const AbstractType* elementType);
+    const RangeSymbol* GetRangeSymbol(const AbstractType* elementType);
+    const ISymbol* GetArrayBuilder(const ArraySymbol* arrayType, size_t arity);
 
     friend class INodeVisitor;
 
@@ -40,12 +64,37 @@ protected:
     void PropagateVisitor(INodeVisitor& visitor) const override;
 
 private:
+    struct Declarations {
+        const AbstractType* myType = nullptr;
+        const VariableSymbol* myVariable = nullptr;
+        OverloadSet myOverloads;
+    };
+
     bool LocalContains(const ISymbol& symbol) const;
     ISymbol* InnerAdd(Pointer<ISymbol> symbol);
+    void LocalLookup(SymbolId id, SymbolLookup& res) const;
+    SymbolTable* GetRoot();
+    const SymbolTable* GetRoot() const;
+    SymbolTable* GetUnitRoot();
+    void FreezeOverloads();
 
     SymbolTable* myParentTable;
     Pointer<UnresolvedSymbol> myUnresolved;
     Pointer<UnitTypeSymbol> myUnitSymbol;
-    std::map<std::string, std::vector<Pointer<ISymbol>>> mySymbols;
+    const BooleanSymbol* myBooleanSymbol = nullptr;
+    const IntegerSymbol* myIntegerSymbol = nullptr;
+    const DoubleSymbol* myDoubleSymbol = nullptr;
+    const StringSymbol* myStringSymbol = nullptr;
+    std::unordered_map<const AbstractType*, const ArraySymbol*> myArraySymbols;
+    std::unordered_map<const AbstractType*, const RangeSymbol*> myRangeSymbols;
+    std::unordered_map<const ArraySymbol*, std::vector<const ISymbol*>> myArrayBuilders;
+    std::unordered_map<SymbolId, std::vector<Pointer<ISymbol>>> mySymbols;
+    std::unordered_map<SymbolId, Declarations> myDeclarations;
+    Pointer<ScopedSymbolTable> myOwnedScopes;
+    ScopedSymbolTable* myScopes;
+    const SymbolTable* myPrelude;
+    int myScopeDepth = -1;
+    bool isFrozen = false;
     std::vector<Pointer<SymbolTable>> myBlockTables;
+    std::vector<Pointer<IVisitable>> myDiscarded;
 };
@@ -16,6 +16,9 @@ std::string ISymbol::ToString() const {
 }
 
 bool operator!=(const ISymbol& lhs, const ISymbol& rhs) {
+    if (&lhs == &rhs) {
+        return false;
+    }
     return lhs < rhs || rhs < lhs;
 }
 
@@ -81,3 +84,16 @@ std::string VariableSymbol::ToString() const {
 bool VariableSymbol::IsMutable() const {
     return myMutability;
 }
+
+int VariableSymbol::GetDepth() const {
+    return myDepth;
+}
+
+int VariableSymbol::GetOffset() const {
+    return myOffset;
+}
+
+void VariableSymbol::SetSlot(int depth, int offset) {
+    myDepth = depth;
+    myOffset = offset;
+}
@@ -31,8 +31,8 @@ public:
     AbstractType(const std::string& name, SymbolTable* parentTable);
     AbstractType(const std::string& name, Pointer<SymbolTable> symTable);
 
-    virtual Pointer<AbstractType> IsApplicable(LexemeType operation) const = 0;
-    virtual Pointer<AbstractType> IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const = 0;
+    virtual const AbstractType* IsApplicable(LexemeType operation) const = 0;
+    virtual const AbstractType* IsApplicable(LexemeType binaryOperation, const AbstractType* rightOperand) const = 0;
     virtual bool IsAssignable(LexemeType assignOperation, const AbstractType* rightOperand) const;
 
     SymbolTable* GetTable() const;
@@ -61,8 +61,14 @@ public:
 
     bool IsMutable() const;
 
+    int GetDepth() const;
+    int GetOffset() const;
+    void SetSlot(int depth, int offset);
+
 private:
     std::string myName;
     const AbstractType* myType;
     bool myMutability;
+    int myDepth = -1;
+    int myOffset = -1;
 };
@@ -2,6 +2,7 @@
 
 SymbolsFrame::SymbolsFrame(SymbolTable** table) : myTablePtr(table) {
     myTable = std::make_unique<SymbolTable>(*table);
+    myTable->OpenScope();
     *myTablePtr = myTable.get();
 }
 
@@ -14,6 +15,7 @@ SymbolsFrame::~SymbolsFrame() {
 
 Pointer<SymbolTable> SymbolsFrame::Dispose() {
     if (!isDisposed) {
+        myTable->CloseScope();
         *myTablePtr = (*myTablePtr)->GetParent();
         isDisposed = true;
         return std::move(myTable);
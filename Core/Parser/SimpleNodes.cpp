@@ -1,11 +1,13 @@
 #include "SimpleNodes.h"
 #include "Semantics/FunctionSymbol.h"
+#include "INodeTransformer.h"
 #include "INodeVisitor.h"
 #include "ExpressionNodes.h"
 
+#include <cmath>
 #include <sstream>
 
-AbstractTypedNode::AbstractTypedNode(const Lexeme& lexeme, const ISymbol* symbol) : AbstractNode(lexeme), mySymbol(symbol) {}
+AbstractTypedNode::AbstractTypedNode(const Lexeme& lexeme, const ISymbol* symbol) : IAnnotatedNode(lexeme), mySymbol(symbol) {}
 
 const ISymbol* AbstractTypedNode::GetSymbol() const {
     return mySymbol;
@@ -15,7 +17,7 @@ const AbstractType* AbstractTypedNode::GetType() const {
     return dynamic_cast<const AbstractType*>(GetSymbol());
 }
 
-UnitTypedNode::UnitTypedNode(const Lexeme& lexeme, const UnitTypeSymbol* symbol) : AbstractNode(lexeme), myType(symbol) {}
+UnitTypedNode::UnitTypedNode(const Lexeme& lexeme, const UnitTypeSymbol* symbol) : IAnnotatedNode(lexeme), myType(symbol) {}
 
 const ISymbol* UnitTypedNode::GetSymbol() const {
     return myType;
@@ -25,50 +27,41 @@ const AbstractType* UnitTypedNode::GetType() const {
     return myType;
 }
 
-IdentifierNode::IdentifierNode(const Lexeme& lexeme, const AbstractType* defaultSym, const std::vector<const ISymbol*>& candidates)
-    : AbstractTypedNode(lexeme, defaultSym), myCandidates(candidates) {}
+IdentifierNode::IdentifierNode(const Lexeme& lexeme, const AbstractType* defaultSym, SymbolLookup candidates)
+    : AbstractTypedNode(lexeme, defaultSym), myCandidates(std::move(candidates)) {}
 
 std::string IdentifierNode::GetIdentifier() const {
     return GetLexeme().GetValue<std::string>();
 }
 
+SymbolId IdentifierNode::GetId() const {
+    return GetLexeme().GetId();
+}
+
 bool IdentifierNode::TryResolveVariable() {
-    for (auto it : myCandidates) {
-        auto varSym = dynamic_cast<const VariableSymbol*>(it);
-        if (varSym != nullptr) {
-            mySymbol = varSym;
-            return true;
-        }
+    if (myCandidates.myVariable != nullptr) {
+        mySymbol = myCandidates.myVariable;
+        return true;
     }
 
     return false;
 }
 
 bool IdentifierNode::TryResolveType() {
-    for (auto it : myCandidates) {
-        auto typeSym = dynamic_cast<const AbstractType*>(it);
-        if (typeSym != nullptr) {
-            mySymbol = typeSym;
-            return true;
-        }
+    if (myCandidates.myType != nullptr) {
+        mySymbol = myCandidates.myType;
+        return true;
     }
 
     return false;
 }
 
 bool IdentifierNode::TryResolveFunc(const std::vector<const AbstractType*>& arguments) {
-    for (auto it : myCandidates) {
-        auto funcSym = dynamic_cast<const FunctionSymbol*>(it);
-        if (funcSym != nullptr && funcSym->GetParametersCount() == arguments.size()) {
-            bool isResolved = true;
-            for (int i = 0; isResolved && i < arguments.size(); i++) {
-                isResolved = *funcSym->GetParameter(i) == *arguments[i];
-            }
-
-            if (isResolved) {
-                mySymbol = funcSym;
-                return true;
-            }
+    for (auto overloads : myCandidates.myOverloads) {
+        const FunctionSymbol* funcSym = overloads->Resolve(arguments);
+        if (funcSym != nullptr) {
+            mySymbol = funcSym;
+            return true;
         }
     }
 
@@ -125,7 +118,7 @@ void IntegerNode::RunVisitor(INodeVisitor& visitor) const {
 }
 
 std::string IntegerNode::GetName() const {
-    return "Integer :: " + std::to_string(GetLexeme().GetValue<uint64_t>());
+    return "Integer :: " + std::to_string(static_cast<int>(GetLexeme().GetValue<uint64_t>()));
 }
 
 DoubleNode::DoubleNode(const Lexeme& lexeme, const ISymbol* symbol) : AbstractTypedNode(lexeme, symbol) {}
@@ -137,7 +130,14 @@ void DoubleNode::RunVisitor(INodeVisitor& visitor) const {
 }
 
 std::string DoubleNode::GetName() const {
-    return "Real :: " + std::to_string(GetLexeme().GetValue<double>());
+    double value = GetLexeme().GetValue<double>();
+    if (std::isnan(value)) {
+        return "Real :: NaN";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "Real :: Infinity" : "Real :: -Infinity";
+    }
+    return "Real :: " + std::to_string(value);
 }
 
 BooleanNode::BooleanNode(const Lexeme& lexeme, const ISymbol* symbol) : AbstractTypedNode(lexeme, symbol) {}
@@ -261,3 +261,9 @@ void ReturnNode::PropagateVisitor(INodeVisitor& visitor) const {
         myExpression->RunVisitor(visitor);
     }
 }
+
+void ReturnNode::PropagateTransformer(INodeTransformer& transformer) {
+    if (HasExpression()) {
+        myExpression = transformer.Transform(std::move(myExpression));
+    }
+}
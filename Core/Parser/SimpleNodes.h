@@ -1,10 +1,11 @@
 #pragma once
 #include "ISyntaxNode.h"
 #include "ParserUtils.h"
+#include "Semantics/ScopedSymbolTable.h"
 
 class TypeArgumentsNode;
 
-class AbstractTypedNode : public AbstractNode, public virtual IAnnotatedNode {
+class AbstractTypedNode : public IAnnotatedNode {
 public:
     AbstractTypedNode(const Lexeme& lexeme, const ISymbol* symbol);
 
@@ -15,7 +16,7 @@ protected:
     mutable const ISymbol* mySymbol;
 };
 
-class UnitTypedNode : public AbstractNode, public virtual IAnnotatedNode {
+class UnitTypedNode : public IAnnotatedNode {
 public:
     UnitTypedNode(const Lexeme& lexeme, const UnitTypeSymbol* symbol);
 
@@ -27,9 +28,10 @@ private:
 
 class IdentifierNode : public AbstractTypedNode {
 public:
-    IdentifierNode(const Lexeme& lexeme, const AbstractType* defaultSym, const std::vector<const ISymbol*>& candidates);
+    IdentifierNode(const Lexeme& lexeme, const AbstractType* defaultSym, SymbolLookup candidates);
 
     std::string GetIdentifier() const;
+    SymbolId GetId() const;
 
     bool TryResolveVariable();
     bool TryResolveType();
@@ -46,7 +48,7 @@ protected:
     std::string GetName() const override;
 
 private:
-    std::vector<const ISymbol*> myCandidates;
+    SymbolLookup myCandidates;
 };
 
 class IntegerNode : public AbstractTypedNode {
@@ -136,6 +138,7 @@ public:
 protected:
     std::string GetName() const override;
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     Pointer<IAnnotatedNode> myExpression;
@@ -1,5 +1,6 @@
 #include "StatementNodes.h"
 #include "ISyntaxNode.h"
+#include "INodeTransformer.h"
 #include "INodeVisitor.h"
 
 EmptyStatement::EmptyStatement(const Lexeme& lexeme, const UnitTypeSymbol* type)
@@ -45,6 +46,11 @@ void Assignment::PropagateVisitor(INodeVisitor& visitor) const {
     myExpression->RunVisitor(visitor);
 }
 
+void Assignment::PropagateTransformer(INodeTransformer& transformer) {
+    transformer.Transform(*myAssignable);
+    myExpression = transformer.Transform(std::move(myExpression));
+}
+
 LoopNode::LoopNode(const Lexeme& lexeme, Pointer<IAnnotatedNode> expression, Pointer<ISyntaxNode> body, const UnitTypeSymbol* type)
     : UnitTypedNode(lexeme, type), myExpression(std::move(expression)), myBody(std::move(body)) {}
 
@@ -61,6 +67,11 @@ void LoopNode::PropagateVisitor(INodeVisitor& visitor) const {
     myBody->RunVisitor(visitor);
 }
 
+void LoopNode::PropagateTransformer(INodeTransformer& transformer) {
+    myExpression = transformer.Transform(std::move(myExpression));
+    transformer.Transform(*myBody);
+}
+
 WhileNode::WhileNode(const Lexeme& lexeme, Pointer<IAnnotatedNode> expression, Pointer<ISyntaxNode> body, const UnitTypeSymbol* type)
     : LoopNode(lexeme, std::move(expression), std::move(body), type) {}
 
@@ -23,6 +23,7 @@ public:
 protected:
     std::string GetName() const override;
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     Pointer<IAnnotatedNode> myAssignable;
@@ -38,6 +39,7 @@ public:
 
 protected:
     void PropagateVisitor(INodeVisitor& visitor) const override;
+    void PropagateTransformer(INodeTransformer& transformer) override;
 
 private:
     Pointer<IAnnotatedNode> myExpression;
@@ -0,0 +1,332 @@
+#include "Bytecode.h"
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "../magic_enum.hpp"
+
+namespace {
+    void WriteInt(std::ostream& output, int32_t value) {
+        output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void WriteString(std::ostream& output, const std::string& value) {
+        WriteInt(output, value.size());
+        output.write(value.data(), value.size());
+    }
+
+    int32_t ReadInt(std::istream& input) {
+        int32_t value;
+        if (!input.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+            throw std::invalid_argument("Unexpected end of program");
+        }
+        return value;
+    }
+
+    int32_t ReadCount(std::istream& input) {
+        int32_t count = ReadInt(input);
+        if (count < 0) {
+            throw std::invalid_argument("Malformed program");
+        }
+        return count;
+    }
+
+    std::string ReadString(std::istream& input) {
+        // Read in pieces so that a corrupted length fails at the end of input instead of allocating it upfront
+        std::string value;
+        char buffer[256];
+        for (int32_t left = ReadCount(input); left > 0; left -= sizeof(buffer)) {
+            std::streamsize size = std::min<int32_t>(left, sizeof(buffer));
+            if (!input.read(buffer, size)) {
+                throw std::invalid_argument("Unexpected end of program");
+            }
+            value.append(buffer, size);
+        }
+        return value;
+    }
+}
+
+int Program::AddConstant(const Value& constant) {
+    myConstants.push_back(constant);
+    return myConstants.size() - 1;
+}
+
+int Program::AddConstant(Pointer<IVariable> object) {
+    myObjects.push_back(std::move(object));
+    return AddConstant(Value(myObjects.back().get()));
+}
+
+const Value& Program::GetConstant(int idx) const {
+    return myConstants[idx];
+}
+
+int Program::AddFunction(const std::string& name, int parametersCount) {
+    CodeFunction function;
+    function.myName = name;
+    function.myParametersCount = parametersCount;
+    function.myFrameSize = parametersCount;
+    myFunctions.push_back(std::move(function));
+    return myFunctions.size() - 1;
+}
+
+CodeFunction& Program::GetFunction(int idx) {
+    return myFunctions[idx];
+}
+
+const CodeFunction& Program::GetFunction(int idx) const {
+    return myFunctions[idx];
+}
+
+int Program::AddClass(const std::string& name) {
+    ClassLayout layout;
+    layout.myName = name;
+    myClasses.push_back(std::move(layout));
+    return myClasses.size() - 1;
+}
+
+ClassLayout& Program::GetClass(int idx) {
+    return myClasses[idx];
+}
+
+const ClassLayout& Program::GetClass(int idx) const {
+    return myClasses[idx];
+}
+
+int Program::GetEntry() const {
+    return myEntry;
+}
+
+void Program::SetEntry(int function) {
+    myEntry = function;
+}
+
+int Program::GetMain() const {
+    return myMain;
+}
+
+void Program::SetMain(int function) {
+    myMain = function;
+}
+
+std::string Program::ToString() const {
+    std::stringstream ss;
+    for (size_t i = 0; i < myClasses.size(); i++) {
+        ss << "class #" << i << " " << myClasses[i].myName << " (fields " << myClasses[i].myFieldsCount
+           << ", constructor #" << myClasses[i].myConstructor << ")" << std::endl;
+    }
+
+    for (size_t i = 0; i < myFunctions.size(); i++) {
+        const CodeFunction& function = myFunctions[i];
+        ss << "fun #" << i << " " << function.myName << " (params " << function.myParametersCount
+           << ", frame " << function.myFrameSize << ")" << std::endl;
+
+        for (size_t j = 0; j < function.myCode.size(); j++) {
+            const Instruction& instruction = function.myCode[j];
+            ss << "    " << j << ": " << magic_enum::enum_name(instruction.myOpCode) << " " << instruction.myFirst << " " << instruction.mySecond;
+            if (instruction.myOpCode == OpCode::Unary || instruction.myOpCode == OpCode::Binary) {
+                ss << " (" << magic_enum::enum_name(static_cast<LexemeType>(instruction.myFirst)) << ")";
+            }
+            ss << std::endl;
+        }
+    }
+
+    return ss.str();
+}
+
+void Program::Write(std::ostream& output) const {
+    WriteInt(output, myConstants.size());
+    for (auto& constant : myConstants) {
+        WriteInt(output, static_cast<int32_t>(constant.GetTag()));
+        switch (constant.GetTag()) {
+        case ValueTag::Unit:
+            break;
+        case ValueTag::Integer:
+            WriteInt(output, constant.Get<int>());
+            break;
+        case ValueTag::Double: {
+            double value = constant.Get<double>();
+            output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            break;
+        }
+        case ValueTag::Boolean:
+            WriteInt(output, constant.Get<bool>());
+            break;
+        case ValueTag::Object:
+            WriteString(output, constant.Get<IVariable*>()->GetValue<std::string>());
+            break;
+        }
+    }
+
+    WriteInt(output, myClasses.size());
+    for (auto& layout : myClasses) {
+        WriteString(output, layout.myName);
+        WriteInt(output, layout.myFieldsCount);
+        WriteInt(output, layout.myConstructor);
+    }
+
+    WriteInt(output, myFunctions.size());
+    for (auto& function : myFunctions) {
+        WriteString(output, function.myName);
+        WriteInt(output, function.myParametersCount);
+        WriteInt(output, function.myFrameSize);
+        WriteInt(output, function.myCode.size());
+        for (auto& instruction : function.myCode) {
+            WriteInt(output, static_cast<int32_t>(instruction.myOpCode));
+            WriteInt(output, instruction.myFirst);
+            WriteInt(output, instruction.mySecond);
+        }
+    }
+
+    WriteInt(output, myEntry);
+    WriteInt(output, myMain);
+}
+
+Pointer<Program> Program::Read(std::istream& input) {
+    Pointer<Program> program = std::make_unique<Program>();
+
+    for (int i = ReadCount(input); i > 0; i--) {
+        switch (static_cast<ValueTag>(ReadInt(input))) {
+        case ValueTag::Unit:
+            program->AddConstant(Value());
+            break;
+        case ValueTag::Integer:
+            program->AddConstant(Value(static_cast<int>(ReadInt(input))));
+            break;
+        case ValueTag::Double: {
+            double value;
+            if (!input.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+                throw std::invalid_argument("Unexpected end of program");
+            }
+            program->AddConstant(Value(value));
+            break;
+        }
+        case ValueTag::Boolean:
+            program->AddConstant(Value(ReadInt(input) != 0));
+            break;
+        case ValueTag::Object:
+            program->AddConstant(std::make_unique<String>(ReadString(input)));
+            break;
+        default:
+            throw std::invalid_argument("Malformed program");
+        }
+    }
+
+    for (int i = ReadCount(input); i > 0; i--) {
+        int idx = program->AddClass(ReadString(input));
+        program->GetClass(idx).myFieldsCount = ReadCount(input);
+        program->GetClass(idx).myConstructor = ReadInt(input);
+    }
+
+    for (int i = ReadCount(input); i > 0; i--) {
+        std::string name = ReadString(input);
+        CodeFunction& function = program->GetFunction(program->AddFunction(name, ReadCount(input)));
+        function.myFrameSize = ReadCount(input);
+        for (int j = ReadCount(input); j > 0; j--) {
+            int32_t opCode = ReadInt(input);
+            if (opCode < 0 || opCode > static_cast<int32_t>(OpCode::Cast)) {
+                throw std::invalid_argument("Malformed program");
+            }
+            int32_t first = ReadInt(input);
+            function.myCode.push_back({ static_cast<OpCode>(opCode), first, ReadInt(input) });
+        }
+    }
+
+    program->SetEntry(ReadInt(input));
+    program->SetMain(ReadInt(input));
+    program->Validate();
+
+    return program;
+}
+
+void Program::Validate() const {
+    auto isFunction = [this](int idx) { return idx >= 0 && idx < static_cast<int>(myFunctions.size()); };
+
+    if (!isFunction(myEntry) || (myMain != -1 && !isFunction(myMain))) {
+        throw std::invalid_argument("Malformed program");
+    }
+
+    for (auto& layout : myClasses) {
+        if (!isFunction(layout.myConstructor)) {
+            throw std::invalid_argument("Malformed program");
+        }
+    }
+
+    for (auto& function : myFunctions) {
+        Validate(function);
+    }
+}
+
+void Program::Validate(const CodeFunction& function) const {
+    const int codeSize = static_cast<int>(function.myCode.size());
+    auto isInRange = [](int32_t idx, size_t size) { return idx >= 0 && idx < static_cast<int64_t>(size); };
+
+    // Execution never falls off the end of a function
+    bool isValid = function.myFrameSize >= function.myParametersCount && codeSize != 0
+        && (function.myCode.back().myOpCode == OpCode::Return || function.myCode.back().myOpCode == OpCode::Jump);
+
+    for (int i = 0; i < codeSize && isValid; i++) {
+        const Instruction& instruction = function.myCode[i];
+        switch (instruction.myOpCode) {
+        case OpCode::PushConst:
+            isValid = isInRange(instruction.myFirst, myConstants.size());
+            break;
+        case OpCode::LoadLocal:
+        case OpCode::StoreLocal:
+            isValid = isInRange(instruction.myFirst, function.myFrameSize);
+            break;
+        case OpCode::LoadOuter:
+        case OpCode::StoreOuter:
+            isValid = instruction.myFirst >= 0 && instruction.mySecond >= 0;
+            break;
+        case OpCode::LoadField:
+        case OpCode::StoreField:
+            isValid = instruction.myFirst >= 0;
+            break;
+        case OpCode::Unary:
+        case OpCode::Binary:
+            isValid = isInRange(instruction.myFirst, magic_enum::enum_count<LexemeType>());
+            break;
+        case OpCode::Jump:
+        case OpCode::JumpIfFalse:
+        case OpCode::JumpIfTrue:
+            isValid = isInRange(instruction.myFirst, codeSize);
+            break;
+        case OpCode::Call:
+            isValid = isInRange(instruction.myFirst, myFunctions.size()) && instruction.mySecond >= 0;
+            break;
+        case OpCode::CallMethod:
+            isValid = isInRange(instruction.myFirst, myFunctions.size());
+            break;
+        case OpCode::New:
+            isValid = isInRange(instruction.myFirst, myClasses.size()) && instruction.mySecond >= 0;
+            break;
+        case OpCode::IterInit:
+        case OpCode::RangeInit:
+            isValid = instruction.myFirst >= 0 && instruction.myFirst <= function.myFrameSize - 3;
+            break;
+        case OpCode::IterNext:
+        case OpCode::RangeNext:
+            isValid = instruction.myFirst >= 0 && instruction.myFirst <= function.myFrameSize - 3
+                && isInRange(instruction.mySecond, codeSize);
+            break;
+        case OpCode::Println:
+            isValid = magic_enum::enum_cast<PrintKind>(instruction.myFirst).has_value() && instruction.mySecond >= 0;
+            break;
+        case OpCode::ArrayOf:
+            isValid = instruction.myFirst >= 0 && isInRange(instruction.mySecond, static_cast<size_t>(ValueTag::Object) + 1);
+            break;
+        case OpCode::Cast:
+            isValid = magic_enum::enum_cast<CastKind>(instruction.myFirst).has_value();
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (!isValid) {
+        throw std::invalid_argument("Malformed program");
+    }
+}
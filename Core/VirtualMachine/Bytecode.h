@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "../Interpreter/Value.h"
+#include "../Interpreter/Variable.h"
+
+// Bump whenever the instruction set or the code the compiler emits changes, cached programs of other versions are ignored
+const int BYTECODE_VERSION = 3;
+
+enum class OpCode : uint8_t {
+    PushConst,
+    PushUnit,
+    Pop,
+    Dup,
+    Dup2,
+    Swap,
+
+    LoadLocal,
+    StoreLocal,
+    LoadOuter,
+    StoreOuter,
+    LoadField,
+    StoreField,
+    LoadIndex,
+    StoreIndex,
+
+    Unary,
+    Binary,
+
+    Jump,
+    JumpIfFalse,
+    JumpIfTrue,
+
+    Call,
+    CallMethod,
+    New,
+    Return,
+
+    IterInit,
+    IterNext,
+    RangeInit,
+    RangeNext,
+
+    Println,
+    ArrayOf,
+    Cast,
+};
+
+enum class PrintKind : int32_t {
+    None,
+    Int,
+    Double,
+    Boolean,
+    String,
+};
+
+enum class CastKind : int32_t {
+    ToInt,
+    ToDouble,
+    ToString,
+};
+
+struct Instruction {
+    OpCode myOpCode;
+    int32_t myFirst;
+    int32_t mySecond;
+};
+
+struct CodeFunction {
+    std::string myName;
+    int myParametersCount = 0;
+    int myFrameSize = 0;
+    std::vector<Instruction> myCode;
+};
+
+struct ClassLayout {
+    std::string myName;
+    int myFieldsCount = 0;
+    int myConstructor = -1;
+};
+
+class Program {
+public:
+    int AddConstant(const Value& constant);
+    int AddConstant(Pointer<IVariable> object);
+    const Value& GetConstant(int idx) const;
+
+    int AddFunction(const std::string& name, int parametersCount);
+    CodeFunction& GetFunction(int idx);
+    const CodeFunction& GetFunction(int idx) const;
+
+    int AddClass(const std::string& name);
+    ClassLayout& GetClass(int idx);
+    const ClassLayout& GetClass(int idx) const;
+
+    int GetEntry() const;
+    void SetEntry(int function);
+    int GetMain() const;
+    void SetMain(int function);
+
+    std::string ToString() const;
+
+    // Binary form used by the program cache; Read throws std::invalid_argument on malformed input
+    void Write(std::ostream& output) const;
+    static Pointer<Program> Read(std::istream& input);
+
+private:
+    // Checks every operand against the tables it refers to, so that a damaged program can't make the VM read out of bounds
+    void Validate() const;
+    void Validate(const CodeFunction& function) const;
+
+    std::vector<Value> myConstants;
+    std::vector<Pointer<IVariable>> myObjects;
+    std::vector<CodeFunction> myFunctions;
+    std::vector<ClassLayout> myClasses;
+    int myEntry = -1;
+    int myMain = -1;
+};
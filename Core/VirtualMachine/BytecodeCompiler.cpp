@@ -0,0 +1,626 @@
+#include "BytecodeCompiler.h"
+
+#include <algorithm>
+
+#include "../Interpreter/InterpreterUtil.h"
+#include "../Parser/DeclarationNodes.h"
+#include "../Parser/ExpressionNodes.h"
+#include "../Parser/StatementNodes.h"
+#include "../Parser/Semantics/FunctionSymbol.h"
+#include "../Parser/Semantics/Symbols.h"
+
+BytecodeCompiler::BytecodeCompiler(const DeclarationBlock* syntaxTree, const SymbolTable* symbolTable)
+    : myTree(syntaxTree), myTable(symbolTable) {}
+
+Pointer<Program> BytecodeCompiler::Compile() {
+    myProgram = std::make_unique<Program>();
+    myFunctions.clear();
+    myClasses.clear();
+
+    Context global{ nullptr, myTree->GetDepth(), myProgram->AddFunction("<globals>", 0), -1, {} };
+    global.mySlotsCount = myTree->GetFrameSize();
+    myProgram->GetFunction(global.myFunction).myFrameSize = global.mySlotsCount;
+    ContextGuard guard(*this, global);
+    myProgram->SetEntry(global.myFunction);
+
+    myTree->RunVisitor(*this);
+
+    const FunctionSymbol* main = InterpreterUtil::FindMainEntry(myTable);
+    if (main != nullptr && myFunctions.count(main)) {
+        myProgram->SetMain(myFunctions.at(main).myIndex);
+        Emit(OpCode::Call, myProgram->GetMain(), 0);
+        Emit(OpCode::Pop);
+    }
+
+    Emit(OpCode::PushUnit);
+    Emit(OpCode::Return);
+    return std::move(myProgram);
+}
+
+void BytecodeCompiler::EnterNode(const IVisitable& node) {}
+
+void BytecodeCompiler::EnterNode(const DeclarationBlock& node) {
+    for (auto& it : node.GetDeclarations()) {
+        CompileStatement(*it);
+    }
+}
+
+void BytecodeCompiler::EnterNode(const FunctionDeclaration& node) {
+    int function = myProgram->AddFunction(node.GetIdentifierName(), node.GetParameters().GetParameters().size());
+    myFunctions[node.GetSymbol()] = Declared{ function, myContext->myLevel, myContext->myClass };
+    CompileFunction(node, function);
+}
+
+void BytecodeCompiler::EnterNode(const ClassDeclaration& node) {
+    int classIdx = myProgram->AddClass(node.GetIdentifierName());
+    int constructor = myProgram->AddFunction(node.GetIdentifierName() + ".<init>", 0);
+    myProgram->GetClass(classIdx).myConstructor = constructor;
+    myClasses[node.GetSymbol()] = Declared{ classIdx, myContext->myLevel, -1 };
+
+    if (!node.HasBody()) {
+        Context constructorContext{ myContext, myContext->myLevel + 2, constructor, -1, {} };
+        ContextGuard constructorGuard(*this, constructorContext);
+        Emit(OpCode::PushUnit);
+        Emit(OpCode::Return);
+        return;
+    }
+
+    const DeclarationBlock& body = node.GetBody();
+    myProgram->GetClass(classIdx).myFieldsCount = body.GetFrameSize();
+
+    Context classContext{ myContext, body.GetDepth(), -1, classIdx, {} };
+    Context constructorContext{ &classContext, body.GetDepth() + 1, constructor, -1, {} };
+
+    {
+        ContextGuard classGuard(*this, classContext);
+        for (auto& it : body.GetDeclarations()) {
+            if (dynamic_cast<const PropertyDeclaration*>(it.get()) == nullptr) {
+                CompileStatement(*it);
+                continue;
+            }
+
+            ContextGuard constructorGuard(*this, constructorContext);
+            CompileStatement(*it);
+        }
+    }
+
+    ContextGuard constructorGuard(*this, constructorContext);
+    Emit(OpCode::PushUnit);
+    Emit(OpCode::Return);
+}
+
+void BytecodeCompiler::EnterNode(const PropertyDeclaration& node) {
+    const VariableSymbol& variable = GetVariable(node.GetSymbol());
+    CompileExpression(node.GetInitialization());
+    EmitStore(Assignable{ AssignableKind::Variable, myContext->myLevel - variable.GetDepth(), variable.GetOffset() });
+}
+
+void BytecodeCompiler::EnterNode(const BlockNode& node) {
+    if (node.GetStatements().empty()) {
+        Emit(OpCode::PushUnit);
+        return;
+    }
+
+    for (size_t i = 0; i + 1 < node.GetStatements().size(); i++) {
+        CompileStatement(*node.GetStatements()[i]);
+    }
+    CompileExpression(*node.GetStatements().back());
+}
+
+void BytecodeCompiler::EnterNode(const EmptyStatement& node) {}
+
+void BytecodeCompiler::EnterNode(const CallSuffixNode& node) {
+    auto funcSym = dynamic_cast<const FunctionSymbol*>(node.GetExpression()->GetSymbol());
+    auto memberAccess = dynamic_cast<const MemberAccessNode*>(node.GetExpression());
+    const IAnnotatedNode* receiver = nullptr;
+    if (memberAccess != nullptr) {
+        receiver = memberAccess->GetExpression();
+    } else if (dynamic_cast<const IdentifierNode*>(node.GetExpression()) == nullptr) {
+        receiver = node.GetExpression();
+    }
+
+    if (funcSym->GetDeclaration() == nullptr) {
+        if (funcSym->GetName() == "println") {
+            CompileArguments(node);
+            PrintKind kind = PrintKind::None;
+            if (funcSym->GetParametersCount() > 0) {
+                const AbstractType* type = funcSym->GetParameter(0);
+                if (dynamic_cast<const IntegerSymbol*>(type)) {
+                    kind = PrintKind::Int;
+                } else if (dynamic_cast<const DoubleSymbol*>(type)) {
+                    kind = PrintKind::Double;
+                } else if (dynamic_cast<const BooleanSymbol*>(type)) {
+                    kind = PrintKind::Boolean;
+                } else if (dynamic_cast<const StringSymbol*>(type)) {
+                    kind = PrintKind::String;
+                }
+            }
+            Emit(OpCode::Println, static_cast<int>(kind), funcSym->GetParametersCount());
+        } else if (funcSym->GetName() == "arrayOf") {
+            CompileArguments(node);
+            ValueTag elementTag = ValueTag::Object;
+            const AbstractType* type = dynamic_cast<const ArraySymbol*>(funcSym->GetReturnType())->GetType();
+            if (dynamic_cast<const IntegerSymbol*>(type)) {
+                elementTag = ValueTag::Integer;
+            } else if (dynamic_cast<const DoubleSymbol*>(type)) {
+                elementTag = ValueTag::Double;
+            } else if (dynamic_cast<const BooleanSymbol*>(type)) {
+                elementTag = ValueTag::Boolean;
+            }
+            Emit(OpCode::ArrayOf, funcSym->GetParametersCount(), static_cast<int>(elementTag));
+        } else {
+            CompileExpression(*receiver);
+            CastKind kind = CastKind::ToString;
+            if (funcSym->GetName() == "toInt") {
+                kind = CastKind::ToInt;
+            } else if (funcSym->GetName() == "toDouble") {
+                kind = CastKind::ToDouble;
+            }
+            Emit(OpCode::Cast, static_cast<int>(kind));
+        }
+
+        return;
+    }
+
+    auto classDecl = dynamic_cast<const ClassDeclaration*>(funcSym->GetDeclaration());
+    if (classDecl != nullptr) {
+        const Declared& declared = myClasses.at(classDecl->GetSymbol());
+        Emit(OpCode::New, declared.myIndex, myContext->myLevel - declared.myLevel);
+        return;
+    }
+
+    const Declared& declared = myFunctions.at(funcSym);
+    if (receiver != nullptr && declared.myClass != -1) {
+        CompileExpression(*receiver);
+        CompileArguments(node);
+        Emit(OpCode::CallMethod, declared.myIndex);
+        return;
+    }
+
+    if (receiver != nullptr) {
+        CompileStatement(*receiver);
+    }
+    CompileArguments(node);
+    Emit(OpCode::Call, declared.myIndex, myContext->myLevel - declared.myLevel);
+}
+
+void BytecodeCompiler::EnterNode(const UnaryPrefixOperationNode& node) {
+    LexemeType operation = node.GetLexeme().GetType();
+    if (operation == LexemeType::OpInc || operation == LexemeType::OpDec) {
+        EmitIncrement(node.GetOperand(), operation, true);
+        return;
+    }
+
+    CompileExpression(node.GetOperand());
+    Emit(OpCode::Unary, static_cast<int>(operation));
+}
+
+void BytecodeCompiler::EnterNode(const UnaryPostfixOperationNode& node) {
+    EmitIncrement(node.GetOperand(), node.GetLexeme().GetType(), false);
+}
+
+void BytecodeCompiler::EnterNode(const IndexSuffixNode& node) {
+    EmitLoad(CompileAssignable(node));
+}
+
+void BytecodeCompiler::EnterNode(const MemberAccessNode& node) {
+    if (myClasses.count(node.GetExpression()->GetType()) == 0) {
+        CompileExpression(*node.GetExpression());
+        return;
+    }
+
+    EmitLoad(CompileAssignable(node));
+}
+
+void BytecodeCompiler::EnterNode(const BinOperationNode& node) {
+    LexemeType operation = node.GetLexeme().GetType();
+    if (operation == LexemeType::OpAnd || operation == LexemeType::OpOr) {
+        CompileExpression(node.GetLeftOperand());
+        Emit(OpCode::Dup);
+        int jump = Emit(operation == LexemeType::OpAnd ? OpCode::JumpIfFalse : OpCode::JumpIfTrue, -1);
+        Emit(OpCode::Pop);
+        CompileExpression(node.GetRightOperand());
+        Patch(jump, GetPosition());
+        return;
+    }
+
+    CompileExpression(node.GetLeftOperand());
+    CompileExpression(node.GetRightOperand());
+    Emit(OpCode::Binary, static_cast<int>(operation));
+}
+
+void BytecodeCompiler::EnterNode(const IntegerNode& node) {
+    Emit(OpCode::PushConst, myProgram->AddConstant(Value(static_cast<int>(node.GetLexeme().GetValue<uint64_t>()))));
+}
+
+void BytecodeCompiler::EnterNode(const DoubleNode& node) {
+    Emit(OpCode::PushConst, myProgram->AddConstant(Value(node.GetLexeme().GetValue<double>())));
+}
+
+void BytecodeCompiler::EnterNode(const BooleanNode& node) {
+    Emit(OpCode::PushConst, myProgram->AddConstant(Value(node.GetLexeme().GetKeyword() == Keyword::True)));
+}
+
+void BytecodeCompiler::EnterNode(const StringNode& node) {
+    Emit(OpCode::PushConst, myProgram->AddConstant(std::make_unique<String>(node.GetLexeme().GetValue<std::string>())));
+}
+
+void BytecodeCompiler::EnterNode(const IdentifierNode& node) {
+    EmitLoad(Resolve(node));
+}
+
+void BytecodeCompiler::EnterNode(const Assignment& node) {
+    LexemeType operation = LexemeType::Error;
+    switch (node.GetLexeme().GetType()) {
+        case LexemeType::OpPlusAssign:
+            operation = LexemeType::OpAdd;
+            break;
+        case LexemeType::OpMinusAssign:
+            operation = LexemeType::OpSub;
+            break;
+        case LexemeType::OpMultAssign:
+            operation = LexemeType::OpMult;
+            break;
+        case LexemeType::OpDivAssign:
+            operation = LexemeType::OpDiv;
+            break;
+        case LexemeType::OpModAssign:
+            operation = LexemeType::OpMod;
+            break;
+        default:
+            break;
+    }
+
+    Assignable assignable = CompileAssignable(node.GetAssignable());
+    if (operation == LexemeType::Error) {
+        CompileExpression(node.GetExpression());
+        EmitStore(assignable);
+        return;
+    }
+
+    if (assignable.myKind == AssignableKind::Variable) {
+        CompileExpression(node.GetExpression());
+        EmitLoad(assignable);
+        Emit(OpCode::Swap);
+    } else {
+        EmitDuplicate(assignable);
+        CompileExpression(node.GetExpression());
+        int temp = AllocateTemp();
+        Emit(OpCode::StoreLocal, temp);
+        EmitLoad(assignable);
+        Emit(OpCode::LoadLocal, temp);
+    }
+
+    Emit(OpCode::Binary, static_cast<int>(operation));
+    EmitStore(assignable);
+}
+
+void BytecodeCompiler::EnterNode(const ContinueNode& node) {
+    myContext->myLoops.back().myContinues.push_back(Emit(OpCode::Jump, -1));
+}
+
+void BytecodeCompiler::EnterNode(const BreakNode& node) {
+    myContext->myLoops.back().myBreaks.push_back(Emit(OpCode::Jump, -1));
+}
+
+void BytecodeCompiler::EnterNode(const ReturnNode& node) {
+    if (node.HasExpression() && dynamic_cast<const EmptyStatement*>(node.GetExpression()) == nullptr) {
+        CompileExpression(*node.GetExpression());
+    } else {
+        Emit(OpCode::PushUnit);
+    }
+
+    Emit(OpCode::Return);
+}
+
+void BytecodeCompiler::EnterNode(const IfExpression& node) {
+    CompileIf(node, false);
+}
+
+void BytecodeCompiler::EnterNode(const WhileNode& node) {
+    ScopeGuard scope(*this);
+    myContext->myLoops.emplace_back();
+
+    int start = GetPosition();
+    CompileExpression(node.GetExpression());
+    int exit = Emit(OpCode::JumpIfFalse, -1);
+    CompileStatement(node.GetBody());
+    Emit(OpCode::Jump, start);
+
+    Patch(exit, GetPosition());
+    PatchAll(myContext->myLoops.back().myBreaks, GetPosition());
+    PatchAll(myContext->myLoops.back().myContinues, start);
+    myContext->myLoops.pop_back();
+}
+
+void BytecodeCompiler::EnterNode(const DoWhileNode& node) {
+    ScopeGuard scope(*this);
+    myContext->myLoops.emplace_back();
+
+    int start = GetPosition();
+    CompileStatement(node.GetBody());
+    int condition = GetPosition();
+    CompileExpression(node.GetExpression());
+    Emit(OpCode::JumpIfTrue, start);
+
+    PatchAll(myContext->myLoops.back().myBreaks, GetPosition());
+    PatchAll(myContext->myLoops.back().myContinues, condition);
+    myContext->myLoops.pop_back();
+}
+
+void BytecodeCompiler::EnterNode(const ForNode& node) {
+    ScopeGuard scope(*this);
+
+    auto range = dynamic_cast<const BinOperationNode*>(&node.GetExpression());
+    auto rangeSym = dynamic_cast<const RangeSymbol*>(node.GetExpression().GetType());
+    bool isCounted = range != nullptr && range->GetLexeme().GetType() == LexemeType::OpDDot
+        && rangeSym != nullptr && dynamic_cast<const IntegerSymbol*>(rangeSym->GetType()) != nullptr;
+
+    if (isCounted) {
+        CompileExpression(range->GetLeftOperand());
+        CompileExpression(range->GetRightOperand());
+    } else {
+        CompileExpression(node.GetExpression());
+    }
+    int iterator = AllocateTemp();
+    AllocateTemp();
+    AllocateTemp();
+    Emit(isCounted ? OpCode::RangeInit : OpCode::IterInit, iterator);
+
+    myContext->myLoops.emplace_back();
+    int start = GetPosition();
+    int next = Emit(isCounted ? OpCode::RangeNext : OpCode::IterNext, iterator, -1);
+    {
+        ScopeGuard bodyScope(*this);
+        Emit(OpCode::StoreLocal, GetVariable(node.GetVariable().GetSymbol()).GetOffset());
+        CompileStatement(node.GetBody());
+    }
+    Emit(OpCode::Jump, start);
+
+    Patch(next, GetPosition());
+    PatchAll(myContext->myLoops.back().myBreaks, GetPosition());
+    PatchAll(myContext->myLoops.back().myContinues, start);
+    myContext->myLoops.pop_back();
+}
+
+BytecodeCompiler::ContextGuard::ContextGuard(BytecodeCompiler& compiler, Context& context)
+    : myCompiler(compiler), myPrevious(compiler.myContext) {
+    myCompiler.myContext = &context;
+}
+
+BytecodeCompiler::ContextGuard::~ContextGuard() {
+    myCompiler.myContext = myPrevious;
+}
+
+BytecodeCompiler::ScopeGuard::ScopeGuard(BytecodeCompiler& compiler)
+    : myCompiler(compiler), mySlotsCount(compiler.myContext->mySlotsCount) {}
+
+BytecodeCompiler::ScopeGuard::~ScopeGuard() {
+    myCompiler.myContext->mySlotsCount = mySlotsCount;
+}
+
+void BytecodeCompiler::CompileStatement(const ISyntaxNode& node) {
+    auto ifExpression = dynamic_cast<const IfExpression*>(&node);
+    if (ifExpression != nullptr) {
+        CompileIf(*ifExpression, true);
+        return;
+    }
+
+    auto block = dynamic_cast<const BlockNode*>(&node);
+    if (block != nullptr) {
+        for (auto& it : block->GetStatements()) {
+            CompileStatement(*it);
+        }
+        return;
+    }
+
+    node.RunVisitor(*this);
+    if (ProducesValue(node)) {
+        Emit(OpCode::Pop);
+    }
+}
+
+void BytecodeCompiler::CompileExpression(const ISyntaxNode& node) {
+    node.RunVisitor(*this);
+    if (!ProducesValue(node)) {
+        Emit(OpCode::PushUnit);
+    }
+}
+
+void BytecodeCompiler::CompileFunction(const FunctionDeclaration& node, int function) {
+    Context context{ myContext, node.GetDepth(), function, -1, {} };
+    context.mySlotsCount = node.GetFrameSize();
+    myProgram->GetFunction(function).myFrameSize = node.GetFrameSize();
+    ContextGuard guard(*this, context);
+
+    if (dynamic_cast<const BlockNode*>(&node.GetBody()) != nullptr) {
+        CompileStatement(node.GetBody());
+        Emit(OpCode::PushUnit);
+    } else {
+        CompileExpression(node.GetBody());
+    }
+    Emit(OpCode::Return);
+}
+
+void BytecodeCompiler::CompileIf(const IfExpression& node, bool isStatement) {
+    CompileExpression(*node.GetExpression());
+    int elseJump = Emit(OpCode::JumpIfFalse, -1);
+    {
+        ScopeGuard scope(*this);
+        isStatement ? CompileStatement(*node.GetIfBody()) : CompileExpression(*node.GetIfBody());
+    }
+    int endJump = Emit(OpCode::Jump, -1);
+
+    Patch(elseJump, GetPosition());
+    {
+        ScopeGuard scope(*this);
+        isStatement ? CompileStatement(*node.GetElseBody()) : CompileExpression(*node.GetElseBody());
+    }
+    Patch(endJump, GetPosition());
+}
+
+void BytecodeCompiler::CompileArguments(const CallSuffixNode& node) {
+    for (auto& it : node.GetArguments().GetArguments()) {
+        CompileExpression(*it);
+    }
+}
+
+BytecodeCompiler::Assignable BytecodeCompiler::CompileAssignable(const IAnnotatedNode& node) {
+    auto identifier = dynamic_cast<const IdentifierNode*>(&node);
+    if (identifier != nullptr) {
+        return Resolve(*identifier);
+    }
+
+    auto memberAccess = dynamic_cast<const MemberAccessNode*>(&node);
+    if (memberAccess != nullptr) {
+        CompileExpression(*memberAccess->GetExpression());
+        return Assignable{ AssignableKind::Field, 0, GetVariable(memberAccess->GetMember()->GetSymbol()).GetOffset() };
+    }
+
+    auto indexSuffix = dynamic_cast<const IndexSuffixNode*>(&node);
+    if (indexSuffix != nullptr) {
+        for (auto& it : indexSuffix->GetArguments().GetArguments()) {
+            CompileExpression(*it);
+        }
+        CompileExpression(*indexSuffix->GetExpression());
+        return Assignable{ AssignableKind::Index, 0, 0 };
+    }
+
+    throw std::invalid_argument("Unsupported operation");
+}
+
+void BytecodeCompiler::EmitDuplicate(const Assignable& assignable) {
+    if (assignable.myKind == AssignableKind::Field) {
+        Emit(OpCode::Dup);
+    } else if (assignable.myKind == AssignableKind::Index) {
+        Emit(OpCode::Dup2);
+    }
+}
+
+void BytecodeCompiler::EmitLoad(const Assignable& assignable) {
+    switch (assignable.myKind) {
+        case AssignableKind::Variable:
+            if (assignable.myHops == 0) {
+                Emit(OpCode::LoadLocal, assignable.mySlot);
+            } else {
+                Emit(OpCode::LoadOuter, assignable.mySlot, assignable.myHops);
+            }
+            break;
+        case AssignableKind::Field:
+            Emit(OpCode::LoadField, assignable.mySlot);
+            break;
+        case AssignableKind::Index:
+            Emit(OpCode::LoadIndex);
+            break;
+    }
+}
+
+void BytecodeCompiler::EmitStore(const Assignable& assignable) {
+    switch (assignable.myKind) {
+        case AssignableKind::Variable:
+            if (assignable.myHops == 0) {
+                Emit(OpCode::StoreLocal, assignable.mySlot);
+            } else {
+                Emit(OpCode::StoreOuter, assignable.mySlot, assignable.myHops);
+            }
+            break;
+        case AssignableKind::Field:
+            Emit(OpCode::StoreField, assignable.mySlot);
+            break;
+        case AssignableKind::Index:
+            Emit(OpCode::StoreIndex);
+            break;
+    }
+}
+
+void BytecodeCompiler::EmitIncrement(const IAnnotatedNode& operand, LexemeType operation, bool isPrefix) {
+    int one = myProgram->AddConstant(Value(1));
+    int binary = static_cast<int>(operation == LexemeType::OpInc ? LexemeType::OpAdd : LexemeType::OpSub);
+
+    Assignable assignable = CompileAssignable(operand);
+    if (assignable.myKind == AssignableKind::Variable) {
+        EmitLoad(assignable);
+        if (!isPrefix) {
+            Emit(OpCode::Dup);
+        }
+        Emit(OpCode::PushConst, one);
+        Emit(OpCode::Binary, binary);
+        if (isPrefix) {
+            Emit(OpCode::Dup);
+        }
+        EmitStore(assignable);
+        return;
+    }
+
+    int temp = AllocateTemp();
+    EmitDuplicate(assignable);
+    EmitLoad(assignable);
+    if (!isPrefix) {
+        Emit(OpCode::StoreLocal, temp);
+        Emit(OpCode::LoadLocal, temp);
+    }
+    Emit(OpCode::PushConst, one);
+    Emit(OpCode::Binary, binary);
+    if (isPrefix) {
+        Emit(OpCode::Dup);
+        Emit(OpCode::StoreLocal, temp);
+    }
+    EmitStore(assignable);
+    Emit(OpCode::LoadLocal, temp);
+}
+
+int BytecodeCompiler::Emit(OpCode opCode, int first, int second) {
+    std::vector<Instruction>& code = myProgram->GetFunction(myContext->myFunction).myCode;
+    code.push_back(Instruction{ opCode, first, second });
+    return code.size() - 1;
+}
+
+int BytecodeCompiler::GetPosition() const {
+    return myProgram->GetFunction(myContext->myFunction).myCode.size();
+}
+
+void BytecodeCompiler::Patch(int instruction, int target) {
+    Instruction& patched = myProgram->GetFunction(myContext->myFunction).myCode[instruction];
+    if (patched.myOpCode == OpCode::IterNext || patched.myOpCode == OpCode::RangeNext) {
+        patched.mySecond = target;
+    } else {
+        patched.myFirst = target;
+    }
+}
+
+void BytecodeCompiler::PatchAll(const std::vector<int>& instructions, int target) {
+    for (int instruction : instructions) {
+        Patch(instruction, target);
+    }
+}
+
+int BytecodeCompiler::AllocateTemp() {
+    int slot = myContext->mySlotsCount++;
+    CodeFunction& function = myProgram->GetFunction(myContext->myFunction);
+    function.myFrameSize = std::max(function.myFrameSize, myContext->mySlotsCount);
+    return slot;
+}
+
+BytecodeCompiler::Assignable BytecodeCompiler::Resolve(const IdentifierNode& node) const {
+    const VariableSymbol& variable = GetVariable(node.GetSymbol());
+    return Assignable{ AssignableKind::Variable, myContext->myLevel - variable.GetDepth(), variable.GetOffset() };
+}
+
+const VariableSymbol& BytecodeCompiler::GetVariable(const ISymbol* symbol) {
+    auto variable = dynamic_cast<const VariableSymbol*>(symbol);
+    if (variable == nullptr || variable->GetOffset() == -1) {
+        throw std::invalid_argument("Unresolved variable: " + (symbol == nullptr ? std::string() : symbol->GetName()));
+    }
+
+    return *variable;
+}
+
+bool BytecodeCompiler::ProducesValue(const ISyntaxNode& node) {
+    return dynamic_cast<const Assignment*>(&node) == nullptr
+        && dynamic_cast<const AbstractDeclaration*>(&node) == nullptr
+        && dynamic_cast<const LoopNode*>(&node) == nullptr
+        && dynamic_cast<const BreakNode*>(&node) == nullptr
+        && dynamic_cast<const ContinueNode*>(&node) == nullptr
+        && dynamic_cast<const ReturnNode*>(&node) == nullptr
+        && dynamic_cast<const EmptyStatement*>(&node) == nullptr;
+}
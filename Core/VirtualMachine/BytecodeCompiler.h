@@ -0,0 +1,137 @@
+#pragma once
+#include <map>
+#include <vector>
+
+#include "Bytecode.h"
+#include "../Parser/INodeVisitor.h"
+#include "../Parser/Semantics/SymbolTable.h"
+
+class IAnnotatedNode;
+class ISyntaxNode;
+
+class BytecodeCompiler : public INodeVisitor {
+public:
+    BytecodeCompiler(const DeclarationBlock* syntaxTree, const SymbolTable* symbolTable);
+
+    Pointer<Program> Compile();
+
+    void EnterNode(const IVisitable& node) override;
+
+    void EnterNode(const DeclarationBlock& node) override;
+    void EnterNode(const FunctionDeclaration& node) override;
+    void EnterNode(const ClassDeclaration& node) override;
+    void EnterNode(const PropertyDeclaration& node) override;
+
+    void EnterNode(const BlockNode& node) override;
+    void EnterNode(const EmptyStatement& node) override;
+
+    void EnterNode(const CallSuffixNode& node) override;
+    void EnterNode(const UnaryPrefixOperationNode& node) override;
+    void EnterNode(const UnaryPostfixOperationNode& node) override;
+    void EnterNode(const IndexSuffixNode& node) override;
+    void EnterNode(const MemberAccessNode& node) override;
+
+    void EnterNode(const BinOperationNode& node) override;
+    void EnterNode(const IntegerNode& node) override;
+    void EnterNode(const DoubleNode& node) override;
+    void EnterNode(const BooleanNode& node) override;
+    void EnterNode(const StringNode& node) override;
+    void EnterNode(const IdentifierNode& node) override;
+
+    void EnterNode(const Assignment& node) override;
+
+    void EnterNode(const ContinueNode& node) override;
+    void EnterNode(const BreakNode& node) override;
+    void EnterNode(const ReturnNode& node) override;
+
+    void EnterNode(const IfExpression& node) override;
+    void EnterNode(const WhileNode& node) override;
+    void EnterNode(const DoWhileNode& node) override;
+    void EnterNode(const ForNode& node) override;
+
+private:
+    struct Loop {
+        std::vector<int> myBreaks;
+        std::vector<int> myContinues;
+    };
+
+    struct Context {
+        Context* myParent;
+        int myLevel;
+        int myFunction;
+        int myClass;
+        std::vector<Loop> myLoops;
+        int mySlotsCount = 0;
+    };
+
+    struct Declared {
+        int myIndex;
+        int myLevel;
+        int myClass;
+    };
+
+    class ContextGuard {
+    public:
+        ContextGuard(BytecodeCompiler& compiler, Context& context);
+        ~ContextGuard();
+
+    private:
+        BytecodeCompiler& myCompiler;
+        Context* myPrevious;
+    };
+
+    class ScopeGuard {
+    public:
+        explicit ScopeGuard(BytecodeCompiler& compiler);
+        ~ScopeGuard();
+
+    private:
+        BytecodeCompiler& myCompiler;
+        int mySlotsCount;
+    };
+
+    enum class AssignableKind {
+        Variable,
+        Field,
+        Index,
+    };
+
+    struct Assignable {
+        AssignableKind myKind;
+        int myHops;
+        int mySlot;
+    };
+
+    void CompileStatement(const ISyntaxNode& node);
+    void CompileExpression(const ISyntaxNode& node);
+    void CompileFunction(const FunctionDeclaration& node, int function);
+    void CompileIf(const IfExpression& node, bool isStatement);
+    void CompileArguments(const CallSuffixNode& node);
+
+    Assignable CompileAssignable(const IAnnotatedNode& node);
+    void EmitDuplicate(const Assignable& assignable);
+    void EmitLoad(const Assignable& assignable);
+    void EmitStore(const Assignable& assignable);
+
+    void EmitIncrement(const IAnnotatedNode& operand, LexemeType operation, bool isPrefix);
+
+    int Emit(OpCode opCode, int first = 0, int second = 0);
+    int GetPosition() const;
+    void Patch(int instruction, int target);
+    void PatchAll(const std::vector<int>& instructions, int target);
+
+    int AllocateTemp();
+    Assignable Resolve(const IdentifierNode& node) const;
+    static const VariableSymbol& GetVariable(const ISymbol* symbol);
+
+    static bool ProducesValue(const ISyntaxNode& node);
+
+    const DeclarationBlock* myTree;
+    const SymbolTable* myTable;
+
+    Pointer<Program> myProgram;
+    Context* myContext = nullptr;
+
+    std::map<const ISymbol*, Declared> myFunctions;
+    std::map<const ISymbol*, Declared> myClasses;
+};
@@ -0,0 +1,53 @@
+#include "Frame.h"
+#include "../Interpreter/GarbageCollector.h"
+
+void Frame::Trace(GarbageCollector& collector) const {
+    if (!collector.Mark(this)) {
+        return;
+    }
+
+    for (auto& it : mySlots) {
+        collector.MarkValue(it);
+    }
+    collector.MarkVariable(myOwner);
+
+    if (myParent != nullptr) {
+        myParent->Trace(collector);
+    }
+}
+
+Instance::Instance(int fieldsCount, Frame* parent) {
+    myFrame.mySlots.resize(fieldsCount);
+    myFrame.myParent = parent;
+    myFrame.myOwner = this;
+}
+
+Frame& Instance::GetFrame() {
+    return myFrame;
+}
+
+Pointer<IVariable> Instance::Clone() const {
+    throw std::invalid_argument("Unsupported operation");
+}
+
+Pointer<IVariable> Instance::ApplyOperation(LexemeType operation, const IVariable* lhs) const {
+    throw std::invalid_argument("Unsupported operation");
+}
+
+void Instance::Trace(GarbageCollector& collector) const {
+    myFrame.Trace(collector);
+}
+
+InstanceRef::InstanceRef(Instance* instance) : Reference(instance) {}
+
+Pointer<Reference> InstanceRef::CloneRef() const {
+    return std::make_unique<InstanceRef>(Dereference<Instance>());
+}
+
+Pointer<IVariable> InstanceRef::ApplyOperation(LexemeType operation, const IVariable* lhs) const {
+    if (LexerUtils::IsEqualityOperation(operation)) {
+        return CheckStrictEquality(operation, lhs);
+    }
+
+    throw std::invalid_argument("Unsupported operation");
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+
+#include "../Interpreter/Value.h"
+#include "../Interpreter/Variable.h"
+
+struct Frame {
+    std::vector<Value> mySlots;
+    Frame* myParent = nullptr;
+    const IVariable* myOwner = nullptr;
+
+    void Trace(GarbageCollector& collector) const;
+};
+
+class Instance : public IVariable {
+public:
+    Instance(int fieldsCount, Frame* parent);
+
+    Frame& GetFrame();
+
+    Pointer<IVariable> Clone() const override;
+    Pointer<IVariable> ApplyOperation(LexemeType operation, const IVariable* lhs) const override;
+
+    void Trace(GarbageCollector& collector) const override;
+
+private:
+    Frame myFrame;
+};
+
+class InstanceRef : public Reference {
+public:
+    explicit InstanceRef(Instance* instance);
+
+    Pointer<Reference> CloneRef() const override;
+
+    Pointer<IVariable> ApplyOperation(LexemeType operation, const IVariable* lhs) const override;
+};
@@ -0,0 +1,390 @@
+#include "VirtualMachine.h"
+
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+
+VirtualMachine::VirtualMachine(const Program* program, std::ostream& output)
+    : myProgram(program), myOutput(output), myHeap([this](GarbageCollector& collector) { MarkRoots(collector); }) {}
+
+void VirtualMachine::RunMain() {
+    if (myProgram->GetMain() == -1) {
+        myOutput << "No main method found in project" << std::endl;
+        return;
+    }
+
+    EnterFunction(myProgram->GetEntry(), nullptr, true);
+    Execute();
+}
+
+const GcStatistics& VirtualMachine::GetGcStatistics() const {
+    return myHeap.GetStatistics();
+}
+
+void VirtualMachine::Execute() {
+    while (!myCalls.empty()) {
+        CallFrame& call = myCalls.back();
+        const Instruction& instruction = call.myFunction->myCode[call.myIp++];
+        Frame* frame = call.myFrame;
+
+        switch (instruction.myOpCode) {
+            case OpCode::PushConst:
+                Push(myProgram->GetConstant(instruction.myFirst));
+                break;
+            case OpCode::PushUnit:
+                Push(Value());
+                break;
+            case OpCode::Pop:
+                myStack.pop_back();
+                break;
+            case OpCode::Dup:
+                Push(myStack.back());
+                break;
+            case OpCode::Dup2: {
+                size_t size = myStack.size();
+                Push(myStack[size - 2]);
+                Push(myStack[size - 1]);
+                break;
+            }
+            case OpCode::Swap:
+                std::swap(myStack[myStack.size() - 1], myStack[myStack.size() - 2]);
+                break;
+
+            case OpCode::LoadLocal:
+                Push(frame->mySlots[instruction.myFirst]);
+                break;
+            case OpCode::StoreLocal:
+                frame->mySlots[instruction.myFirst] = Pop();
+                break;
+            case OpCode::LoadOuter:
+                Push(GetOuter(frame, instruction.mySecond)->mySlots[instruction.myFirst]);
+                break;
+            case OpCode::StoreOuter:
+                GetOuter(frame, instruction.mySecond)->mySlots[instruction.myFirst] = Pop();
+                break;
+            case OpCode::LoadField: {
+                Value object = Pop();
+                Push(GetFields(object).mySlots[instruction.myFirst]);
+                break;
+            }
+            case OpCode::StoreField: {
+                Value value = Pop();
+                Value object = Pop();
+                GetFields(object).mySlots[instruction.myFirst] = value;
+                break;
+            }
+            case OpCode::LoadIndex: {
+                Value array = Pop();
+                Value idx = Pop();
+                StructArray* elements = GetElements(array, idx.Get<int>());
+                if (elements->IsPacked()) {
+                    Push(elements->GetElement(idx.Get<int>()));
+                } else {
+                    Push(ToValue(elements->GetVariable(idx.Get<int>())));
+                }
+                break;
+            }
+            case OpCode::StoreIndex: {
+                Value value = Pop();
+                Value array = Pop();
+                Value idx = Pop();
+                StructArray* elements = GetElements(array, idx.Get<int>());
+                if (elements->IsPacked()) {
+                    elements->SetElement(idx.Get<int>(), value);
+                } else {
+                    elements->GetVariable(idx.Get<int>())->Assign(*ToVariable(value));
+                }
+                break;
+            }
+
+            case OpCode::Unary: {
+                auto operation = static_cast<LexemeType>(instruction.myFirst);
+                Value operand = Pop();
+                if (operand.IsObject()) {
+                    Push(ToValue(ToVariable(operand)->ApplyOperation(operation)));
+                } else {
+                    Push(Value::ApplyOperation(operation, operand));
+                }
+                break;
+            }
+            case OpCode::Binary: {
+                auto operation = static_cast<LexemeType>(instruction.myFirst);
+                Value rhs = Pop();
+                Value lhs = Pop();
+                if (lhs.IsObject() || rhs.IsObject() || operation == LexemeType::OpDDot) {
+                    Push(ToValue(ToVariable(rhs)->ApplyOperation(operation, ToVariable(lhs).get())));
+                } else {
+                    Push(Value::ApplyOperation(operation, lhs, rhs));
+                }
+                break;
+            }
+
+            case OpCode::Jump:
+                call.myIp = instruction.myFirst;
+                break;
+            case OpCode::JumpIfFalse:
+                if (!Pop().Get<bool>()) {
+                    call.myIp = instruction.myFirst;
+                }
+                break;
+            case OpCode::JumpIfTrue:
+                if (Pop().Get<bool>()) {
+                    call.myIp = instruction.myFirst;
+                }
+                break;
+
+            case OpCode::Call:
+                EnterFunction(instruction.myFirst, GetOuter(frame, instruction.mySecond), false);
+                break;
+            case OpCode::CallMethod: {
+                const CodeFunction& function = myProgram->GetFunction(instruction.myFirst);
+                auto receiver = myStack.end() - function.myParametersCount - 1;
+                Frame* fields = &GetFields(*receiver);
+                myStack.erase(receiver);
+                EnterFunction(instruction.myFirst, fields, false);
+                break;
+            }
+            case OpCode::New: {
+                const ClassLayout& layout = myProgram->GetClass(instruction.myFirst);
+                auto instance = static_cast<Instance*>(LoadOnHeap(
+                    std::make_unique<Instance>(layout.myFieldsCount, GetOuter(frame, instruction.mySecond))));
+                Push(Value(instance));
+                EnterFunction(layout.myConstructor, &instance->GetFrame(), true);
+                break;
+            }
+            case OpCode::Return:
+                LeaveFunction();
+                break;
+
+            case OpCode::IterInit: {
+                Value iterable = Pop();
+                frame->mySlots[instruction.myFirst] = iterable;
+                frame->mySlots[instruction.myFirst + 1] = Value(0);
+                frame->mySlots[instruction.myFirst + 2] = Value(dynamic_cast<IterableRef*>(ToVariable(iterable).get())->Size());
+                break;
+            }
+            case OpCode::IterNext: {
+                int current = frame->mySlots[instruction.myFirst + 1].Get<int>();
+                if (current >= frame->mySlots[instruction.myFirst + 2].Get<int>()) {
+                    call.myIp = instruction.mySecond;
+                    break;
+                }
+
+                IVariable* iterable = frame->mySlots[instruction.myFirst].Get<IVariable*>();
+                auto elements = dynamic_cast<StructArray*>(iterable);
+                if (elements != nullptr && elements->IsPacked()) {
+                    Push(elements->GetElement(current));
+                } else if (elements != nullptr) {
+                    Push(ToValue(elements->GetVariable(current)));
+                } else {
+                    const IVariable* left = static_cast<StructRange*>(iterable)->GetLeft();
+                    Push(Value::ApplyOperation(LexemeType::OpAdd, left->AsValue(), Value(current)));
+                }
+                frame->mySlots[instruction.myFirst + 1] = Value(current + 1);
+                break;
+            }
+            case OpCode::RangeInit: {
+                int last = Pop().Get<int>();
+                int first = Pop().Get<int>();
+                frame->mySlots[instruction.myFirst] = Value(first);
+                frame->mySlots[instruction.myFirst + 1] = Value(0);
+                frame->mySlots[instruction.myFirst + 2] = Value(last - first + 1);
+                break;
+            }
+            case OpCode::RangeNext: {
+                int current = frame->mySlots[instruction.myFirst + 1].Get<int>();
+                if (current >= frame->mySlots[instruction.myFirst + 2].Get<int>()) {
+                    call.myIp = instruction.mySecond;
+                    break;
+                }
+
+                Push(Value(frame->mySlots[instruction.myFirst].Get<int>() + current));
+                frame->mySlots[instruction.myFirst + 1] = Value(current + 1);
+                break;
+            }
+
+            case OpCode::Println:
+                Println(static_cast<PrintKind>(instruction.myFirst), instruction.mySecond);
+                break;
+            case OpCode::ArrayOf:
+                ArrayOf(instruction.myFirst, static_cast<ValueTag>(instruction.mySecond));
+                break;
+            case OpCode::Cast:
+                Cast(static_cast<CastKind>(instruction.myFirst));
+                break;
+        }
+    }
+}
+
+void VirtualMachine::EnterFunction(int function, Frame* parent, bool isDiscardResult) {
+    const CodeFunction& code = myProgram->GetFunction(function);
+
+    myActivations.emplace_back();
+    Frame& frame = myActivations.back();
+    frame.mySlots.resize(code.myFrameSize);
+    frame.myParent = parent;
+
+    size_t base = myStack.size() - code.myParametersCount;
+    std::copy(myStack.begin() + base, myStack.end(), frame.mySlots.begin());
+    myStack.resize(base);
+
+    myCalls.push_back(CallFrame{ &code, 0, &frame, base, isDiscardResult });
+}
+
+void VirtualMachine::LeaveFunction() {
+    Value result = Pop();
+    bool isDiscardResult = myCalls.back().isDiscardResult;
+
+    myStack.resize(myCalls.back().myStackBase);
+    myCalls.pop_back();
+    myActivations.pop_back();
+
+    if (!isDiscardResult) {
+        Push(result);
+    }
+}
+
+IVariable* VirtualMachine::LoadOnHeap(Pointer<IVariable> variable) {
+    return myHeap.Allocate(std::move(variable));
+}
+
+void VirtualMachine::MarkRoots(GarbageCollector& collector) const {
+    for (auto& it : myStack) {
+        collector.MarkValue(it);
+    }
+    for (auto& it : myActivations) {
+        it.Trace(collector);
+    }
+}
+
+void VirtualMachine::Push(const Value& value) {
+    myStack.push_back(value);
+}
+
+Value VirtualMachine::Pop() {
+    Value value = myStack.back();
+    myStack.pop_back();
+    return value;
+}
+
+Value VirtualMachine::ToValue(Pointer<IVariable> variable) {
+    if (variable == nullptr) {
+        return Value();
+    }
+    if (dynamic_cast<String*>(variable.get()) || dynamic_cast<StructRange*>(variable.get())) {
+        return Value(LoadOnHeap(std::move(variable)));
+    }
+
+    return variable->AsValue();
+}
+
+Value VirtualMachine::ToValue(const IVariable* variable) {
+    if (dynamic_cast<const String*>(variable)) {
+        return Value(LoadOnHeap(variable->Clone()));
+    }
+
+    return variable->AsValue();
+}
+
+Pointer<IVariable> VirtualMachine::ToVariable(const Value& value) {
+    if (!value.IsObject()) {
+        return IVariable::FromValue(value);
+    }
+
+    IVariable* object = value.Get<IVariable*>();
+    if (auto elements = dynamic_cast<StructArray*>(object)) {
+        return std::make_unique<Array>(elements);
+    }
+    if (auto range = dynamic_cast<StructRange*>(object)) {
+        return std::make_unique<Range>(range);
+    }
+    if (auto instance = dynamic_cast<Instance*>(object)) {
+        return std::make_unique<InstanceRef>(instance);
+    }
+
+    return object->Clone();
+}
+
+Frame* VirtualMachine::GetOuter(Frame* frame, int hops) {
+    for (int i = 0; i < hops; i++) {
+        frame = frame->myParent;
+    }
+    return frame;
+}
+
+Frame& VirtualMachine::GetFields(const Value& object) {
+    return static_cast<Instance*>(object.Get<IVariable*>())->GetFrame();
+}
+
+StructArray* VirtualMachine::GetElements(const Value& array, int idx) {
+    auto elements = static_cast<StructArray*>(array.Get<IVariable*>());
+    if (idx < 0 || idx >= elements->Size()) {
+        throw std::invalid_argument("Index " + std::to_string(idx) + " out of bounds for length " + std::to_string(elements->Size()));
+    }
+    return elements;
+}
+
+void VirtualMachine::Println(PrintKind kind, int argumentsCount) {
+    Value value = argumentsCount > 0 ? Pop() : Value();
+
+    myOutput.unsetf(std::ios_base::fixed);
+    myOutput << std::setprecision(16);
+
+    switch (kind) {
+        case PrintKind::Int:
+            myOutput << value.Get<int>() << std::endl;
+            break;
+        case PrintKind::Double:
+            Value::PrintDouble(myOutput, value.Get<double>());
+            myOutput << std::endl;
+            break;
+        case PrintKind::String:
+            myOutput << value.Get<IVariable*>()->GetValue<std::string>() << std::endl;
+            break;
+        case PrintKind::Boolean:
+            myOutput << (value.Get<bool>() ? "true" : "false") << std::endl;
+            break;
+        case PrintKind::None:
+            if (argumentsCount == 0) {
+                myOutput << std::endl;
+            }
+            break;
+    }
+
+    Push(Value());
+}
+
+void VirtualMachine::ArrayOf(int argumentsCount, ValueTag elementTag) {
+    if (elementTag != ValueTag::Object) {
+        std::vector<Value> elements(myStack.end() - argumentsCount, myStack.end());
+        myStack.resize(myStack.size() - argumentsCount);
+        Push(Value(LoadOnHeap(std::make_unique<StructArray>(elementTag, elements))));
+        return;
+    }
+
+    std::vector<Pointer<IVariable>> arguments;
+    std::vector<IVariable*> argsRefs;
+    for (auto it = myStack.end() - argumentsCount; it != myStack.end(); ++it) {
+        arguments.push_back(ToVariable(*it));
+        argsRefs.push_back(arguments.back().get());
+    }
+    myStack.resize(myStack.size() - argumentsCount);
+
+    Push(Value(LoadOnHeap(std::make_unique<StructArray>(argsRefs))));
+}
+
+void VirtualMachine::Cast(CastKind kind) {
+    Pointer<IVariable> variable = ToVariable(Pop());
+    auto valType = dynamic_cast<ValueType*>(variable.get());
+    switch (kind) {
+        case CastKind::ToInt:
+            Push(ToValue(valType->Cast(Integer(0))));
+            break;
+        case CastKind::ToDouble:
+            Push(ToValue(valType->Cast(Double(0))));
+            break;
+        case CastKind::ToString:
+            Push(ToValue(valType->Cast(String(""))));
+            break;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <deque>
+#include <iostream>
+#include <vector>
+
+#include "Bytecode.h"
+#include "Frame.h"
+#include "../Interpreter/GarbageCollector.h"
+
+class VirtualMachine {
+public:
+    explicit VirtualMachine(const Program* program, std::ostream& output = std::cout);
+
+    void RunMain();
+
+    const GcStatistics& GetGcStatistics() const;
+
+private:
+    struct CallFrame {
+        const CodeFunction* myFunction;
+        int myIp;
+        Frame* myFrame;
+        size_t myStackBase;
+        bool isDiscardResult;
+    };
+
+    void Execute();
+
+    void EnterFunction(int function, Frame* parent, bool isDiscardResult);
+    void LeaveFunction();
+
+    IVariable* LoadOnHeap(Pointer<IVariable> variable);
+    void MarkRoots(GarbageCollector& collector) const;
+    void Push(const Value& value);
+    Value Pop();
+
+    Value ToValue(Pointer<IVariable> variable);
+    Value ToValue(const IVariable* variable);
+    static Pointer<IVariable> ToVariable(const Value& value);
+
+    static Frame* GetOuter(Frame* frame, int hops);
+    static Frame& GetFields(const Value& object);
+    static StructArray* GetElements(const Value& array, int idx);
+
+    void Println(PrintKind kind, int argumentsCount);
+    void ArrayOf(int argumentsCount, ValueTag elementTag);
+    void Cast(CastKind kind);
+
+    const Program* myProgram;
+    std::ostream& myOutput;
+
+    std::vector<Value> myStack;
+    std::vector<CallFrame> myCalls;
+    std::deque<Frame> myActivations;
+    GarbageCollector myHeap;
+};
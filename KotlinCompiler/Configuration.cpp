@@ -14,6 +14,54 @@ bool Configuration::GetSemanticsDebug() const {
     return isSemanticsDebugOption;
 }
 
+bool Configuration::GetTreeWalker() const {
+    return isTreeWalkerOption;
+}
+
+bool Configuration::GetBytecodeDebug() const {
+    return isBytecodeDebugOption;
+}
+
+bool Configuration::GetFoldingDebug() const {
+    return isFoldingDebugOption;
+}
+
+bool Configuration::GetGcStatistics() const {
+    return isGcStatisticsOption;
+}
+
+bool Configuration::GetCacheStatistics() const {
+    return isCacheStatisticsOption;
+}
+
+bool Configuration::GetBatch() const {
+    return isBatchOption;
+}
+
+int Configuration::GetJobs() const {
+    return myJobs;
+}
+
+int Configuration::GetJitThreshold() const {
+    return myJitThreshold;
+}
+
+const std::string& Configuration::GetServerSocket() const {
+    return myServerSocket;
+}
+
+const std::string& Configuration::GetCacheDirectory() const {
+    return myCacheDirectory;
+}
+
+const std::string& Configuration::GetAstOutput() const {
+    return myAstOutput;
+}
+
+const std::string& Configuration::GetCOutput() const {
+    return myCOutput;
+}
+
 const std::vector<std::string>& Configuration::GetPaths() const {
     return myPaths;
 }
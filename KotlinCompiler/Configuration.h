@@ -11,6 +11,20 @@ public:
 
     bool GetSemanticsDebug() const;
 
+    bool GetTreeWalker() const;
+
+    bool GetBytecodeDebug() const;
+    bool GetFoldingDebug() const;
+    bool GetGcStatistics() const;
+    bool GetCacheStatistics() const;
+    bool GetBatch() const;
+    int GetJobs() const;
+    int GetJitThreshold() const;
+    const std::string& GetServerSocket() const;
+    const std::string& GetCacheDirectory() const;
+    const std::string& GetAstOutput() const;
+    const std::string& GetCOutput() const;
+
     const std::vector<std::string>& GetPaths() const;
 
 private:
@@ -21,6 +35,18 @@ private:
     bool isLexerDebugOption = false;
     bool isParserDebugOption = false;
     bool isSemanticsDebugOption = false;
+    bool isTreeWalkerOption = false;
+    bool isBytecodeDebugOption = false;
+    bool isFoldingDebugOption = false;
+    bool isGcStatisticsOption = false;
+    bool isCacheStatisticsOption = false;
+    bool isBatchOption = false;
+    int myJobs = 1;
+    int myJitThreshold = 0;
+    std::string myServerSocket;
+    std::string myCacheDirectory;
+    std::string myAstOutput;
+    std::string myCOutput;
 
     friend class ConfigurationBuilder;
 };
\ No newline at end of file
@@ -1,7 +1,36 @@
 #include "ConfigurationBuilder.h"
 
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
 ConfigurationBuilder& ConfigurationBuilder::AddPaths(const std::vector<std::string>& paths) {
-    myConfiguration.myPaths = paths;
+    myConfiguration.myPaths.insert(myConfiguration.myPaths.end(), paths.begin(), paths.end());
+    return *this;
+}
+
+// One source path per line, relative to the manifest; blank lines and lines starting with '#' are skipped
+ConfigurationBuilder& ConfigurationBuilder::AddManifest(const std::string& manifestPath) {
+    std::ifstream manifest(manifestPath);
+    if (!manifest) {
+        throw std::invalid_argument("Cannot open manifest: " + manifestPath);
+    }
+
+    std::filesystem::path manifestDir = std::filesystem::path(manifestPath).parent_path();
+    std::string line;
+    while (std::getline(manifest, line)) {
+        size_t begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string::npos || line[begin] == '#') {
+            continue;
+        }
+
+        size_t end = line.find_last_not_of(" \t\r");
+        std::filesystem::path sourcePath(line.substr(begin, end - begin + 1));
+        if (sourcePath.is_relative()) {
+            sourcePath = manifestDir / sourcePath;
+        }
+        myConfiguration.myPaths.push_back(sourcePath.string());
+    }
     return *this;
 }
 
@@ -20,6 +49,66 @@ ConfigurationBuilder& ConfigurationBuilder::SetSemanticsDebug() {
     return *this;
 }
 
+ConfigurationBuilder& ConfigurationBuilder::SetTreeWalker() {
+    myConfiguration.isTreeWalkerOption = true;
+    return *this;
+}
+
+ConfigurationBuilder& ConfigurationBuilder::SetBytecodeDebug() {
+    myConfiguration.isBytecodeDebugOption = true;
+    return *this;
+}
+
+ConfigurationBuilder& ConfigurationBuilder::SetFoldingDebug() {
+    myConfiguration.isFoldingDebugOption = true;
+    return *this;
+}
+
+ConfigurationBuilder& ConfigurationBuilder::SetGcStatistics() {
+    myConfiguration.isGcStatisticsOption = true;
+    return *this;
+}
+
+ConfigurationBuilder& ConfigurationBuilder::SetCacheStatistics() {
+    myConfiguration.isCacheStatisticsOption = true;
+    return *this;
+}
+
+ConfigurationBuilder& ConfigurationBuilder::SetBatch() {
+    myConfiguration.isBatchOption = true;
+    return *this;
+}
+
+ConfigurationBuilder& ConfigurationBuilder::SetJobs(int jobs) {
+    myConfiguration.myJobs = jobs;
+    return *this;
+}
+
+ConfigurationBuilder& ConfigurationBuilder::SetJitThreshold(int calls) {
+    myConfiguration.myJitThreshold = calls;
+    return *this;
+}
+
+ConfigurationBuilder& ConfigurationBuilder::SetServerSocket(const std::string& socketPath) {
+    myConfiguration.myServerSocket = socketPath;
+    return *this;
+}
+
+ConfigurationBuilder& ConfigurationBuilder::SetCacheDirectory(const std::string& directory) {
+    myConfiguration.myCacheDirectory = directory;
+    return *this;
+}
+
+ConfigurationBuilder& ConfigurationBuilder::SetAstOutput(const std::string& path) {
+    myConfiguration.myAstOutput = path;
+    return *this;
+}
+
+ConfigurationBuilder& ConfigurationBuilder::SetCOutput(const std::string& path) {
+    myConfiguration.myCOutput = path;
+    return *this;
+}
+
 Configuration ConfigurationBuilder::Build() const {
     return myConfiguration;
 }
@@ -10,7 +10,20 @@ public:
     ConfigurationBuilder& SetLexerDebug();
     ConfigurationBuilder& SetParserDebug();
     ConfigurationBuilder& SetSemanticsDebug();
+    ConfigurationBuilder& SetTreeWalker();
+    ConfigurationBuilder& SetBytecodeDebug();
+    ConfigurationBuilder& SetFoldingDebug();
+    ConfigurationBuilder& SetGcStatistics();
+    ConfigurationBuilder& SetCacheStatistics();
+    ConfigurationBuilder& SetBatch();
+    ConfigurationBuilder& SetJobs(int jobs);
+    ConfigurationBuilder& SetJitThreshold(int calls);
+    ConfigurationBuilder& SetServerSocket(const std::string& socketPath);
+    ConfigurationBuilder& SetCacheDirectory(const std::string& directory);
+    ConfigurationBuilder& SetAstOutput(const std::string& path);
+    ConfigurationBuilder& SetCOutput(const std::string& path);
     ConfigurationBuilder& AddPaths(const std::vector<std::string>& paths);
+    ConfigurationBuilder& AddManifest(const std::string& manifestPath);
 
     Configuration Build() const;
 
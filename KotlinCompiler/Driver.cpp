@@ -0,0 +1,369 @@
+#include "Driver.h"
+
+#include "CodeGen/CGenerator.h"
+#include "Lexer/Lexer.h"
+#include "Parser/AstReader.h"
+#include "Parser/AstWriter.h"
+#include "Parser/FlatTree.h"
+#include "PrintVisitors.h"
+#include "Interpreter/ConstantFolder.h"
+#include "Interpreter/Interpreter.h"
+#include "VirtualMachine/BytecodeCompiler.h"
+#include "VirtualMachine/VirtualMachine.h"
+#include "Parser/Parser.h"
+#include "Parser/ParserError.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+Driver::Driver(const Configuration& configuration) : myConfiguration(configuration) {
+    // Debug output and the tree walker need the syntax tree, which is not cached
+    bool isCacheable = !myConfiguration.GetLexerDebug() && !myConfiguration.GetParserDebug()
+        && !myConfiguration.GetSemanticsDebug() && !myConfiguration.GetFoldingDebug() && !myConfiguration.GetTreeWalker()
+        && myConfiguration.GetJitThreshold() == 0
+        && myConfiguration.GetAstOutput().empty() && myConfiguration.GetCOutput().empty();
+    if (isCacheable && !myConfiguration.GetCacheDirectory().empty()) {
+        myCache = std::make_unique<ProgramCache>(myConfiguration.GetCacheDirectory());
+    }
+}
+
+int Driver::Run(const std::string& path, SymbolTable* prelude) const {
+    Pointer<CompilationUnit> unit;
+    try {
+        unit = CheckFile(path, prelude);
+    } catch (const std::invalid_argument& error) {
+        std::cout << path << " :: " << error.what() << std::endl;
+        return 1;
+    }
+    std::cout << unit->myDiagnostics;
+
+    if (unit->myErrorsCount != 0) {
+        return 1;
+    }
+
+    if (!myConfiguration.GetAstOutput().empty()) {
+        std::ofstream output(myConfiguration.GetAstOutput(), std::ios::binary);
+        AstWriter(unit->myTable.get()).Write(*unit->mySyntaxTree, output);
+        if (!output) {
+            std::cout << "Cannot write " << myConfiguration.GetAstOutput() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!myConfiguration.GetCOutput().empty()) {
+        std::string source;
+        try {
+            source = CGenerator(unit->mySyntaxTree.get(), unit->myTable.get()).Generate();
+        } catch (const std::invalid_argument& error) {
+            std::cout << "Cannot generate C: " << error.what() << std::endl;
+            return 1;
+        }
+
+        std::ofstream output(myConfiguration.GetCOutput());
+        output << source;
+        if (!output) {
+            std::cout << "Cannot write " << myConfiguration.GetCOutput() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    try {
+        Execute(*unit);
+    } catch (const std::invalid_argument& error) {
+        std::cout << "Runtime error: " << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int Driver::RunBatch(const std::vector<std::string>& paths) const {
+    SymbolTable prelude;
+    prelude.Freeze();
+
+    size_t jobs = std::min<size_t>(std::max(myConfiguration.GetJobs(), 1), paths.size());
+    std::vector<std::promise<Pointer<CompilationUnit>>> checked(jobs > 1 ? paths.size() : 0);
+    std::vector<std::thread> workers;
+
+    // Workers pick the next unchecked file themselves, but stay within a window ahead of the
+    // consumer so that finished units don't pile up in memory
+    std::mutex windowMutex;
+    std::condition_variable windowMoved;
+    size_t consumed = 0;
+    const size_t window = jobs * 4;
+    std::atomic<size_t> nextFile(0);
+
+    if (jobs > 1) {
+        for (size_t i = 0; i < jobs; i++) {
+            workers.emplace_back([&]() {
+                for (size_t idx = nextFile++; idx < paths.size(); idx = nextFile++) {
+                    {
+                        std::unique_lock<std::mutex> lock(windowMutex);
+                        windowMoved.wait(lock, [&]() { return idx < consumed + window; });
+                    }
+
+                    try {
+                        checked[idx].set_value(CheckFile(paths[idx], &prelude));
+                    } catch (...) {
+                        checked[idx].set_exception(std::current_exception());
+                    }
+                }
+            });
+        }
+    }
+
+    std::vector<FileResult> results;
+    for (size_t idx = 0; idx < paths.size(); idx++) {
+        std::cout << "=== " << paths[idx] << std::endl;
+
+        results.push_back(Complete(paths[idx], [&]() {
+            return jobs > 1 ? checked[idx].get_future().get() : CheckFile(paths[idx], &prelude);
+        }, true));
+        std::cout.flush();
+
+        {
+            std::lock_guard<std::mutex> lock(windowMutex);
+            consumed = idx + 1;
+        }
+        windowMoved.notify_all();
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    PrintSummary(results);
+
+    for (auto& result : results) {
+        if (result.myStatus != FileStatus::Passed) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+Pointer<CompilationUnit> Driver::CheckFile(const std::string& path, SymbolTable* prelude) const {
+    if (!std::ifstream(path)) {
+        throw std::invalid_argument("Cannot open file");
+    }
+    return Check(path, prelude);
+}
+
+FileResult Driver::Complete(const std::string& path, const std::function<Pointer<CompilationUnit>()>& checkUnit, bool isExecuting) const {
+    FileResult result;
+    result.myPath = path;
+    try {
+        Pointer<CompilationUnit> unit = checkUnit();
+        std::cout << unit->myDiagnostics;
+        result.myMilliseconds = unit->myMilliseconds;
+
+        if (unit->myErrorsCount != 0) {
+            result.myStatus = FileStatus::Failed;
+            result.myMessage = std::to_string(unit->myErrorsCount) + (unit->myErrorsCount == 1 ? " error" : " errors");
+        } else if (isExecuting) {
+            auto start = std::chrono::steady_clock::now();
+            Execute(*unit);
+            result.myMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    } catch (const std::exception& e) {
+        result.myStatus = FileStatus::Crashed;
+        result.myMessage = e.what();
+    }
+
+    return result;
+}
+
+Pointer<CompilationUnit> Driver::Check(const std::string& path, SymbolTable* prelude) const {
+    auto start = std::chrono::steady_clock::now();
+    Pointer<CompilationUnit> unit = std::make_unique<CompilationUnit>();
+    std::ostringstream out;
+
+    if (myCache) {
+        std::ifstream input(path, std::ios::binary);
+        if (input) {
+            std::string source((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+            unit->myCacheKey = ProgramCache::GetKey(source);
+            unit->myProgram = myCache->Load(unit->myCacheKey);
+        }
+
+        if (unit->myProgram) {
+            unit->myMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            return unit;
+        }
+    }
+
+    bool isAstFile = AstReader::IsAstFile(path);
+    if (myConfiguration.GetLexerDebug() && !isAstFile) {
+        Lexer lexer(path);
+        lexer.NextLexeme();
+
+        while (lexer.GetLexeme().GetType() != Lexeme::LexemeType::EndOfFile) {
+            out << lexer.NextLexeme() << std::endl;
+        }
+    }
+
+    ArenaScope arenaScope(unit->myArena);
+
+    unit->myTable = std::make_unique<SymbolTable>(prelude);
+    std::ostringstream errors;
+    if (isAstFile) {
+        try {
+            unit->mySyntaxTree = AstReader(path, unit->myTable.get()).Read();
+        } catch (const std::invalid_argument& e) {
+            unit->myDiagnostics = out.str() + path + " :: " + e.what() + "\n";
+            unit->myErrorsCount = 1;
+            return unit;
+        }
+    } else {
+        Lexer lexer(path);
+        Parser parser(lexer, unit->myTable.get());
+        unit->mySyntaxTree = parser.Parse();
+
+        for (auto& error : parser.GetParsingErrors()) {
+            errors << error << std::endl;
+        }
+
+        for (auto& error : parser.GetSemanticsErrors()) {
+            errors << error << std::endl;
+        }
+
+        unit->myErrorsCount = parser.GetParsingErrors().size() + parser.GetSemanticsErrors().size();
+    }
+
+    // The dump and the constant folder share one flat layout of the checked tree
+    std::optional<FlatTree> flatTree;
+    if (myConfiguration.GetParserDebug() || unit->myErrorsCount == 0) {
+        flatTree.emplace(*unit->mySyntaxTree);
+    }
+
+    if (myConfiguration.GetParserDebug()) {
+        out << std::endl;
+        PrintTree(*flatTree, out);
+    }
+
+    if (myConfiguration.GetSemanticsDebug()) {
+        out << std::endl;
+        CuteToStringVisitor visitor;
+        unit->myTable->RunVisitor(visitor);
+        for (auto& str : visitor.GetStringData()) {
+            out << str << std::endl;
+        }
+
+        out << std::endl;
+    }
+
+    if (unit->myErrorsCount == 0) {
+        ConstantFolder().Fold(*unit->mySyntaxTree, *flatTree);
+        flatTree.reset();
+
+        if (myConfiguration.GetFoldingDebug()) {
+            PrintTree(FlatTree(*unit->mySyntaxTree), out);
+            out << std::endl;
+        }
+    }
+
+    out << errors.str();
+    unit->myDiagnostics = out.str();
+    unit->myMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return unit;
+}
+
+void Driver::Execute(CompilationUnit& unit) const {
+    ArenaScope arenaScope(unit.myArena);
+
+    if (myConfiguration.GetTreeWalker() || myConfiguration.GetJitThreshold() != 0) {
+        Interpreter interpreter(unit.mySyntaxTree.get(), unit.myTable.get());
+        if (myConfiguration.GetJitThreshold() != 0) {
+            interpreter.EnableJit(myConfiguration.GetJitThreshold());
+        }
+        interpreter.RunMain();
+        if (myConfiguration.GetGcStatistics()) {
+            PrintGcStatistics(interpreter.GetGcStatistics());
+        }
+        return;
+    }
+
+    // Only a cache hit comes here with a compiled program
+    bool isCacheHit = unit.myProgram != nullptr;
+    if (!unit.myProgram) {
+        BytecodeCompiler compiler(unit.mySyntaxTree.get(), unit.myTable.get());
+        unit.myProgram = compiler.Compile();
+        if (myCache && !unit.myCacheKey.empty()) {
+            myCache->Store(unit.myCacheKey, *unit.myProgram);
+        }
+    }
+    if (myConfiguration.GetCacheStatistics() && !unit.myCacheKey.empty()) {
+        std::cerr << (isCacheHit ? "Cache hit: " : "Cache store: ") << unit.myCacheKey << std::endl;
+    }
+
+    if (myConfiguration.GetBytecodeDebug()) {
+        std::cout << unit.myProgram->ToString() << std::endl;
+    }
+
+    VirtualMachine machine(unit.myProgram.get());
+    machine.RunMain();
+    if (myConfiguration.GetGcStatistics()) {
+        PrintGcStatistics(machine.GetGcStatistics());
+    }
+}
+
+void Driver::PrintTree(const FlatTree& flatTree, std::ostream& out) const {
+    for (auto& str : flatTree.ToStrings(myConfiguration.GetSemanticsDebug())) {
+        out << str << std::endl;
+    }
+}
+
+void Driver::PrintGcStatistics(const GcStatistics& statistics) {
+    std::cerr << "GC collections: " << statistics.myCollections << std::endl
+              << "GC allocated objects: " << statistics.myAllocated << std::endl
+              << "GC freed objects: " << statistics.myFreed << std::endl
+              << "GC heap size: " << statistics.myHeapSize << " (peak " << statistics.myPeakHeapSize << ")" << std::endl
+              << "GC pause: " << statistics.myTotalPause << " ms total, " << statistics.myMaxPause << " ms max" << std::endl;
+}
+
+void Driver::PrintSummary(const std::vector<FileResult>& results) {
+    int passed = 0;
+    std::cout << std::endl << "=== Summary" << std::endl;
+    for (auto& result : results) {
+        PrintResult(result);
+        if (result.myStatus == FileStatus::Passed) {
+            passed++;
+        }
+    }
+
+    std::cout << passed << " of " << results.size() << " files passed" << std::endl;
+}
+
+void Driver::PrintResult(const FileResult& result) {
+    switch (result.myStatus) {
+    case FileStatus::Passed:
+        std::cout << "PASSED  ";
+        break;
+    case FileStatus::Failed:
+        std::cout << "FAILED  ";
+        break;
+    case FileStatus::Crashed:
+        std::cout << "CRASHED ";
+        break;
+    }
+
+    std::cout << result.myPath << " (" << std::fixed << std::setprecision(1) << result.myMilliseconds << " ms)";
+    std::cout.unsetf(std::ios_base::fixed);
+    if (!result.myMessage.empty()) {
+        std::cout << ": " << result.myMessage;
+    }
+    std::cout << std::endl;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Arena.h"
+#include "Configuration.h"
+#include "ProgramCache.h"
+#include "Interpreter/GarbageCollector.h"
+#include "Parser/DeclarationNodes.h"
+#include "Parser/Semantics/SymbolTable.h"
+#include "Parser/FlatTree.h"
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+enum class FileStatus {
+    Passed,
+    Failed,
+    Crashed
+};
+
+struct FileResult {
+    std::string myPath;
+    FileStatus myStatus = FileStatus::Passed;
+    std::string myMessage;
+    double myMilliseconds = 0;
+};
+
+// Front end output of a single file; owns the arena its tree and tables live in.
+// A unit loaded from the program cache has only the compiled program
+struct CompilationUnit {
+    Arena myArena;
+    Pointer<SymbolTable> myTable;
+    Pointer<DeclarationBlock> mySyntaxTree;
+    Pointer<Program> myProgram;
+    std::string myCacheKey;
+    std::string myDiagnostics;
+    int myErrorsCount = 0;
+    double myMilliseconds = 0;
+};
+
+class Driver {
+public:
+    explicit Driver(const Configuration& configuration);
+
+    // Checks and runs a single file, returns the process exit code: 0 on success, 1 on any error
+    int Run(const std::string& path, SymbolTable* prelude = nullptr) const;
+
+    // Checks files on the configured number of threads against one shared prelude,
+    // then runs them and prints their output and a summary in input order
+    int RunBatch(const std::vector<std::string>& paths) const;
+
+    // Lexes, parses and checks a file; debug output and errors are collected in the unit, not printed
+    Pointer<CompilationUnit> Check(const std::string& path, SymbolTable* prelude) const;
+    Pointer<CompilationUnit> CheckFile(const std::string& path, SymbolTable* prelude) const;
+    void Execute(CompilationUnit& unit) const;
+
+    // Prints the unit's diagnostics and runs it if requested; failures are reported in the result instead of thrown
+    FileResult Complete(const std::string& path, const std::function<Pointer<CompilationUnit>()>& checkUnit, bool isExecuting) const;
+
+    static void PrintResult(const FileResult& result);
+
+private:
+    void PrintTree(const FlatTree& flatTree, std::ostream& out) const;
+    static void PrintGcStatistics(const GcStatistics& statistics);
+    static void PrintSummary(const std::vector<FileResult>& results);
+
+    const Configuration& myConfiguration;
+    Pointer<ProgramCache> myCache;
+};
@@ -1,26 +1,38 @@
 #include "ConfigurationBuilder.h"
 #include "Configuration.h"
-#include "Lexer/Lexer.h"
+#include "Driver.h"
+#include "Server.h"
 
+#include <algorithm>
 #include <iostream>
-#include <fstream>
+#include <thread>
 #include <vector>
 #include <string>
 #include <boost/program_options/parsers.hpp>
 #include <boost/program_options/variables_map.hpp>
 
-#include "PrintVisitors.h"
-#include "Interpreter/Interpreter.h"
-
-#include "Parser/Parser.h"
-#include "Parser/ParserError.h"
-
 namespace prog_opt = boost::program_options;
 
 const char* FILES_KEY = "source-files";
 const char* LEXER_DEBUG_KEY = "lexer-debug";
 const char* PARSER_DEBUG_KEY = "parser-debug";
 const char* SEMANTICS_DEBUG_KEY = "semantics-debug";
+const char* TREE_WALKER_KEY = "tree-walker";
+const char* BYTECODE_DEBUG_KEY = "bytecode-debug";
+const char* FOLDING_DEBUG_KEY = "folding-debug";
+const char* GC_STATISTICS_KEY = "gc-stats";
+const char* CACHE_STATISTICS_KEY = "cache-stats";
+const char* BATCH_KEY = "batch";
+const char* MANIFEST_KEY = "manifest";
+const char* JOBS_KEY = "jobs";
+const char* SERVER_KEY = "server";
+const char* CACHE_DIRECTORY_KEY = "cache-dir";
+const char* EMIT_AST_KEY = "emit-ast";
+const char* EMIT_C_KEY = "emit-c";
+const char* JIT_KEY = "jit";
+const char* JIT_THRESHOLD_KEY = "jit-threshold";
+
+const int DEFAULT_JIT_THRESHOLD = 1000;
 
 Configuration ParseCommandLineArgs(int argc, char** argv) {
     prog_opt::options_description optionsDesc("Allowed options");
@@ -29,7 +41,22 @@ Configuration ParseCommandLineArgs(int argc, char** argv) {
         ("lexer-debug,l", "debug lexical analyser")
         ("source-files,f", prog_opt::value<std::vector<std::string>>(), "source files")
         ("parser-debug,p", "debug syntax analyser")
-        ("semantics-debug,s", "debug semantics");
+        ("semantics-debug,s", "debug semantics")
+        ("tree-walker,t", "interpret syntax tree directly instead of bytecode")
+        ("jit", "interpret syntax tree and compile hot numeric functions to native code")
+        ("jit-threshold", prog_opt::value<int>(), "number of calls after which '--jit' compiles a function")
+        ("bytecode-debug,b", "show compiled bytecode")
+        ("folding-debug", "show syntax tree after constant folding")
+        ("gc-stats", "show garbage collector statistics after the run")
+        ("batch", "check and run every source file in one process and print a summary")
+        ("manifest", prog_opt::value<std::string>(), "file with a list of source files for batch mode")
+        ("jobs,j", prog_opt::value<int>(), "number of threads checking files in batch mode (0 for one per core)")
+        ("server", prog_opt::value<std::string>()->implicit_value("kotlin-compiler.sock"),
+            "serve compile requests on a unix domain socket with a warm prelude")
+        ("cache-dir", prog_opt::value<std::string>(), "directory to keep compiled programs in, unchanged sources are run without checking")
+        ("cache-stats", "show whether each program was loaded from the cache or stored in it")
+        ("emit-ast", prog_opt::value<std::string>(), "write the checked syntax tree and symbols to a file instead of running")
+        ("emit-c", prog_opt::value<std::string>(), "write the program as a C11 source file instead of running");
 
     prog_opt::positional_options_description positionalOptions;
     positionalOptions.add(FILES_KEY, -1);
@@ -40,12 +67,28 @@ Configuration ParseCommandLineArgs(int argc, char** argv) {
 
     ConfigurationBuilder builder;
 
-    if (optionsMap.count(FILES_KEY) == 0) {
+    if (optionsMap.count(FILES_KEY)) {
+        builder.AddPaths(optionsMap[FILES_KEY].as<std::vector<std::string>>());
+    }
+    if (optionsMap.count(MANIFEST_KEY)) {
+        try {
+            builder.AddManifest(optionsMap[MANIFEST_KEY].as<std::string>());
+        } catch (const std::invalid_argument& e) {
+            std::cout << e.what() << std::endl;
+            return ConfigurationBuilder().Build();
+        }
+        builder.SetBatch();
+    }
+
+    if (optionsMap.count(SERVER_KEY)) {
+        builder.SetServerSocket(optionsMap[SERVER_KEY].as<std::string>());
+    }
+
+    if (builder.Build().GetPaths().empty() && builder.Build().GetServerSocket().empty()) {
         std::cout << "No files to compile" << std::endl;
-        return builder.Build();
+        return ConfigurationBuilder().Build();
     }
 
-    builder.AddPaths(optionsMap[FILES_KEY].as<std::vector<std::string>>());
     if (optionsMap.count(LEXER_DEBUG_KEY)) {
         builder.SetLexerDebug();
     }
@@ -55,72 +98,59 @@ Configuration ParseCommandLineArgs(int argc, char** argv) {
     if (optionsMap.count(SEMANTICS_DEBUG_KEY)) {
         builder.SetSemanticsDebug();
     }
+    if (optionsMap.count(TREE_WALKER_KEY)) {
+        builder.SetTreeWalker();
+    }
+    if (optionsMap.count(JIT_KEY)) {
+        int threshold = optionsMap.count(JIT_THRESHOLD_KEY) ? optionsMap[JIT_THRESHOLD_KEY].as<int>() : DEFAULT_JIT_THRESHOLD;
+        builder.SetJitThreshold(std::max(threshold, 1));
+    }
+    if (optionsMap.count(BYTECODE_DEBUG_KEY)) {
+        builder.SetBytecodeDebug();
+    }
+    if (optionsMap.count(FOLDING_DEBUG_KEY)) {
+        builder.SetFoldingDebug();
+    }
+
+    if (optionsMap.count(GC_STATISTICS_KEY)) {
+        builder.SetGcStatistics();
+    }
+    if (optionsMap.count(BATCH_KEY)) {
+        builder.SetBatch();
+    }
+    if (optionsMap.count(CACHE_DIRECTORY_KEY)) {
+        builder.SetCacheDirectory(optionsMap[CACHE_DIRECTORY_KEY].as<std::string>());
+    }
+    if (optionsMap.count(CACHE_STATISTICS_KEY)) {
+        builder.SetCacheStatistics();
+    }
+    if (optionsMap.count(EMIT_AST_KEY)) {
+        builder.SetAstOutput(optionsMap[EMIT_AST_KEY].as<std::string>());
+    }
+    if (optionsMap.count(EMIT_C_KEY)) {
+        builder.SetCOutput(optionsMap[EMIT_C_KEY].as<std::string>());
+    }
+    if (optionsMap.count(JOBS_KEY)) {
+        int jobs = optionsMap[JOBS_KEY].as<int>();
+        builder.SetJobs(jobs > 0 ? jobs : std::max<int>(std::thread::hardware_concurrency(), 1));
+    }
 
     return builder.Build();
 }
 
 int main(int argc, char** argv) {
     const Configuration configuration = ParseCommandLineArgs(argc, argv);
-    if (configuration.GetPaths().empty()) {
+    if (configuration.GetPaths().empty() && configuration.GetServerSocket().empty()) {
         return 0;
     }
 
-    std::ifstream ifs(configuration.GetPaths()[0]);
-
-    if (configuration.GetLexerDebug()) {
-        Lexer lexer(configuration.GetPaths()[0]);
-        lexer.NextLexeme();
-
-        while (lexer.GetLexeme().GetType() != Lexeme::LexemeType::EndOfFile) {
-            std::cout << lexer.NextLexeme() << std::endl;
-        }
-    }
-
-    Lexer lexer(configuration.GetPaths()[0]);
-    SymbolTable symTable;
-    Parser parser(lexer, &symTable);
-    Pointer<DeclarationBlock> syntaxTree = parser.Parse();
-
-    if (configuration.GetParserDebug()) {
-        std::cout << std::endl;
-        CuteToStringVisitor visitor;
-
-        if (configuration.GetSemanticsDebug()) {
-            visitor.ShowSemanticsAnnotations();
-        }
-
-        syntaxTree->RunVisitor(visitor);
-
-        for (auto& str : visitor.GetStringData()) {
-            std::cout << str << std::endl;
-        }
+    Driver driver(configuration);
+    if (!configuration.GetServerSocket().empty()) {
+        return CompileServer(driver, configuration.GetServerSocket()).Serve();
     }
-
-    if (configuration.GetSemanticsDebug()) {
-        std::cout << std::endl;
-        CuteToStringVisitor visitor;
-        symTable.RunVisitor(visitor);
-        for (auto& str : visitor.GetStringData()) {
-            std::cout << str << std::endl;
-        }
-
-        std::cout << std::endl;
-    }
-
-    for (auto& error : parser.GetParsingErrors()) {
-        std::cout << error << std::endl;
-    }
-
-    for (auto& error : parser.GetSemanticsErrors()) {
-        std::cout << error << std::endl;
-    }
-    
-
-    if (!parser.GetParsingErrors().empty() || !parser.GetSemanticsErrors().empty()) {
-        return 0;
+    if (configuration.GetBatch() || configuration.GetPaths().size() > 1) {
+        return driver.RunBatch(configuration.GetPaths());
     }
 
-    Interpreter interpreter(syntaxTree.get(), &symTable);
-    interpreter.RunMain();
-    return 0;
+    return driver.Run(configuration.GetPaths()[0]);
 }
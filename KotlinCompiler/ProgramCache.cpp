@@ -0,0 +1,101 @@
+#include "ProgramCache.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    const char ENTRY_MAGIC[] = "KCBC";
+
+    uint64_t HashFnv1a(const std::string& data, uint64_t hash = 14695981039346656037ull) {
+        for (unsigned char ch : data) {
+            hash = (hash ^ ch) * 1099511628211ull;
+        }
+        return hash;
+    }
+}
+
+ProgramCache::ProgramCache(const std::string& directory) : myDirectory(directory) {
+    std::error_code error;
+    std::filesystem::create_directories(myDirectory, error);
+}
+
+std::string ProgramCache::GetKey(const std::string& source) {
+    std::ostringstream key;
+    key << std::hex << std::setfill('0') << std::setw(16) << HashFnv1a(source, HashFnv1a(std::to_string(BYTECODE_VERSION)))
+        << "-" << source.size();
+    return key.str();
+}
+
+Pointer<Program> ProgramCache::Load(const std::string& key) const {
+    std::ifstream input(GetEntryPath(key), std::ios::binary);
+    if (!input) {
+        return nullptr;
+    }
+
+    char magic[sizeof(ENTRY_MAGIC)] = {};
+    int32_t version = 0;
+    uint64_t checksum = 0;
+    input.read(magic, sizeof(magic) - 1);
+    input.read(reinterpret_cast<char*>(&version), sizeof(version));
+    input.read(reinterpret_cast<char*>(&checksum), sizeof(checksum));
+    if (!input || std::string(magic) != ENTRY_MAGIC || version != BYTECODE_VERSION) {
+        return nullptr;
+    }
+
+    // Program::Read rejects operands out of range, the checksum catches damage that still looks well-formed
+    std::string payload((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (HashFnv1a(payload) != checksum) {
+        return nullptr;
+    }
+
+    std::istringstream payloadInput(payload);
+    try {
+        return Program::Read(payloadInput);
+    } catch (const std::invalid_argument&) {
+        return nullptr;
+    }
+}
+
+void ProgramCache::Store(const std::string& key, const Program& program) const {
+    // Concurrent runs may store the same entry, so each writes its own file and renames it into place
+    std::string path = GetEntryPath(key);
+    std::string tempPath = path + ".tmp" + std::to_string(std::random_device()());
+    std::error_code error;
+
+    {
+        std::ofstream output(tempPath, std::ios::binary);
+        if (!output) {
+            return;
+        }
+
+        std::ostringstream payload;
+        program.Write(payload);
+
+        int32_t version = BYTECODE_VERSION;
+        uint64_t checksum = HashFnv1a(payload.str());
+        output.write(ENTRY_MAGIC, sizeof(ENTRY_MAGIC) - 1);
+        output.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        output.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+        output << payload.str();
+        if (!output) {
+            output.close();
+            std::filesystem::remove(tempPath, error);
+            return;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+    }
+}
+
+std::string ProgramCache::GetEntryPath(const std::string& key) const {
+    return (std::filesystem::path(myDirectory) / (key + ".kcbc")).string();
+}
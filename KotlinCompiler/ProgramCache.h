@@ -0,0 +1,22 @@
+#pragma once
+
+#include "VirtualMachine/Bytecode.h"
+
+#include <string>
+
+// Compiled programs on disk, addressed by the hash of their source and the bytecode version
+class ProgramCache {
+public:
+    explicit ProgramCache(const std::string& directory);
+
+    static std::string GetKey(const std::string& source);
+
+    // Returns nullptr if there is no entry or it can't be read
+    Pointer<Program> Load(const std::string& key) const;
+    void Store(const std::string& key, const Program& program) const;
+
+private:
+    std::string GetEntryPath(const std::string& key) const;
+
+    std::string myDirectory;
+};
@@ -0,0 +1,289 @@
+#include "Server.h"
+
+#include "Lexer/StringInterner.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <streambuf>
+#include <thread>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+using SocketHandle = SOCKET;
+#else
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+using SocketHandle = int;
+const SocketHandle INVALID_SOCKET = -1;
+#endif
+
+namespace {
+#ifdef MSG_NOSIGNAL
+    const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    const int SEND_FLAGS = 0;
+#endif
+
+    // A client that does not finish its request line in this time is dropped
+    const int RECEIVE_TIMEOUT_SECONDS = 10;
+    const int MAX_ACCEPT_BACKOFF_MS = 5000;
+
+    void CloseSocket(SocketHandle socket) {
+#ifdef _WIN32
+        closesocket(socket);
+#else
+        close(socket);
+#endif
+    }
+
+    // Sends everything written to it to the client, a disconnected client just drops the output
+    class SocketStreamBuf : public std::streambuf {
+    public:
+        explicit SocketStreamBuf(SocketHandle socket) : mySocket(socket) {
+            setp(myBuffer, myBuffer + BUFFER_SIZE);
+        }
+
+        ~SocketStreamBuf() override {
+            sync();
+        }
+
+    protected:
+        int overflow(int ch) override {
+            Flush();
+            if (ch != traits_type::eof()) {
+                *pptr() = static_cast<char>(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override {
+            Flush();
+            return 0;
+        }
+
+    private:
+        void Flush() {
+            const char* data = pbase();
+            int size = static_cast<int>(pptr() - pbase());
+            while (isConnected && size > 0) {
+                int sent = static_cast<int>(send(mySocket, data, size, SEND_FLAGS));
+                if (sent <= 0) {
+                    isConnected = false;
+                    break;
+                }
+                data += sent;
+                size -= sent;
+            }
+            setp(myBuffer, myBuffer + BUFFER_SIZE);
+        }
+
+        static const int BUFFER_SIZE = 4096;
+
+        SocketHandle mySocket;
+        char myBuffer[BUFFER_SIZE];
+        bool isConnected = true;
+    };
+
+    bool ReadLine(SocketHandle socket, std::string& line) {
+        char ch;
+        while (true) {
+            int received = static_cast<int>(recv(socket, &ch, 1, 0));
+            if (received < 0) {
+                // A timed out or failed read leaves a partial request that is not worth running
+                return false;
+            }
+            if (received == 0) {
+                return !line.empty();
+            }
+            if (ch == '\n') {
+                return true;
+            }
+            if (ch != '\r') {
+                line.push_back(ch);
+            }
+        }
+    }
+
+    void SetReceiveTimeout(SocketHandle socket, int seconds) {
+#ifdef _WIN32
+        DWORD timeout = seconds * 1000;
+#else
+        timeval timeout = {};
+        timeout.tv_sec = seconds;
+#endif
+        setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+    }
+
+    bool IsSocketFile(const std::string& path) {
+#ifdef _WIN32
+        DWORD attributes = GetFileAttributesA(path.c_str());
+        return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+#else
+        struct stat info;
+        return lstat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode);
+#endif
+    }
+
+    bool PathExists(const std::string& path) {
+#ifdef _WIN32
+        return GetFileAttributesA(path.c_str()) != INVALID_FILE_ATTRIBUTES;
+#else
+        struct stat info;
+        return lstat(path.c_str(), &info) == 0;
+#endif
+    }
+
+    bool IsServerAlive(const sockaddr_un& address) {
+        SocketHandle probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (probe == INVALID_SOCKET) {
+            return false;
+        }
+        bool isAlive = connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+        CloseSocket(probe);
+        return isAlive;
+    }
+
+    // Only a socket file left by a previous server that was killed is removed, anything else at the path is kept
+    bool RemoveStaleSocket(const std::string& path, const sockaddr_un& address) {
+        if (!PathExists(path)) {
+            return true;
+        }
+        if (!IsSocketFile(path) || IsServerAlive(address)) {
+            return false;
+        }
+        return std::remove(path.c_str()) == 0;
+    }
+
+    int LastSocketError() {
+#ifdef _WIN32
+        return WSAGetLastError();
+#else
+        return errno;
+#endif
+    }
+
+    class StreamRedirect {
+    public:
+        StreamRedirect(std::ostream& stream, std::streambuf* buffer) : myStream(stream), myOldBuffer(stream.rdbuf(buffer)) {}
+
+        ~StreamRedirect() {
+            myStream.flush();
+            myStream.rdbuf(myOldBuffer);
+        }
+
+    private:
+        std::ostream& myStream;
+        std::streambuf* myOldBuffer;
+    };
+}
+
+CompileServer::CompileServer(const Driver& driver, const std::string& socketPath) : myDriver(driver), mySocketPath(socketPath) {
+    myPrelude.Freeze();
+}
+
+int CompileServer::Serve() {
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        std::cout << "Cannot initialize sockets" << std::endl;
+        return 1;
+    }
+#endif
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (mySocketPath.size() >= sizeof(address.sun_path)) {
+        std::cout << "Socket path is too long: " << mySocketPath << std::endl;
+        return 1;
+    }
+    mySocketPath.copy(address.sun_path, mySocketPath.size());
+
+    if (!RemoveStaleSocket(mySocketPath, address)) {
+        std::cout << "Cannot listen on " << mySocketPath << std::endl;
+        return 1;
+    }
+
+    SocketHandle listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == INVALID_SOCKET) {
+        std::cout << "Cannot create socket" << std::endl;
+        return 1;
+    }
+
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+        std::cout << "Cannot listen on " << mySocketPath << std::endl;
+        CloseSocket(listener);
+        return 1;
+    }
+
+    std::cout << "Listening on " << mySocketPath << std::endl;
+
+    bool isRunning = true;
+    int acceptBackoffMs = 0;
+    while (isRunning) {
+        SocketHandle client = accept(listener, nullptr, nullptr);
+        if (client == INVALID_SOCKET) {
+            int error = LastSocketError();
+#ifndef _WIN32
+            if (error == EINTR) {
+                continue;
+            }
+#endif
+            // Errors like running out of descriptors persist, so wait instead of spinning on them
+            acceptBackoffMs = std::min(std::max(acceptBackoffMs * 2, 10), MAX_ACCEPT_BACKOFF_MS);
+            std::cout << "Cannot accept a connection (error " << error << "), retrying in " << acceptBackoffMs << " ms" << std::endl;
+            std::this_thread::sleep_for(std::chrono::milliseconds(acceptBackoffMs));
+            continue;
+        }
+        acceptBackoffMs = 0;
+
+        SetReceiveTimeout(client, RECEIVE_TIMEOUT_SECONDS);
+
+        std::string request;
+        if (ReadLine(client, request)) {
+            SocketStreamBuf output(client);
+            StreamRedirect redirectOut(std::cout, &output);
+            StreamRedirect redirectErr(std::cerr, &output);
+            isRunning = HandleRequest(request);
+        }
+        CloseSocket(client);
+    }
+
+    CloseSocket(listener);
+    std::remove(mySocketPath.c_str());
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return 0;
+}
+
+bool CompileServer::HandleRequest(const std::string& request) {
+    size_t separator = request.find(' ');
+    std::string command = request.substr(0, separator);
+    std::string path = separator == std::string::npos ? "" : request.substr(separator + 1);
+
+    if (command == "shutdown") {
+        std::cout << "=== Shutting down" << std::endl;
+        return false;
+    }
+
+    if ((command != "run" && command != "check") || path.empty()) {
+        std::cout << "=== Unknown request: " << request << std::endl;
+        return true;
+    }
+
+    // Names and literals of the request are not needed once it is answered
+    StringInterner::Scope internerScope;
+    FileResult result = myDriver.Complete(path, [&]() { return myDriver.CheckFile(path, &myPrelude); }, command == "run");
+    std::cout << "=== ";
+    Driver::PrintResult(result);
+    return true;
+}
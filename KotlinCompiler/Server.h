@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Driver.h"
+#include "Parser/Semantics/SymbolTable.h"
+
+#include <string>
+
+// Keeps the prelude checked and frozen between requests and serves them one at a time over a unix domain socket.
+// A request is a single line: "run <path>", "check <path>" or "shutdown". Program output is streamed back,
+// followed by a status line in the batch summary format, then the connection is closed.
+class CompileServer {
+public:
+    CompileServer(const Driver& driver, const std::string& socketPath);
+
+    int Serve();
+
+private:
+    // Returns false when the server should stop
+    bool HandleRequest(const std::string& request);
+
+    const Driver& myDriver;
+    std::string mySocketPath;
+    SymbolTable myPrelude;
+};
@@ -1,5 +1,6 @@
 #include "CompilerTest.h"
 
+#include "Arena.h"
 #include "PrintVisitors.h"
 #include "Parser/Parser.h"
 #include "Parser/ParserError.h"
@@ -26,6 +27,8 @@ std::string ParserTest::CreateTestPath(const std::string& path) {
 }
 
 ParserTest::ParserTest(const std::string& filepath) : IOTest(ParserDirectory + filepath) {
+    Arena arena;
+    ArenaScope arenaScope(arena);
     Lexer lexer(GetFilepath());
     SymbolTable table;
     Parser parser(lexer, &table);
@@ -53,6 +56,8 @@ std::string ParserSemanticTest::CreateTestPath(const std::string& path) {
 }
 
 ParserSemanticTest::ParserSemanticTest(const std::string& filepath) : IOTest(SemanticsDirectory + filepath) {
+    Arena arena;
+    ArenaScope arenaScope(arena);
     Lexer lexer(GetFilepath());
     SymbolTable table;
     Parser parser(lexer, &table);
@@ -0,0 +1,272 @@
+#include "catch.hpp"
+#include "InterpreterTest.h"
+#include "VirtualMachine/Bytecode.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+using SocketHandle = SOCKET;
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+using SocketHandle = int;
+const SocketHandle INVALID_SOCKET = -1;
+#endif
+
+namespace {
+    const std::string ServerSocket = "test-server.sock";
+
+    void CloseSocket(SocketHandle socket) {
+#ifdef _WIN32
+        closesocket(socket);
+#else
+        close(socket);
+#endif
+    }
+
+    // Sends one request line and returns everything the server answers, or nothing when it doesn't accept
+    std::string SendRequest(const std::string& request) {
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        ServerSocket.copy(address.sun_path, ServerSocket.size());
+
+        SocketHandle client = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (client == INVALID_SOCKET) {
+            return "";
+        }
+        if (connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            CloseSocket(client);
+            return "";
+        }
+
+        std::string line = request + "\n";
+        send(client, line.data(), static_cast<int>(line.size()), 0);
+
+        std::string response;
+        char buffer[4096];
+        int received;
+        while ((received = static_cast<int>(recv(client, buffer, sizeof(buffer), 0))) > 0) {
+            response.append(buffer, received);
+        }
+        CloseSocket(client);
+        return response;
+    }
+
+    const std::string BatchDirectory = InterpreterTestDirectory + "Batch/";
+
+    std::string BatchFiles() {
+        std::string res;
+        for (const char* file : { "Greeting.kt", "TypeErrors.kt", "Squares.kt", "IndexOutOfBounds.kt" }) {
+            res += " \"" + BatchDirectory + file + "\"";
+        }
+        return res;
+    }
+
+    // Runs with --cache-stats, returns "hit" or "store" from the cache report and the program output without it
+    std::string RunCached(const std::string& arguments, std::string& output) {
+        std::string res = InterpreterTest::RunInterpreter("--cache-stats " + arguments + " 2>&1");
+        std::regex report("Cache (hit|store): [0-9a-f]+-[0-9]+\r?\n");
+        std::smatch match;
+        std::string status = std::regex_search(res, match, report) ? match[1].str() : "";
+        output = std::regex_replace(res, report, "");
+        return status;
+    }
+}
+
+TEST_CASE("Batch mode", "[Interpreter][Batch]") {
+    int status = 0;
+    std::string res = InterpreterTest::RunInterpreter("--batch" + BatchFiles(), &status);
+
+    CHECK(InterpreterTest::NormalizeBatchOutput(res) == InterpreterTest::ReadFile(BatchDirectory + "Batch.gold"));
+    CHECK(status != 0);
+}
+
+TEST_CASE("Batch mode with a manifest", "[Interpreter][Batch]") {
+    int status = 0;
+    std::string res = InterpreterTest::RunInterpreter("--manifest \"" + BatchDirectory + "Manifest.txt\"", &status);
+
+    CHECK(InterpreterTest::NormalizeBatchOutput(res) == InterpreterTest::ReadFile(BatchDirectory + "Batch.gold"));
+    CHECK(status != 0);
+}
+
+TEST_CASE("Batch mode keeps the order with several jobs", "[Interpreter][Batch]") {
+    std::string sequential = InterpreterTest::RunInterpreter("-j 1 --manifest \"" + BatchDirectory + "Manifest.txt\"");
+    std::string parallel = InterpreterTest::RunInterpreter("-j 4 --manifest \"" + BatchDirectory + "Manifest.txt\"");
+
+    CHECK(InterpreterTest::NormalizeBatchOutput(sequential) == InterpreterTest::ReadFile(BatchDirectory + "Batch.gold"));
+    CHECK(InterpreterTest::NormalizeBatchOutput(parallel) == InterpreterTest::NormalizeBatchOutput(sequential));
+}
+
+TEST_CASE("Batch mode succeeds when every file passes", "[Interpreter][Batch]") {
+    int status = -1;
+    std::string res = InterpreterTest::RunInterpreter("-j 4 --batch \"" + BatchDirectory + "Greeting.kt\" \"" + BatchDirectory + "Squares.kt\"", &status);
+
+    CHECK(res.find("2 of 2 files passed") != std::string::npos);
+    CHECK(status == 0);
+}
+
+TEST_CASE("Single file exit codes", "[Interpreter][Batch]") {
+    int status = -1;
+    InterpreterTest::RunInterpreter("\"" + BatchDirectory + "Greeting.kt\"", &status);
+    CHECK(status == 0);
+
+    for (const char* file : { "TypeErrors.kt", "IndexOutOfBounds.kt", "Missing.kt" }) {
+        status = 0;
+        InterpreterTest::RunInterpreter("\"" + BatchDirectory + file + "\"", &status);
+        CHECK(status != 0);
+    }
+}
+
+TEST_CASE("Compile server", "[Interpreter][Server]") {
+#ifdef _WIN32
+    WSADATA wsaData;
+    REQUIRE(WSAStartup(MAKEWORD(2, 2), &wsaData) == 0);
+#endif
+
+    std::string serverOutput;
+    std::thread server([&]() { serverOutput = InterpreterTest::RunInterpreter("--server " + ServerSocket); });
+
+    const std::string path = BatchDirectory + "Greeting.kt";
+    std::string run;
+    for (int attempt = 0; attempt < 100 && run.empty(); attempt++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        run = SendRequest("run " + path);
+    }
+    std::string check = SendRequest("check " + path);
+    std::string errors = SendRequest("check " + BatchDirectory + "TypeErrors.kt");
+    std::string shutdown = SendRequest("shutdown");
+    server.join();
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+
+    CHECK(serverOutput == "Listening on " + ServerSocket + "\n");
+    CHECK(InterpreterTest::NormalizeBatchOutput(run) == "Hello, batch!\n=== PASSED  " + path + "\n");
+    CHECK(InterpreterTest::NormalizeBatchOutput(check) == "=== PASSED  " + path + "\n");
+    CHECK(errors.find("=== FAILED  " + BatchDirectory + "TypeErrors.kt") != std::string::npos);
+    CHECK(shutdown == "=== Shutting down\n");
+}
+
+TEST_CASE("Program cache", "[Interpreter][Cache]") {
+    const std::string cacheDirectory = "test-cache";
+    const std::string path = BatchDirectory + "Greeting.kt";
+    const std::string arguments = "--cache-dir " + cacheDirectory + " \"" + path + "\"";
+    std::filesystem::remove_all(cacheDirectory);
+
+    std::string expected = InterpreterTest::RunInterpreter("\"" + path + "\"");
+    REQUIRE(expected == "Hello, batch!\n");
+
+    std::string output;
+    auto entries = [&cacheDirectory]() {
+        return std::distance(std::filesystem::directory_iterator(cacheDirectory), std::filesystem::directory_iterator());
+    };
+
+    SECTION("Same file twice") {
+        CHECK(RunCached(arguments, output) == "store");
+        CHECK(output == expected);
+        CHECK(entries() == 1);
+        CHECK(RunCached(arguments, output) == "hit");
+        CHECK(output == expected);
+        CHECK(entries() == 1);
+    }
+
+    SECTION("Corrupted entry") {
+        CHECK(RunCached(arguments, output) == "store");
+        for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory)) {
+            std::fstream file(entry.path(), std::ios::binary | std::ios::in | std::ios::out);
+            for (std::streamoff offset = 16; offset < static_cast<std::streamoff>(entry.file_size()); offset += 7) {
+                file.seekp(offset);
+                file.put('\x7f');
+            }
+        }
+
+        // The damaged entry is rejected and replaced, so the run after it loads the program again
+        CHECK(RunCached(arguments, output) == "store");
+        CHECK(output == expected);
+        CHECK(RunCached(arguments, output) == "hit");
+        CHECK(output == expected);
+    }
+
+    SECTION("Truncated entry") {
+        CHECK(RunCached(arguments, output) == "store");
+        uintmax_t size = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory)) {
+            size = entry.file_size();
+            std::filesystem::resize_file(entry.path(), size / 2);
+        }
+
+        CHECK(RunCached(arguments, output) == "store");
+        CHECK(output == expected);
+        for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory)) {
+            CHECK(entry.file_size() == size);
+        }
+        CHECK(RunCached(arguments, output) == "hit");
+    }
+
+    std::filesystem::remove_all(cacheDirectory);
+}
+
+TEST_CASE("Program reader rejects operands out of range", "[Bytecode]") {
+    Program program;
+    int constant = program.AddConstant(Value(42));
+    int main = program.AddFunction("main", 0);
+    program.GetFunction(main).myFrameSize = 1;
+    program.GetFunction(main).myCode = {
+        { OpCode::PushConst, constant, 0 },
+        { OpCode::StoreLocal, 0, 0 },
+        { OpCode::PushUnit, 0, 0 },
+        { OpCode::Return, 0, 0 },
+    };
+    program.SetEntry(main);
+    program.SetMain(main);
+
+    auto roundTrip = [&program]() {
+        std::stringstream stream;
+        program.Write(stream);
+        return Program::Read(stream);
+    };
+    REQUIRE(roundTrip()->GetFunction(main).myCode.size() == 4);
+
+    SECTION("Jump target") {
+        program.GetFunction(main).myCode[2] = { OpCode::Jump, 4, 0 };
+        CHECK_THROWS_AS(roundTrip(), std::invalid_argument);
+    }
+    SECTION("Constant") {
+        program.GetFunction(main).myCode[0].myFirst = 1;
+        CHECK_THROWS_AS(roundTrip(), std::invalid_argument);
+    }
+    SECTION("Local slot") {
+        program.GetFunction(main).myCode[1].myFirst = 1;
+        CHECK_THROWS_AS(roundTrip(), std::invalid_argument);
+    }
+    SECTION("Function") {
+        program.GetFunction(main).myCode[2] = { OpCode::Call, 1, 0 };
+        CHECK_THROWS_AS(roundTrip(), std::invalid_argument);
+    }
+    SECTION("Class") {
+        program.GetFunction(main).myCode[2] = { OpCode::New, 0, 0 };
+        CHECK_THROWS_AS(roundTrip(), std::invalid_argument);
+    }
+    SECTION("Constructor") {
+        program.GetClass(program.AddClass("A")).myConstructor = 1;
+        CHECK_THROWS_AS(roundTrip(), std::invalid_argument);
+    }
+    SECTION("Main") {
+        program.SetMain(1);
+        CHECK_THROWS_AS(roundTrip(), std::invalid_argument);
+    }
+    SECTION("Missing return") {
+        program.GetFunction(main).myCode.pop_back();
+        CHECK_THROWS_AS(roundTrip(), std::invalid_argument);
+    }
+}
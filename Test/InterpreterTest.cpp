@@ -1,38 +1,140 @@
 #include "InterpreterTest.h"
 
+#include <algorithm>
 #include <array>
 
 #include <thread>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <regex>
 
 #include "catch.hpp"
 
 
-void InterpreterTest::RunTests(const std::string& directory) {
+void InterpreterTest::RunTests(const std::string& directory, const std::string& options) {
     for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(InterpreterTestDirectory + directory)) {
         if (dirEntry.is_regular_file() && (!dirEntry.path().has_extension() || dirEntry.path().extension() == ".kt")) {
             SECTION(directory + dirEntry.path().filename().generic_string())
-            Run(InterpreterTestDirectory + directory + dirEntry.path().filename().generic_string());
+            Run(InterpreterTestDirectory + directory + dirEntry.path().filename().generic_string(), options);
         }
     }
 }
 
-void InterpreterTest::Run(const std::string& fileName) {
+void InterpreterTest::Run(const std::string& fileName, const std::string& options) {
     std::string fullpath = fileName;
-    std::string outputExe = fullpath + ".exe";
+    std::string goldRes = RunGold(fullpath);
+    std::string res = RunFromShell(std::filesystem::absolute(InterpreterPath).generic_string() + " " + options + " " + WrapString(fullpath));
 
-    if (!std::filesystem::is_regular_file(outputExe)) {
-        std::string output = RunFromShell("kotlinc -o " + WrapString(outputExe) + " " + WrapString(fullpath));
+    REQUIRE(!goldRes.empty());
+    CHECK(goldRes == res);
+}
+
+void InterpreterTest::RunCTests(const std::string& directory) {
+    for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(InterpreterTestDirectory + directory)) {
+        if (dirEntry.is_regular_file() && dirEntry.path().extension() == ".kt") {
+            SECTION(directory + dirEntry.path().filename().generic_string())
+            RunC(InterpreterTestDirectory + directory + dirEntry.path().filename().generic_string());
+        }
+    }
+}
+
+void InterpreterTest::RunC(const std::string& fileName) {
+    std::string goldRes = RunGold(fileName);
+    std::string res = RunEmittedC(fileName);
+
+    REQUIRE(!goldRes.empty());
+    CHECK(goldRes == res);
+}
+
+void InterpreterTest::RunExpectedCTests(const std::string& directory) {
+    for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(InterpreterTestDirectory + directory)) {
+        if (dirEntry.is_regular_file() && dirEntry.path().extension() == ".kt") {
+            SECTION(directory + dirEntry.path().filename().generic_string())
+            RunExpectedC(InterpreterTestDirectory + directory + dirEntry.path().filename().generic_string());
+        }
+    }
+}
+
+void InterpreterTest::RunExpectedC(const std::string& fileName) {
+    std::string goldRes = ReadFile(fileName + ".gold");
+    std::string res = RunEmittedC(fileName);
+
+    REQUIRE(!goldRes.empty());
+    CHECK(goldRes == res);
+}
+
+void InterpreterTest::RunAstTests(const std::string& directory, const std::string& options) {
+    for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(InterpreterTestDirectory + directory)) {
+        if (dirEntry.is_regular_file() && dirEntry.path().extension() == ".kt") {
+            SECTION(directory + dirEntry.path().filename().generic_string())
+            RunAst(InterpreterTestDirectory + directory + dirEntry.path().filename().generic_string(), options);
+        }
     }
+}
 
-    std::string goldRes = RunFromShell(std::filesystem::absolute(outputExe).generic_string());
-    std::string res = RunFromShell(std::filesystem::absolute(InterpreterPath).generic_string() + " " + WrapString(fullpath));
+void InterpreterTest::RunAst(const std::string& fileName, const std::string& options) {
+    std::string goldRes = RunGold(fileName);
+    std::string tree = fileName + ".kast";
+
+    RunFromShell(std::filesystem::absolute(InterpreterPath).generic_string() + " --emit-ast " + WrapString(tree) + " " + WrapString(fileName));
+    std::string res = RunFromShell(std::filesystem::absolute(InterpreterPath).generic_string() + " " + options + " " + WrapString(tree));
 
     REQUIRE(!goldRes.empty());
     CHECK(goldRes == res);
 }
 
-std::string InterpreterTest::RunFromShell(const std::string& command) {
+void InterpreterTest::RunExpectedTests(const std::string& directory, const std::string& options) {
+    for (const auto& dirEntry : std::filesystem::recursive_directory_iterator(InterpreterTestDirectory + directory)) {
+        if (dirEntry.is_regular_file() && dirEntry.path().extension() == ".kt") {
+            SECTION(directory + dirEntry.path().filename().generic_string())
+            RunExpected(InterpreterTestDirectory + directory + dirEntry.path().filename().generic_string(), options);
+        }
+    }
+}
+
+void InterpreterTest::RunExpected(const std::string& fileName, const std::string& options) {
+    std::string goldRes = ReadFile(fileName + ".gold");
+    std::string res = RunInterpreter(options + " " + WrapString(fileName));
+
+    REQUIRE(!goldRes.empty());
+    CHECK(goldRes == res);
+}
+
+std::string InterpreterTest::RunInterpreter(const std::string& arguments, int* status) {
+    return RunFromShell(std::filesystem::absolute(InterpreterPath).generic_string() + " " + arguments, status);
+}
+
+std::string InterpreterTest::ReadFile(const std::string& fileName) {
+    std::ifstream input(fileName, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+}
+
+std::string InterpreterTest::NormalizeBatchOutput(const std::string& output) {
+    std::string res = std::regex_replace(output, std::regex(" \\([0-9.]+ ms\\)"), "");
+    std::replace(res.begin(), res.end(), '\\', '/');
+    return res;
+}
+
+std::string InterpreterTest::RunGold(const std::string& fileName) {
+    std::string outputExe = fileName + ".exe";
+    if (!std::filesystem::is_regular_file(outputExe)) {
+        RunFromShell("kotlinc -o " + WrapString(outputExe) + " " + WrapString(fileName));
+    }
+
+    return RunFromShell(std::filesystem::absolute(outputExe).generic_string());
+}
+
+std::string InterpreterTest::RunEmittedC(const std::string& fileName) {
+    std::string source = fileName + ".c";
+    std::string program = fileName + ".c.exe";
+
+    RunFromShell(std::filesystem::absolute(InterpreterPath).generic_string() + " --emit-c " + WrapString(source) + " " + WrapString(fileName));
+    RunFromShell(CCompilerCommand + " -o " + WrapString(program) + " " + WrapString(source) + " -lm");
+    return RunFromShell(std::filesystem::absolute(program).generic_string());
+}
+
+std::string InterpreterTest::RunFromShell(const std::string& command, int* status) {
     std::array<char, 4096> buffer{};
     std::string output;
     auto handle = _popen(command.c_str(), "r");
@@ -44,7 +146,10 @@ std::string InterpreterTest::RunFromShell(const std::string& command) {
         output += std::string(buffer.data(), bytesRead);
     }
 
-    _pclose(handle);
+    int code = _pclose(handle);
+    if (status != nullptr) {
+        *status = code;
+    }
     return output;
 }
 
@@ -1,15 +1,42 @@
 #pragma once
 #include <string>
+#include <vector>
 
 const static std::string InterpreterTestDirectory = "TestSamples/InterpreterTests/";
 const static std::string InterpreterPath = "../Release/KotlinCompiler.exe";
+const static std::string CCompilerCommand = "cc -std=c11 -O2 -Wall -Werror";
+// Sample groups every backend has to run with the same output
+const static std::vector<std::string> SampleDirectories = {
+    "BasicSyntax/", "Variables/", "IfExpr/", "Loops/", "Jumps/", "Functions/", "Classes/", "Casts/", "Complex/"
+};
 
 class InterpreterTest {
 public:
-    static void RunTests(const std::string& directory);
-    static void Run(const std::string& fileName);
+    static void RunTests(const std::string& directory, const std::string& options = "");
+    static void Run(const std::string& fileName, const std::string& options = "");
+
+    static void RunCTests(const std::string& directory);
+    static void RunC(const std::string& fileName);
+    // Same as RunExpected for the program written with --emit-c
+    static void RunExpectedCTests(const std::string& directory);
+    static void RunExpectedC(const std::string& fileName);
+
+    // Writes the checked syntax tree with --emit-ast and runs the written file
+    static void RunAstTests(const std::string& directory, const std::string& options = "");
+    static void RunAst(const std::string& fileName, const std::string& options = "");
+
+    // Compares the output with the expected one stored next to the sample in <file>.gold
+    static void RunExpectedTests(const std::string& directory, const std::string& options = "");
+    static void RunExpected(const std::string& fileName, const std::string& options = "");
+
+    static std::string RunInterpreter(const std::string& arguments, int* status = nullptr);
+    static std::string ReadFile(const std::string& fileName);
+    // Drops the timings from a batch summary and uses forward slashes in paths
+    static std::string NormalizeBatchOutput(const std::string& output);
 
 private:
-    static std::string RunFromShell(const std::string& command);
+    static std::string RunGold(const std::string& fileName);
+    static std::string RunEmittedC(const std::string& fileName);
+    static std::string RunFromShell(const std::string& command, int* status = nullptr);
     static std::string WrapString(const std::string& src);
 };
\ No newline at end of file
@@ -35,4 +35,51 @@ TEST_CASE("Interpreter Casts", "[Interpreter]") {
 
 TEST_CASE("Interpreter Complex tests", "[Interpreter]") {
     InterpreterTest::RunTests("Complex/");
-}
\ No newline at end of file
+}
+
+TEST_CASE("Tree walker conformance", "[Interpreter][TreeWalker]") {
+    for (const std::string& directory : SampleDirectories) {
+        InterpreterTest::RunTests(directory, "-t");
+    }
+}
+
+TEST_CASE("Interpreter runtime errors", "[Interpreter][RuntimeErrors]") {
+    InterpreterTest::RunExpectedTests("RuntimeErrors/");
+}
+
+TEST_CASE("Tree walker runtime errors", "[Interpreter][RuntimeErrors]") {
+    InterpreterTest::RunExpectedTests("RuntimeErrors/", "-t");
+}
+
+TEST_CASE("Constant folding dump", "[Interpreter][Folding]") {
+    InterpreterTest::RunExpectedTests("Folding/", "--folding-debug");
+}
+
+TEST_CASE("JIT conformance", "[Interpreter][Jit]") {
+    for (const std::string& directory : SampleDirectories) {
+        InterpreterTest::RunTests(directory, "--jit --jit-threshold 1");
+    }
+}
+
+TEST_CASE("JIT runtime errors", "[Interpreter][Jit][RuntimeErrors]") {
+    InterpreterTest::RunExpectedTests("RuntimeErrors/", "--jit --jit-threshold 1");
+}
+
+TEST_CASE("Syntax tree round trip", "[Interpreter][Ast]") {
+    for (const std::string& directory : SampleDirectories) {
+        InterpreterTest::RunAstTests(directory);
+    }
+}
+
+TEST_CASE("Syntax tree round trip on the tree walker", "[Interpreter][Ast]") {
+    for (const std::string& directory : SampleDirectories) {
+        InterpreterTest::RunAstTests(directory, "-t");
+    }
+}
+
+TEST_CASE("C backend conformance", "[Interpreter][EmitC]") {
+    for (const std::string& directory : SampleDirectories) {
+        InterpreterTest::RunCTests(directory);
+    }
+    InterpreterTest::RunExpectedCTests("RuntimeErrors/");
+}
@@ -1,6 +1,8 @@
 #include "catch.hpp"
 #include "CompilerTest.h"
 
+#include <unordered_map>
+
 TEST_CASE("Lexer Basic Syntax", "[Lexer]") {
     RunTests<LexerTest>("Basic/");
 }
@@ -15,4 +17,43 @@ TEST_CASE("Lexer String Literals", "[Lexer]") {
 
 TEST_CASE("Lexer Complex Tests", "[Lexer]") {
     RunTests<LexerTest>("Complex/");
-}
\ No newline at end of file
+}
+
+TEST_CASE("Lexer Interning", "[Lexer]") {
+    std::unordered_map<std::string, SymbolId> ids;
+    for (const char* path : { "Basic/KeywordPrefixes.kt", "Basic/LongRuns.kt", "Complex/GenericsExample.kt", "Complex/LambdasExample.kt" }) {
+        Lexer lexer(LexerTest::CreateTestPath(path));
+        lexer.NextLexeme();
+
+        while (lexer.GetLexeme().GetType() != Lexeme::LexemeType::EndOfFile) {
+            Lexeme lexeme = lexer.NextLexeme();
+            if (lexeme.GetId() == StringInterner::EMPTY_ID) {
+                continue;
+            }
+
+            auto [it, isInserted] = ids.emplace(lexeme.GetText(), lexeme.GetId());
+            CHECK(it->second == lexeme.GetId());
+            CHECK(&StringInterner::GetString(lexeme.GetId()) == &lexeme.GetText());
+        }
+    }
+
+    CHECK(ids.count("main") == 1);
+}
+
+
+TEST_CASE("Lexer Interning Scope", "[Lexer]") {
+    SymbolId kept = StringInterner::Intern("kept outside of scopes");
+    SymbolId first;
+    {
+        StringInterner::Scope scope;
+        first = StringInterner::Intern("first scoped string");
+        CHECK(StringInterner::Intern("kept outside of scopes") == kept);
+    }
+    {
+        StringInterner::Scope scope;
+        CHECK(StringInterner::Intern("second scoped string") == first);
+        CHECK(StringInterner::GetString(first) == "second scoped string");
+    }
+
+    CHECK(StringInterner::GetString(kept) == "kept outside of scopes");
+}
@@ -0,0 +1,27 @@
+fun wrap(a: Int, b: Int): Int {
+	return a * b + a - b
+}
+
+fun quotient(a: Int, b: Int): Int {
+	return a / b + a % b
+}
+
+fun main() {
+	var max = 2147483647
+	var min = -2147483647 - 1
+	var big = 65536
+	println(max + 1)
+	println(min - 1)
+	println(big * big)
+	println(-min)
+	println(min / -1)
+	println(min % -1)
+	println(wrap(max, 2))
+	println(quotient(min, -1))
+	max++
+	println(max)
+	min -= 1
+	println(min)
+	big *= big
+	println(big)
+}
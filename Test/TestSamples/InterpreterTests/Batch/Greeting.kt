@@ -0,0 +1,5 @@
+fun greet(name : String) : String = "Hello, " + name + "!"
+
+fun main() {
+    println(greet("batch"))
+}
@@ -0,0 +1,4 @@
+fun main() {
+    val numbers = arrayOf<Int>(1, 2, 3)
+    println(numbers[3])
+}
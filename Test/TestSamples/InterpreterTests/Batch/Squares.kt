@@ -0,0 +1,7 @@
+fun main() {
+    var sum = 0
+    for (i in 1..10) {
+        sum += i * i
+    }
+    println(sum)
+}
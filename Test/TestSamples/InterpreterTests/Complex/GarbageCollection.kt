@@ -0,0 +1,31 @@
+class Cell {
+    var value : Int = 0
+    var items : Array<Int> = arrayOf<Int>(0)
+}
+
+fun makeCell(value : Int) : Cell {
+    val cell = Cell()
+    cell.value = value
+    cell.items = arrayOf<Int>(value, value * 2, value * 3)
+    return cell
+}
+
+fun sum(first : Cell, second : Cell) : Int = first.value + second.items[2] + makeCell(first.value).items[1]
+
+fun main() {
+    val kept = arrayOf<Cell>(makeCell(1), makeCell(2), makeCell(3), makeCell(4))
+    var total = 0
+    for (i in 0..19999) {
+        val cell = makeCell(i)
+        val pair = arrayOf<Cell>(cell, makeCell(i + 1))
+        total = total + sum(pair[0], pair[1]) % 7
+        if (i % 5000 == 0) {
+            kept[i / 5000] = pair[1]
+        }
+    }
+    println(total)
+    for (cell in kept) {
+        println(cell.value)
+        println(cell.items[0] + cell.items[1] + cell.items[2])
+    }
+}
@@ -0,0 +1,26 @@
+val n = 4
+val zero = n - 4
+val min = -2147483647 - 1
+
+class Counter {
+	val n = 3
+	var count = n * 2
+}
+
+fun main() {
+	if (n < 0) {
+		println(n / zero)
+		println(min / -1)
+	}
+	println(1.0 / 0.0)
+	println(0.0 / 0.0)
+
+	val shadowed = n + 1
+	if (shadowed > 0) {
+		val shadowed = "inner"
+		println(shadowed + "!")
+	}
+	println(shadowed)
+
+	println(Counter().count + n)
+}
@@ -0,0 +1,14 @@
+val max = 2147483647
+val min = -2147483647 - 1
+val overflow = max + 1
+
+fun main() {
+	println(overflow)
+	println(min - 1)
+	println(65536 * 65536)
+	println(-min)
+	println(min / -1)
+	println(min % -1)
+	println(max * max + 1)
+	println(max / (min + min))
+}
@@ -0,0 +1,11 @@
+fun divide(a: Int, b: Int): Int {
+    return a / b
+}
+
+fun main() {
+    println(divide(7, 2))
+    println(7 % -2)
+    var zero = 0
+    println(divide(1, zero))
+    println(zero)
+}
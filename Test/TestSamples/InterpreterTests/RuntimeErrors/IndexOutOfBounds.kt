@@ -0,0 +1,6 @@
+fun main() {
+    val numbers = arrayOf<Int>(1, 2, 3)
+    println(numbers[2])
+    println(numbers[5])
+    println(numbers[0])
+}
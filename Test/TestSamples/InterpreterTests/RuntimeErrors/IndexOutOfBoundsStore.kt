@@ -0,0 +1,7 @@
+fun main() {
+    val names = arrayOf<String>("a", "b")
+    names[1] = "c"
+    println(names[1])
+    names[-1] = "d"
+    println(names[0])
+}
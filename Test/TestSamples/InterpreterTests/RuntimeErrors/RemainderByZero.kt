@@ -0,0 +1,11 @@
+fun remainder(a: Int, b: Int): Int {
+    var result = a
+    result %= b
+    return result
+}
+
+fun main() {
+    println(remainder(7, 3))
+    println(remainder(7, 0))
+    println(0)
+}
@@ -0,0 +1,57 @@
+val n = 4
+val title = "sum" + ":"
+val limit = 2 * n + 1
+val zero = n - 4
+val min = -2147483647 - 1
+
+class Counter {
+	val limit = 3
+	var count = limit
+
+	fun next() : Int {
+		count = count + limit
+		return count
+	}
+}
+
+fun main() {
+	val x1 = 3
+	val x2 = 10
+	var i = 2
+	println(1.0 / n * i)
+	println((x2 - x1) * (x2 - x1))
+	println(-7 / 2)
+	println(-7 % 3)
+	println(!(n > 3) || x1 == 3)
+	var s = 0
+	for (k in 1..limit) {
+		s += k
+	}
+	println(title)
+	println(s)
+
+	if (n < 0) {
+		println(x1 / 0)
+		println(x2 % zero)
+		println(min / -1)
+		println(min % -1)
+	}
+	println(min)
+	println(min + 1)
+	println(1.0 / 0.0)
+	println(-1.0 / 0.0)
+	println(0.0 / 0.0)
+
+	val shadowed = 1
+	println(shadowed)
+	if (x1 > 0) {
+		val shadowed = 2
+		println(shadowed + 1)
+	}
+	println(shadowed + 1)
+
+	val counter = Counter()
+	println(counter.limit)
+	println(counter.next())
+	println(counter.next() + limit)
+}
@@ -0,0 +1,17 @@
+fun main() {
+    val funny = 1
+    val valx = funny
+    var variable = valx
+    val iffy = variable
+    val elsewhere = iffy
+    val forward = elsewhere
+    val whileLoop = forward
+    val returned = whileLoop
+    val classes = returned
+    val isolated = classes
+    val null2 = isolated
+    val trueish = null2
+    val thisOne = trueish
+    val fun_ = thisOne
+    fun funny2() = fun_
+}
@@ -0,0 +1,6 @@
+fun main() {
+    val averyveryverylongidentifiername_with_digits_0123456789 = 1
+    val x                                    = averyveryverylongidentifiername_with_digits_0123456789
+																			println(x)                    // trailing blanks                    
+    val _________________underscores_________________ = x                 +                  1
+}
@@ -0,0 +1,8 @@
+// Комментарий с юникодом: こんにちは 🙂
+fun main() {
+    /* многострочный
+       комментарий ✓ */
+    val greeting = "Привет, мир! 🙂"
+    val raw = """naïve café ñ"""
+    println(greeting)
+}
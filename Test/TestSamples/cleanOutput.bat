@@ -1 +1,2 @@
-del /S *.last
\ No newline at end of file
+del /S *.last
+del /S *.kast
\ No newline at end of file